@@ -0,0 +1,108 @@
+#include <unordered_set>
+
+#include "ATen/core/grad_mode.h"
+#include "torch/csrc/jit/runtime/graph_executor.h"
+
+#include "core/calibration/calibration.h"
+#include "core/util/prelude.h"
+
+namespace trtorch {
+namespace core {
+namespace calibration {
+
+std::vector<std::string> ObserveActivations(std::shared_ptr<torch::jit::Graph>& g, size_t num_method_inputs) {
+  std::vector<std::string> names;
+  std::unordered_set<const torch::jit::Value*> from_inputs;
+  auto observe = [&](torch::jit::Value* v) {
+    from_inputs.insert(v);
+    if (v->type()->isSubtypeOf(c10::TensorType::get())) {
+      g->registerOutput(v);
+      names.push_back(v->debugName());
+    }
+  };
+
+  for (size_t i = 0; i < num_method_inputs; i++) {
+    observe(g->inputs()[i]);
+  }
+
+  for (auto n : g->nodes()) {
+    // Conservatively assume nodes with sub blocks use the inputs somewhere
+    // inside of them
+    bool uses_inputs = !n->blocks().empty();
+    for (auto in : n->inputs()) {
+      uses_inputs |= from_inputs.count(in) > 0;
+    }
+    if (!uses_inputs) {
+      continue;
+    }
+    for (auto out : n->outputs()) {
+      observe(out);
+    }
+  }
+  return names;
+}
+
+ActivationRanges CollectActivationRanges(
+    lowering::LoweringCache& lowering_cache,
+    std::string method_name,
+    const std::vector<lowering::passes::InputShapeRange>& input_shapes,
+    BatchSource next_batch,
+    CalibrationSettings settings) {
+  TRTORCH_TRACE_SCOPE("CollectActivationRanges", "calibration");
+  LOG_DEBUG(settings);
+
+  auto graph_and_parameters = lowering_cache.Lower(method_name, input_shapes);
+  // The lowered graph is cached for conversion, so the observed version is a
+  // copy (which keeps the value names)
+  auto g = graph_and_parameters.first->copy();
+  auto& params = graph_and_parameters.second;
+  // Inputs to the lowered graph are the method arguments followed by the
+  // extracted parameters
+  auto num_method_inputs = g->inputs().size() - params.size();
+  auto names = ObserveActivations(g, num_method_inputs);
+  LOG_GRAPH("Graph observed for calibration: " << *g);
+  LOG_INFO("Collecting the ranges of " << names.size() << " activations of " << method_name);
+
+  std::vector<TensorHistogram> histograms(names.size(), TensorHistogram(settings.num_bins));
+  torch::jit::GraphExecutor executor(g, method_name);
+  at::NoGradGuard no_grad;
+
+  uint64_t num_batches = 0;
+  std::vector<at::Tensor> batch;
+  while (next_batch(batch)) {
+    TRTORCH_TRACE_SCOPE("CalibrationBatch", "calibration");
+    TRTORCH_CHECK(
+        batch.size() == num_method_inputs,
+        "Expected calibration batches with " << num_method_inputs << " tensors (one for each input of " << method_name
+                                             << ") but found " << batch.size());
+    torch::jit::Stack stack(batch.begin(), batch.end());
+    stack.insert(stack.end(), params.begin(), params.end());
+    executor.run(stack);
+
+    // Observed values come after the outputs of the method
+    auto first = stack.size() - names.size();
+    for (size_t i = 0; i < names.size(); i++) {
+      histograms[i].Collect(stack[first + i].toTensor());
+    }
+    num_batches++;
+  }
+  TRTORCH_CHECK(num_batches > 0, "No batches provided to collect activation ranges of " << method_name << " from");
+
+  ActivationRanges ranges;
+  for (size_t i = 0; i < names.size(); i++) {
+    auto range = histograms[i].Range(settings);
+    // Tensors that are never anything but 0 (or are not floating point) have
+    // no usable range and are left to TensorRT
+    if (range > 0) {
+      ranges[names[i]] = range;
+    } else {
+      LOG_DEBUG("No range found for " << names[i]);
+    }
+  }
+  LOG_INFO("Collected " << ranges.size() << " activation ranges from " << num_batches << " batches");
+  return ranges;
+}
+
+} // namespace calibration
+} // namespace core
+} // namespace trtorch
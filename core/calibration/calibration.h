@@ -0,0 +1,115 @@
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ATen/ATen.h"
+#include "core/lowering/lowering.h"
+
+namespace nvinfer1 {
+class IInt8Calibrator;
+} // namespace nvinfer1
+
+namespace trtorch {
+namespace core {
+namespace calibration {
+
+// How the dynamic range of an activation is picked from its histogram
+enum class RangeMethod {
+  // Largest absolute value seen
+  kMAX,
+  // Smallest range covering a percentage of the values seen
+  kPERCENTILE,
+  // Range minimizing the mean squared error of the quantized values
+  kMSE,
+  // Range minimizing the KL divergence between the distribution of the values
+  // and their quantized distribution (what IInt8EntropyCalibrator2 does)
+  kENTROPY,
+};
+
+struct CalibrationSettings {
+  RangeMethod method = RangeMethod::kENTROPY;
+  // Percentage of the values covered by the range with RangeMethod::kPERCENTILE
+  double percentile = 99.99;
+  // Resolution of the histogram kept for each activation
+  int64_t num_bins = 2048;
+
+  CalibrationSettings() = default;
+  friend std::ostream& operator<<(std::ostream& os, const CalibrationSettings& s);
+};
+
+// Symmetric dynamic range ([-range, range]) of each activation, by the debug
+// name of its value in the lowered graph
+using ActivationRanges = std::map<std::string, float>;
+
+// Fills in the tensors for each input of the method, returns false once there
+// are no batches left
+using BatchSource = std::function<bool(std::vector<at::Tensor>&)>;
+
+// Histogram of the absolute values of an activation across batches. Counting
+// is done with at::histc on the device the activation is on, bins are merged
+// when a batch goes beyond the current maximum so only one pass over the data
+// is needed
+class TensorHistogram {
+ public:
+  TensorHistogram(int64_t num_bins);
+  void Collect(const at::Tensor& t);
+  float Range(const CalibrationSettings& settings) const;
+
+ private:
+  int64_t num_bins_;
+  // Upper edge of the last bin, the largest absolute value seen so far
+  double max_ = 0;
+  at::Tensor counts_;
+};
+
+// Picks a range from a histogram of absolute values whose bins are bin_width
+// wide starting at 0, returns 0 for an empty histogram
+float ComputeRange(const std::vector<double>& counts, double bin_width, const CalibrationSettings& settings);
+
+// Registers every tensor computed from the inputs of the method as an extra
+// output of the graph, returning their names in the order they were added.
+// Values computed only from weights are left out since they are evaluated
+// during conversion rather than becoming TensorRT tensors, as are values
+// inside of sub blocks which cannot be outputs of the graph. Observed values
+// stay alive until a run completes, so a batch needs memory for all of the
+// activations at once
+std::vector<std::string> ObserveActivations(std::shared_ptr<torch::jit::Graph>& g, size_t num_method_inputs);
+
+// Runs the lowered graph of a method (lowered exactly as it is for
+// conversion, so value names match) over the batches from next_batch and
+// collects the range of every floating point activation. The graph runs on
+// whichever device the module and the batches are on
+ActivationRanges CollectActivationRanges(
+    lowering::LoweringCache& lowering_cache,
+    std::string method_name,
+    const std::vector<lowering::passes::InputShapeRange>& input_shapes,
+    BatchSource next_batch,
+    CalibrationSettings settings);
+
+// Shapes TensorRT calibrates each input binding with (the optimal shapes of
+// the calibration profile), by binding name
+using BindingDims = std::map<std::string, std::vector<int64_t>>;
+
+// TensorRT does not tell an IInt8Calibrator the shapes of the bindings it
+// fills nor lets exceptions out of IInt8Calibrator::getBatch, so while an
+// engine builds its calibrator can look up the binding shapes here and record
+// errors which are rethrown once the build returns
+void RegisterCalibrationBindings(const nvinfer1::IInt8Calibrator* calibrator, BindingDims dims);
+// Returns false if the calibrator is not calibrating an engine being built
+bool GetCalibrationBindings(const nvinfer1::IInt8Calibrator* calibrator, BindingDims& dims);
+void RecordCalibrationError(const nvinfer1::IInt8Calibrator* calibrator, std::exception_ptr error);
+// Drops the registration, rethrowing the first error recorded for it
+void ReleaseCalibrationBindings(const nvinfer1::IInt8Calibrator* calibrator);
+
+// Calibration files are plain text, a header line followed by one
+// "<value name> <range>" line per activation
+void WriteCalibrationFile(const std::string& path, const ActivationRanges& ranges);
+ActivationRanges ReadCalibrationFile(const std::string& path);
+
+} // namespace calibration
+} // namespace core
+} // namespace trtorch
@@ -0,0 +1,81 @@
+#include <mutex>
+#include <unordered_map>
+
+#include "core/calibration/calibration.h"
+#include "core/util/prelude.h"
+
+namespace trtorch {
+namespace core {
+namespace calibration {
+
+namespace {
+struct CalibrationBindings {
+  BindingDims dims;
+  std::exception_ptr error;
+};
+
+std::mutex& bindings_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<const nvinfer1::IInt8Calibrator*, CalibrationBindings>& bindings_registry() {
+  static std::unordered_map<const nvinfer1::IInt8Calibrator*, CalibrationBindings> registry;
+  return registry;
+}
+} // namespace
+
+void RegisterCalibrationBindings(const nvinfer1::IInt8Calibrator* calibrator, BindingDims dims) {
+  std::lock_guard<std::mutex> lock(bindings_mutex());
+  bindings_registry()[calibrator] = {std::move(dims), nullptr};
+}
+
+bool GetCalibrationBindings(const nvinfer1::IInt8Calibrator* calibrator, BindingDims& dims) {
+  std::lock_guard<std::mutex> lock(bindings_mutex());
+  auto it = bindings_registry().find(calibrator);
+  if (it == bindings_registry().end()) {
+    return false;
+  }
+  dims = it->second.dims;
+  return true;
+}
+
+void RecordCalibrationError(const nvinfer1::IInt8Calibrator* calibrator, std::exception_ptr error) {
+  std::lock_guard<std::mutex> lock(bindings_mutex());
+  auto it = bindings_registry().find(calibrator);
+  if (it == bindings_registry().end()) {
+    // Not calibrating an engine built by TRTorch so there is no one to rethrow
+    // the error to
+    try {
+      std::rethrow_exception(error);
+    } catch (std::exception& e) {
+      LOG_ERROR("Calibration failed: " << e.what());
+    } catch (...) {
+      LOG_ERROR("Calibration failed");
+    }
+    return;
+  }
+  if (!it->second.error) {
+    it->second.error = error;
+  }
+}
+
+void ReleaseCalibrationBindings(const nvinfer1::IInt8Calibrator* calibrator) {
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(bindings_mutex());
+    auto it = bindings_registry().find(calibrator);
+    if (it == bindings_registry().end()) {
+      return;
+    }
+    error = it->second.error;
+    bindings_registry().erase(it);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace calibration
+} // namespace core
+} // namespace trtorch
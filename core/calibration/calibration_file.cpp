@@ -0,0 +1,60 @@
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "core/calibration/calibration.h"
+#include "core/util/prelude.h"
+
+namespace trtorch {
+namespace core {
+namespace calibration {
+
+namespace {
+const std::string kCalibrationFileHeader = "TRTorch-ActivationRanges-1";
+} // namespace
+
+void WriteCalibrationFile(const std::string& path, const ActivationRanges& ranges) {
+  std::ofstream file(path);
+  TRTORCH_CHECK(file.good(), "Unable to open calibration file " << path << " for writing");
+  file << kCalibrationFileHeader << '\n';
+  file << std::setprecision(std::numeric_limits<float>::max_digits10);
+  for (auto& r : ranges) {
+    file << r.first << ' ' << r.second << '\n';
+  }
+  TRTORCH_CHECK(file.good(), "Failed to write calibration file " << path);
+  LOG_INFO("Saved " << ranges.size() << " activation ranges to " << path);
+}
+
+ActivationRanges ReadCalibrationFile(const std::string& path) {
+  std::ifstream file(path);
+  TRTORCH_CHECK(file.good(), "Unable to open calibration file " << path);
+
+  std::string line;
+  std::getline(file, line);
+  TRTORCH_CHECK(
+      line == kCalibrationFileHeader,
+      path << " is not a TRTorch calibration file (expected a " << kCalibrationFileHeader << " header)");
+
+  ActivationRanges ranges;
+  size_t line_num = 1;
+  while (std::getline(file, line)) {
+    line_num++;
+    if (line.empty()) {
+      continue;
+    }
+    std::istringstream entry(line);
+    std::string name;
+    float range;
+    TRTORCH_CHECK(
+        entry >> name >> range && range > 0,
+        "Malformed activation range on line " << line_num << " of " << path << ": " << line);
+    ranges[name] = range;
+  }
+  LOG_DEBUG("Read " << ranges.size() << " activation ranges from " << path);
+  return ranges;
+}
+
+} // namespace calibration
+} // namespace core
+} // namespace trtorch
@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/calibration/calibration.h"
+#include "core/util/prelude.h"
+
+namespace trtorch {
+namespace core {
+namespace calibration {
+
+namespace {
+// Number of positive levels of a symmetric INT8 quantization
+constexpr int64_t kNumQuantizedLevels = 127;
+// Bins the candidate distributions are quantized to for the KL divergence
+constexpr int64_t kNumEntropyBins = 128;
+
+float MaxRange(const std::vector<double>& counts, double bin_width) {
+  for (size_t i = counts.size(); i > 0; i--) {
+    if (counts[i - 1] > 0) {
+      return static_cast<float>(i * bin_width);
+    }
+  }
+  return 0;
+}
+
+float PercentileRange(const std::vector<double>& counts, double bin_width, double percentile) {
+  double total = 0;
+  for (auto c : counts) {
+    total += c;
+  }
+  double target = total * std::min(std::max(percentile, 0.0), 100.0) / 100.0;
+  double seen = 0;
+  for (size_t i = 0; i < counts.size(); i++) {
+    seen += counts[i];
+    if (seen >= target && seen > 0) {
+      return static_cast<float>((i + 1) * bin_width);
+    }
+  }
+  return MaxRange(counts, bin_width);
+}
+
+/// Every value below the range has a rounding error uniform over a
+/// quantization step (step^2 / 12 squared error), every value above it is
+/// clipped to the range. Sums over the clipped bins are kept as suffix sums of
+/// the counts, so each candidate range is evaluated in constant time
+float MSERange(const std::vector<double>& counts, double bin_width) {
+  auto n = counts.size();
+  // Suffix sums of count, count * center and count * center^2 of bins i and up
+  std::vector<double> s0(n + 1, 0), s1(n + 1, 0), s2(n + 1, 0);
+  for (size_t i = n; i > 0; i--) {
+    double center = (i - 0.5) * bin_width;
+    s0[i - 1] = s0[i] + counts[i - 1];
+    s1[i - 1] = s1[i] + counts[i - 1] * center;
+    s2[i - 1] = s2[i] + counts[i - 1] * center * center;
+  }
+  if (s0[0] == 0) {
+    return 0;
+  }
+
+  size_t best = n;
+  double best_error = std::numeric_limits<double>::max();
+  for (size_t i = 1; i <= n; i++) {
+    double range = i * bin_width;
+    double step = range / kNumQuantizedLevels;
+    double rounding = (s0[0] - s0[i]) * step * step / 12.0;
+    double clipping = s2[i] - 2 * range * s1[i] + range * range * s0[i];
+    if (rounding + clipping < best_error) {
+      best_error = rounding + clipping;
+      best = i;
+    }
+  }
+  return static_cast<float>(best * bin_width);
+}
+
+/// Follows the entropy calibration of TensorRT: for each candidate range the
+/// bins beyond it are folded into the last bin (the reference distribution P),
+/// the bins up to it are merged down to 128 levels and spread back over the
+/// non empty bins (the quantized distribution Q), and the range with the
+/// smallest KL(P || Q) wins
+float EntropyRange(const std::vector<double>& counts, double bin_width) {
+  auto n = static_cast<int64_t>(counts.size());
+  if (n <= kNumEntropyBins) {
+    return MaxRange(counts, bin_width);
+  }
+
+  double total = 0;
+  for (auto c : counts) {
+    total += c;
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  int64_t best = n;
+  double best_divergence = std::numeric_limits<double>::max();
+  std::vector<double> p, q;
+  double outliers = total;
+  for (int64_t i = 0; i < kNumEntropyBins; i++) {
+    outliers -= counts[i];
+  }
+  for (int64_t i = kNumEntropyBins; i <= n; i++) {
+    p.assign(counts.begin(), counts.begin() + i);
+    p[i - 1] += outliers;
+    if (i < n) {
+      outliers -= counts[i];
+    }
+
+    q.assign(i, 0);
+    double bins_per_level = static_cast<double>(i) / kNumEntropyBins;
+    for (int64_t level = 0; level < kNumEntropyBins; level++) {
+      auto start = static_cast<int64_t>(level * bins_per_level);
+      auto end = level == kNumEntropyBins - 1 ? i : static_cast<int64_t>((level + 1) * bins_per_level);
+      double sum = 0;
+      int64_t non_empty = 0;
+      for (int64_t j = start; j < end; j++) {
+        sum += counts[j];
+        non_empty += counts[j] > 0;
+      }
+      for (int64_t j = start; j < end; j++) {
+        if (counts[j] > 0) {
+          q[j] = sum / non_empty;
+        }
+      }
+    }
+
+    double p_total = 0, q_total = 0;
+    for (int64_t j = 0; j < i; j++) {
+      p_total += p[j];
+      q_total += q[j];
+    }
+    if (q_total == 0) {
+      continue;
+    }
+    double divergence = 0;
+    for (int64_t j = 0; j < i; j++) {
+      if (p[j] == 0) {
+        continue;
+      }
+      double pj = p[j] / p_total;
+      // The last bin holds the outliers even if the bin itself was empty,
+      // leaving it unrepresented in Q is heavily penalized instead of skipped
+      double qj = q[j] > 0 ? q[j] / q_total : 1e-12;
+      divergence += pj * std::log(pj / qj);
+    }
+    if (divergence < best_divergence) {
+      best_divergence = divergence;
+      best = i;
+    }
+  }
+  return static_cast<float>(best * bin_width);
+}
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const CalibrationSettings& s) {
+  os << "Activation range calibration settings:\n    Range Method: ";
+  switch (s.method) {
+    case RangeMethod::kMAX:
+      os << "max";
+      break;
+    case RangeMethod::kPERCENTILE:
+      os << "percentile (" << s.percentile << "%)";
+      break;
+    case RangeMethod::kMSE:
+      os << "mse";
+      break;
+    case RangeMethod::kENTROPY:
+    default:
+      os << "entropy";
+      break;
+  }
+  os << "\n    Histogram Bins: " << s.num_bins;
+  return os;
+}
+
+float ComputeRange(const std::vector<double>& counts, double bin_width, const CalibrationSettings& settings) {
+  switch (settings.method) {
+    case RangeMethod::kMAX:
+      return MaxRange(counts, bin_width);
+    case RangeMethod::kPERCENTILE:
+      return PercentileRange(counts, bin_width, settings.percentile);
+    case RangeMethod::kMSE:
+      return MSERange(counts, bin_width);
+    case RangeMethod::kENTROPY:
+    default:
+      return EntropyRange(counts, bin_width);
+  }
+}
+
+TensorHistogram::TensorHistogram(int64_t num_bins) : num_bins_(num_bins) {
+  TRTORCH_CHECK(num_bins > 0, "Histograms need at least one bin, got " << num_bins);
+}
+
+void TensorHistogram::Collect(const at::Tensor& t) {
+  if (!t.defined() || t.numel() == 0 || !t.is_floating_point()) {
+    return;
+  }
+
+  auto values = t.detach().abs().to(at::kFloat);
+  auto max = values.max().item<double>();
+  if (!std::isfinite(max)) {
+    values = values.masked_select(at::isfinite(values));
+    if (values.numel() == 0) {
+      return;
+    }
+    max = values.max().item<double>();
+  }
+
+  if (!counts_.defined()) {
+    counts_ = at::zeros({num_bins_}, values.options().dtype(at::kDouble));
+  } else if (counts_.device() != values.device()) {
+    counts_ = counts_.to(values.device());
+  }
+
+  if (max > max_) {
+    if (max_ > 0) {
+      // Each old bin is moved whole into the new bin holding its center
+      auto old_width = max_ / num_bins_;
+      auto new_width = max / num_bins_;
+      auto centers = (at::arange(num_bins_, counts_.options()) + 0.5) * old_width;
+      auto index = (centers / new_width).floor().clamp_max(num_bins_ - 1).to(at::kLong);
+      counts_ = at::zeros_like(counts_).index_add_(0, index, counts_);
+    }
+    max_ = max;
+  }
+
+  if (max_ == 0) {
+    // Nothing but zeros so far, at::histc would pick its own bounds for an
+    // empty range
+    counts_[0] += values.numel();
+  } else {
+    counts_ += at::histc(values, num_bins_, 0, max_).to(at::kDouble);
+  }
+}
+
+float TensorHistogram::Range(const CalibrationSettings& settings) const {
+  if (!counts_.defined() || max_ == 0) {
+    return 0;
+  }
+  auto counts = counts_.to(at::kCPU).contiguous();
+  auto data = counts.data_ptr<double>();
+  std::vector<double> host(data, data + counts.numel());
+  return ComputeRange(host, max_ / num_bins_, settings);
+}
+
+} // namespace calibration
+} // namespace core
+} // namespace trtorch
@@ -127,8 +127,13 @@ void AddEngineToGraph(
 }
 
 bool CheckMethodOperatorSupport(const torch::jit::script::Module& mod, std::string method_name) {
+  lowering::LoweringCache lowering_cache(mod);
+  return CheckMethodOperatorSupport(lowering_cache, method_name);
+}
+
+bool CheckMethodOperatorSupport(lowering::LoweringCache& lowering_cache, std::string method_name) {
   // Go through Lowering to simplify graph and extract weight parameters
-  auto graph_and_parameters = lowering::Lower(mod, method_name);
+  auto graph_and_parameters = lowering_cache.Lower(method_name);
 
   auto g = graph_and_parameters.first;
   LOG_DEBUG(*g << "(CheckMethodOperatorSupport)\n");
@@ -137,13 +142,30 @@ bool CheckMethodOperatorSupport(const torch::jit::script::Module& mod, std::stri
 }
 
 std::string ConvertGraphToTRTEngine(const torch::jit::script::Module& mod, std::string method_name, CompileSpec cfg) {
+  lowering::LoweringCache lowering_cache(mod);
+  return ConvertGraphToTRTEngine(lowering_cache, method_name, std::move(cfg));
+}
+
+std::vector<lowering::passes::InputShapeRange> GetInputShapes(CompileSpec& cfg) {
+  std::vector<lowering::passes::InputShapeRange> input_shapes;
+  for (auto& range : cfg.convert_info.input_ranges) {
+    input_shapes.push_back({util::toVec(range.min), util::toVec(range.max)});
+  }
+  return input_shapes;
+}
+
+std::string ConvertGraphToTRTEngine(lowering::LoweringCache& lowering_cache, std::string method_name, CompileSpec cfg) {
+  TRTORCH_TRACE_SCOPE("ConvertGraphToTRTEngine", "compile");
+  // Specialize the graph on the input shapes the engine will be built for
+  auto input_shapes = GetInputShapes(cfg);
+
   // Go through Lowering to simplify graph and extract weight parameters
-  auto graph_and_parameters = lowering::Lower(mod, method_name);
+  auto graph_and_parameters = lowering_cache.Lower(method_name, input_shapes);
 
   auto convert_cfg = std::move(cfg.convert_info);
   auto g = graph_and_parameters.first;
-  auto params = graph_and_parameters.second;
-  auto named_params = conversion::get_named_params(g->inputs(), params);
+  auto params = std::move(graph_and_parameters.second);
+  auto named_params = conversion::get_named_params(g->inputs(), std::move(params));
 
   LOG_INFO(*g << "(CompileGraph)\n");
 
@@ -152,15 +174,20 @@ std::string ConvertGraphToTRTEngine(const torch::jit::script::Module& mod, std::
 }
 
 torch::jit::script::Module CompileGraph(const torch::jit::script::Module& mod, CompileSpec cfg) {
+  TRTORCH_TRACE_SCOPE("CompileGraph", "compile");
   // TODO: Should be doing a functional transform but need PR #31978
   // [jit] More robust mangling
   // torch::jit::script::Module new_mod = mod.clone();
   torch::jit::script::Module new_mod(mod._ivalue()->name() + "_trt");
   std::vector<std::shared_ptr<torch::jit::Graph>> graphs;
+  // Freeze the module once for all methods
+  lowering::LoweringCache lowering_cache(mod);
   for (const torch::jit::script::Method& method : mod.get_methods()) {
     // Don't convert hidden methods
     if (method.name().rfind("_", 0)) {
-      auto engine = ConvertGraphToTRTEngine(mod, method.name(), cfg);
+      auto engine = ConvertGraphToTRTEngine(lowering_cache, method.name(), cfg);
+      // Each method is converted once, free its weights before building the next one
+      lowering_cache.Release(method.name());
       auto new_g = std::make_shared<torch::jit::Graph>();
       AddEngineToGraph(new_mod, new_g, engine);
       auto new_method = new_mod._ivalue()->compilation_unit()->create_function(method.name(), new_g);
@@ -173,6 +200,33 @@ torch::jit::script::Module CompileGraph(const torch::jit::script::Module& mod, C
   return new_mod;
 }
 
+calibration::ActivationRanges CollectActivationRanges(
+    const torch::jit::script::Module& mod,
+    std::string method_name,
+    CompileSpec cfg,
+    calibration::BatchSource next_batch,
+    calibration::CalibrationSettings settings) {
+  // Value names in the calibration file have to match the graph that will be
+  // converted, so lowering is done exactly as in ConvertGraphToTRTEngine
+  lowering::LoweringCache lowering_cache(mod);
+  return calibration::CollectActivationRanges(
+      lowering_cache, method_name, GetInputShapes(cfg), std::move(next_batch), std::move(settings));
+}
+
+precision_search::SearchResult SearchLayerPrecisions(
+    const torch::jit::script::Module& mod,
+    std::string method_name,
+    CompileSpec cfg,
+    const std::vector<std::vector<at::Tensor>>& validation_batches,
+    precision_search::SearchSettings settings) {
+  // Rules select layers by the value names of the graph that will be
+  // converted, so lowering is done exactly as in ConvertGraphToTRTEngine
+  lowering::LoweringCache lowering_cache(mod);
+  auto input_shapes = GetInputShapes(cfg);
+  return precision_search::SearchLayerPrecisions(
+      lowering_cache, method_name, input_shapes, std::move(cfg.convert_info), validation_batches, std::move(settings));
+}
+
 void set_device(const int gpu_id) {
   TRTORCH_ASSERT(cudaSetDevice(gpu_id) == cudaSuccess, "Unable to set CUDA device: " << gpu_id);
 }
@@ -2,7 +2,10 @@
 
 #include <cuda_runtime.h>
 #include <vector>
+#include "core/calibration/calibration.h"
 #include "core/conversion/conversion.h"
+#include "core/lowering/lowering.h"
+#include "core/precision_search/precision_search.h"
 #include "torch/csrc/jit/api/module.h"
 
 namespace trtorch {
@@ -15,10 +18,33 @@ struct CompileSpec {
 
 bool CheckMethodOperatorSupport(const torch::jit::script::Module& mod, std::string method_name);
 
+bool CheckMethodOperatorSupport(lowering::LoweringCache& lowering_cache, std::string method_name);
+
 std::string ConvertGraphToTRTEngine(const torch::jit::script::Module& mod, std::string method_name, CompileSpec cfg);
 
+std::string ConvertGraphToTRTEngine(lowering::LoweringCache& lowering_cache, std::string method_name, CompileSpec cfg);
+
 torch::jit::script::Module CompileGraph(const torch::jit::script::Module& module, CompileSpec cfg);
 
+// Collects activation ranges from the graph lowered for the input ranges of
+// cfg, the same graph ConvertGraphToTRTEngine converts
+calibration::ActivationRanges CollectActivationRanges(
+    const torch::jit::script::Module& mod,
+    std::string method_name,
+    CompileSpec cfg,
+    calibration::BatchSource next_batch,
+    calibration::CalibrationSettings settings);
+
+// Searches for the layers of a method to promote to a higher precision than
+// the operating precision of cfg for its outputs to stay within the threshold
+// of TorchScript on the validation batches
+precision_search::SearchResult SearchLayerPrecisions(
+    const torch::jit::script::Module& mod,
+    std::string method_name,
+    CompileSpec cfg,
+    const std::vector<std::vector<at::Tensor>>& validation_batches,
+    precision_search::SearchSettings settings);
+
 void set_device(const int gpu_id);
 
 } // namespace core
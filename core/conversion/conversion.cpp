@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <limits>
 #include <sstream>
+#include <unordered_map>
 
 #include "core/conversion/conversion.h"
 #include "core/conversion/conversionctx/ConversionCtx.h"
@@ -18,6 +21,72 @@ bool OpSupported(const torch::jit::Node* n) {
   return evaluators::shouldEvalAtConversionTime(n) || converters::node_is_convertable(n);
 }
 
+enum class NodeHandling {
+  kLoop,
+  kConditional,
+  kEvaluate,
+  kConvert,
+  kIgnore,
+  kUnsupported,
+};
+
+struct NodeClassification {
+  NodeHandling handling;
+  evaluators::NodeEvaluator evaluator;
+  // Resolved for ignored nodes as well so support checks match OpSupported
+  converters::OpConverter converter;
+};
+
+struct NodeClassifier {
+  const NodeClassification& Classify(const torch::jit::Node* n) {
+    auto iter = classifications.find(n);
+    if (iter != classifications.end()) {
+      return iter->second;
+    }
+
+    NodeClassification c;
+    if (n->kind() == torch::jit::prim::Loop) {
+      c.handling = NodeHandling::kLoop;
+    } else if (n->kind() == torch::jit::prim::If) {
+      c.handling = NodeHandling::kConditional;
+    } else if ((c.evaluator = evaluators::find_node_evaluator_for(n))) {
+      c.handling = NodeHandling::kEvaluate;
+    } else {
+      c.converter = converters::find_node_converter_for(n);
+      if (isNodeConversionIgnored(n)) {
+        c.handling = NodeHandling::kIgnore;
+      } else if (c.converter) {
+        c.handling = NodeHandling::kConvert;
+      } else {
+        c.handling = NodeHandling::kUnsupported;
+      }
+    }
+    return classifications.emplace(n, std::move(c)).first->second;
+  }
+
+  void ClassifyBlock(const torch::jit::Block* b) {
+    for (const auto n : b->nodes()) {
+      Classify(n);
+      for (const auto sub_b : n->blocks()) {
+        ClassifyBlock(sub_b);
+      }
+    }
+  }
+
+  std::unordered_map<const torch::jit::Node*, NodeClassification> classifications;
+};
+
+const NodeClassification& ClassifyNode(ConversionCtx* ctx, const torch::jit::Node* n) {
+  if (!ctx->node_classifier) {
+    ctx->node_classifier = std::make_shared<NodeClassifier>();
+  }
+  return ctx->node_classifier->Classify(n);
+}
+
+bool IsEvaluatedNode(ConversionCtx* ctx, const torch::jit::Node* n) {
+  return ClassifyNode(ctx, n).handling == NodeHandling::kEvaluate;
+}
+
 c10::optional<torch::jit::IValue> EvaluateNode(
     ConversionCtx* ctx,
     const torch::jit::Node* n,
@@ -41,13 +110,12 @@ c10::optional<torch::jit::IValue> EvaluateNode(
       eval_args[eval_in] = &(ctx->evaluated_value_map[eval_in]);
     } else if (ctx->value_tensor_map.find(eval_in) != ctx->value_tensor_map.end()) {
       eval_args[eval_in] = ctx->value_tensor_map[eval_in];
-    } else if (evaluators::shouldEvalAtConversionTime(eval_in->node())) {
+    } else if (IsEvaluatedNode(ctx, eval_in->node())) {
       auto result = EvaluateNode(ctx, eval_in->node(), level++, limit);
       if (result) {
         // WARN: If the converter returns None then should pass through
         // but if repeated dep this section will get called each time
-        ctx->evaluated_value_map[eval_in] = std::move(result.value());
-        eval_args[eval_in] = &(ctx->evaluated_value_map[eval_in]);
+        eval_args[eval_in] = ctx->AssociateValueAndIValue(eval_in, std::move(result.value()));
       }
     } else {
       TRTORCH_THROW_ERROR(
@@ -56,11 +124,16 @@ c10::optional<torch::jit::IValue> EvaluateNode(
       return {};
     }
   }
-  auto eval = evaluators::EvalNode(n, eval_args);
+  auto& classification = ClassifyNode(ctx, n);
+  TRTORCH_CHECK(
+      classification.evaluator,
+      "Requested evaluator for " << n->kind().toQualString() << ", but no such evaluator was found");
+  auto eval = classification.evaluator(n, eval_args);
   return eval;
 }
 
 void AddLayer(ConversionCtx* ctx, const torch::jit::Node* n) {
+  TRTORCH_TRACE_SCOPE(n->kind().toQualString(), "conversion");
   LOG_INFO(ctx->logger, "Adding Layer " << util::node_info(n) << " (ctx.AddLayer)");
   converters::args node_args;
   for (auto input : n->inputs()) {
@@ -73,7 +146,7 @@ void AddLayer(ConversionCtx* ctx, const torch::jit::Node* n) {
       // Node input is a value that has already been evaluated
       LOG_DEBUG(ctx->logger, "Node input is a result of a previously evaluated value");
       node_args.push_back(&(ctx->evaluated_value_map[input]));
-    } else if (evaluators::shouldEvalAtConversionTime(input_node)) {
+    } else if (IsEvaluatedNode(ctx, input_node)) {
       // Node input is a node that needs to be evaluated before
       // the node can be converted
       LOG_DEBUG(ctx->logger, "Node input is a value that needs to be evaluated");
@@ -102,21 +175,28 @@ void AddLayer(ConversionCtx* ctx, const torch::jit::Node* n) {
     TRTORCH_THROW_ERROR("Unable to retrieve all node inputs for node: " << *n);
   }
 
-  auto schema = n->maybeSchema();
-  TRTORCH_CHECK(schema, "Unable to get schema for Node " << util::node_info(n) << " (conversion.AddLayer)");
-
-  auto converter = converters::get_node_converter_for(schema);
-  TRTORCH_CHECK(
-      converter,
-      "Unable to convert node: "
-          << util::node_info(n) << " (conversion.AddLayer)\nSchema: " << *schema << "\nConverter for " << schema->name()
-          << " requested, but no such converter was found.\nIf you need a converter for this operator, you can try implementing one yourself\n"
-          << "or request a converter: https://www.github.com/NVIDIA/TRTorch/issues");
+  auto& converter = ClassifyNode(ctx, n).converter;
+  if (!converter) {
+    auto schema = n->maybeSchema();
+    TRTORCH_CHECK(schema, "Unable to get schema for Node " << util::node_info(n) << " (conversion.AddLayer)");
+    TRTORCH_THROW_ERROR(
+        "Unable to convert node: "
+        << util::node_info(n) << " (conversion.AddLayer)\nSchema: " << *schema << "\nConverter for " << schema->name()
+        << " requested, but no such converter was found.\nIf you need a converter for this operator, you can try implementing one yourself\n"
+        << "or request a converter: https://www.github.com/NVIDIA/TRTorch/issues");
+  }
 
+  // Layers added by the converter are the ones after the current last layer
+  auto first_layer = ctx->net->getNbLayers();
   TRTORCH_CHECK(
       converter(ctx, n, node_args),
-      "Converter for " << *schema << " failed to convert node: " << util::node_info(n)
+      "Converter for " << *n->maybeSchema() << " failed to convert node: " << util::node_info(n)
                        << "please report this error to https://www.github.com/NVIDIA/TRTorch/issues");
+
+  auto precision = ctx->LayerPrecision(n);
+  if (precision) {
+    ctx->PinLayerPrecision(n, first_layer, *precision);
+  }
 }
 
 void AddInputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> inputs, std::vector<InputRange>& input_dims) {
@@ -139,7 +219,9 @@ void AddInputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> inputs
           << ", but found " << input_tensors.size() << " input tensors and " << input_dims.size()
           << " dimension specs (conversion.AddInputs)");
 
-  auto profile = ctx->builder->createOptimizationProfile();
+  // Contexts converting into a caller provided network have no builder to
+  // create an optimization profile with
+  auto profile = ctx->builder ? ctx->builder->createOptimizationProfile() : nullptr;
 
   for (size_t i = 0; i < input_tensors.size(); i++) {
     auto in = input_tensors[i];
@@ -148,21 +230,35 @@ void AddInputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> inputs
     LOG_INFO(
         ctx->logger, "Adding Input " << in->debugName() << " named " << name << " in engine (conversion.AddInputs)");
     LOG_DEBUG(ctx->logger, "Input shape set to " << dims.input_shape);
-    auto trt_in = ctx->net->addInput(name.c_str(), ctx->input_type, dims.input_shape);
+    // Integer inputs are narrowed to int32 during lowering since TensorRT has
+    // no int64, everything else uses the input type of the operating precision
+    auto input_type = ctx->input_type;
+    auto in_scalar_type = in->type()->expect<c10::TensorType>()->scalarType();
+    if (in_scalar_type && *in_scalar_type == at::kInt) {
+      input_type = nvinfer1::DataType::kINT32;
+    }
+    auto trt_in = ctx->net->addInput(name.c_str(), input_type, dims.input_shape);
     TRTORCH_CHECK(trt_in, "Failed to add input node: " << in->debugName() << " (conversion.AddInputs)");
 
-    profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMIN, dims.min);
-    profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kOPT, dims.opt);
-    profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMAX, dims.max);
+    if (profile) {
+      profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMIN, dims.min);
+      profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kOPT, dims.opt);
+      profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMAX, dims.max);
+    }
 
     if (dims.input_is_dynamic) {
       ctx->input_is_dynamic = true;
     }
 
     ctx->value_tensor_map[in] = trt_in;
+    ctx->ApplyActivationRange(in, trt_in);
     ctx->num_inputs += 1;
   }
 
+  if (!profile) {
+    return;
+  }
+
   TRTORCH_CHECK(
       profile->isValid(),
       "Optimization profile is invalid, please check the input range provided (conversion.AddInputs)");
@@ -178,6 +274,12 @@ void AddInputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> inputs
 void MarkOutputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> outputs) {
   for (auto out : outputs) {
     std::string name = std::string("output_") + std::to_string(ctx->num_outputs);
+    if (util::isInt64OutputCast(out->node())) {
+      // Narrowed outputs are returned as int32, the suffix tells the runtime to
+      // cast them back to int64
+      out = out->node()->input(0);
+      name += util::kInt64OutputSuffix;
+    }
     auto it = ctx->value_tensor_map.find(out);
     // Leaves the potential for unused outputs to be populated with nullptr
     // "safely"
@@ -192,13 +294,48 @@ void MarkOutputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> outp
   }
 }
 
+void MarkActivations(ConversionCtx* ctx, const torch::jit::Block* b) {
+  for (const auto n : b->nodes()) {
+    if (ClassifyNode(ctx, n).handling != NodeHandling::kConvert) {
+      continue;
+    }
+    for (auto out : n->outputs()) {
+      auto it = ctx->value_tensor_map.find(out);
+      if (it == ctx->value_tensor_map.end() || !it->second) {
+        continue;
+      }
+      auto tensor = it->second;
+      // Tensors can only be bound once, values aliasing an input, an output or
+      // an already marked activation are skipped
+      if (tensor->isNetworkInput() || tensor->isNetworkOutput()) {
+        continue;
+      }
+      // Only floating point activations are compared, integer tensors (shapes,
+      // indices) are exact either way
+      auto type = tensor->getType();
+      if (type != nvinfer1::DataType::kFLOAT && type != nvinfer1::DataType::kHALF) {
+        continue;
+      }
+      std::string name = std::string("output_") + std::to_string(ctx->num_outputs);
+      tensor->setName(name.c_str());
+      ctx->net->markOutput(*tensor);
+      LOG_DEBUG(ctx->logger, "Marking activation " << out->debugName() << " as output " << name);
+      ctx->marked_activations.push_back(out);
+      ctx->num_outputs += 1;
+    }
+  }
+}
+
 void AddParamsToCtxValueMap(ConversionCtx* ctx, GraphParams& params) {
-  for (auto p : params) {
-    ctx->evaluated_value_map[p.first] = std::move(p.second);
+  // Params are moved into the context so that they can be freed once their
+  // last user has been converted
+  for (auto& p : params) {
+    ctx->AssociateValueAndIValue(p.first, std::move(p.second));
   }
+  params.clear();
 }
 
-void EvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n);
+void ConvertOrEvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n);
 
 void MapIValues(
     ConversionCtx* ctx,
@@ -217,7 +354,7 @@ void MapIValues(
   for (auto p : input_output_pairs) {
     if (ctx->evaluated_value_map.find(p.first) != ctx->evaluated_value_map.end()) {
       auto input = ctx->evaluated_value_map[p.first];
-      ctx->evaluated_value_map[p.second] = torch::jit::IValue(input);
+      ctx->AssociateValueAndIValue(p.second, torch::jit::IValue(input));
     } else if (ctx->value_tensor_map.find(p.first) != ctx->value_tensor_map.end()) {
       auto input = ctx->value_tensor_map[p.first];
       ctx->value_tensor_map[p.second] = input;
@@ -245,10 +382,10 @@ void EvaluateConditionalBlock(ConversionCtx* ctx, const torch::jit::Node* n, boo
 
   for (const auto bn : b->nodes()) {
     if (bn->kind() == torch::jit::prim::Loop) {
-      EvaluateLoopBlock(ctx, bn);
+      ConvertOrEvaluateLoopBlock(ctx, bn);
     } else if (bn->kind() == torch::jit::prim::If) {
       EvaluateConditionalBlock(ctx, bn, contained_in_loop);
-    } else if (evaluators::shouldEvalAtConversionTime(bn)) {
+    } else if (IsEvaluatedNode(ctx, bn)) {
       auto eval = EvaluateNode(ctx, bn);
       if (!eval.value().isTensor()) {
         LOG_DEBUG(ctx->logger, "(Conditional Evaluation) Found the value to be: " << eval.value());
@@ -259,7 +396,7 @@ void EvaluateConditionalBlock(ConversionCtx* ctx, const torch::jit::Node* n, boo
                                                                               << ')');
       }
       ctx->AssociateValueAndIValue(bn->output(0), eval.value());
-    } else if (converters::node_is_convertable(bn)) {
+    } else if (ClassifyNode(ctx, bn).converter) {
       AddLayer(ctx, bn);
     } else {
       TRTORCH_THROW_ERROR(
@@ -289,12 +426,12 @@ void EvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n) {
     MapIValues(ctx, n->outputs(), n->blocks()[0]->inputs(), 0, 1);
     for (auto bn : n->blocks()[0]->nodes()) {
       if (bn->kind() == torch::jit::prim::Loop) {
-        EvaluateLoopBlock(ctx, n);
+        EvaluateLoopBlock(ctx, bn);
       } else if (bn->kind() == torch::jit::prim::If) {
         EvaluateConditionalBlock(ctx, bn, true);
       } else {
         TRTORCH_CHECK(
-            evaluators::shouldEvalAtConversionTime(bn),
+            IsEvaluatedNode(ctx, bn),
             "TRTorch currently can only compile loops that are evaluatable at conversion time but node "
                 << *bn << " cannot be evaluated.");
         auto eval = EvaluateNode(ctx, bn);
@@ -318,11 +455,226 @@ void EvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n) {
   }
 }
 
+bool BlockRequiresConversion(ConversionCtx* ctx, const torch::jit::Block* b) {
+  for (const auto bn : b->nodes()) {
+    auto handling = ClassifyNode(ctx, bn).handling;
+    if (handling == NodeHandling::kConvert || handling == NodeHandling::kUnsupported) {
+      return true;
+    }
+    // Tensor work may also sit in the blocks of nested conditionals and loops
+    for (const auto sub_b : bn->blocks()) {
+      if (BlockRequiresConversion(ctx, sub_b)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Loops that carry tensors or contain nodes that need converters cannot be
+// unrolled at conversion time and need to be lowered to a TensorRT ILoop
+bool LoopRequiresConversion(ConversionCtx* ctx, const torch::jit::Node* n) {
+  for (size_t i = 2; i < n->inputs().size(); i++) {
+    if (ctx->value_tensor_map.find(n->input(i)) != ctx->value_tensor_map.end()) {
+      return true;
+    }
+  }
+
+  return BlockRequiresConversion(ctx, n->blocks()[0]);
+}
+
+// Gets the Var currently associated with a value, either an ITensor or an
+// evaluated IValue
+Var GetValueVar(ConversionCtx* ctx, const torch::jit::Value* v) {
+  if (ctx->value_tensor_map.find(v) != ctx->value_tensor_map.end()) {
+    return Var(ctx->value_tensor_map[v]);
+  } else if (ctx->evaluated_value_map.find(v) != ctx->evaluated_value_map.end()) {
+    return Var(&ctx->evaluated_value_map[v]);
+  }
+  TRTORCH_THROW_ERROR("Cannot find Value " << v->debugName() << " either evaluated values or tensor maps (GetValueVar)");
+  return Var();
+}
+
+// Lowers a prim::Loop with tensor loop carried values to a TensorRT ILoop.
+// The body is converted once, loop carried tensors become IRecurrenceLayers,
+// the max trip count becomes the trip limit and the final values of the loop
+// carried tensors are read out with kLAST_VALUE loop outputs. Loop carried
+// values which are not tensors must be loop invariant.
+void ConvertLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n) {
+  auto body = n->blocks()[0];
+  TRTORCH_CHECK(
+      ctx->evaluated_value_map.find(n->input(0)) != ctx->evaluated_value_map.end() &&
+          ctx->evaluated_value_map.find(n->input(1)) != ctx->evaluated_value_map.end(),
+      "TRTorch can only convert loops where the max trip count and start condition are known at conversion time, loop: "
+          << util::node_info(n));
+  auto max_trip_count = ctx->evaluated_value_map[n->input(0)].toInt();
+  auto start_cond = ctx->evaluated_value_map[n->input(1)].toBool();
+
+  LOG_DEBUG(ctx->logger, "(Loop Conversion) Converting loop " << *n);
+  LOG_DEBUG(ctx->logger, "(Loop Conversion) Max Trip Count: " << max_trip_count);
+  LOG_DEBUG(ctx->logger, "(Loop Conversion) Start Condition: " << start_cond);
+
+  if (!start_cond || max_trip_count <= 0) {
+    LOG_DEBUG(ctx->logger, "(Loop Conversion) Loop body never runs, forwarding loop carried values to outputs");
+    MapIValues(ctx, n->inputs(), n->outputs(), 2, 0);
+    return;
+  }
+
+  // The body is only emitted once, so the iteration index has no single value
+  // at conversion time, and the nodes that take it (e.g. the index of
+  // aten::select) expect an int rather than a tensor
+  auto iter_idx = body->inputs()[0];
+  TRTORCH_CHECK(
+      iter_idx->uses().size() == 0,
+      "TRTorch can only convert loops which do not use their iteration index, but loop "
+          << util::node_info(n) << " uses it in " << util::node_info(iter_idx->uses()[0].user));
+
+  auto loop = ctx->net->addLoop();
+  TRTORCH_CHECK(loop, "Unable to create TensorRT loop for node: " << util::node_info(n));
+
+  auto trip_count = static_cast<int32_t>(std::min<int64_t>(max_trip_count, std::numeric_limits<int32_t>::max()));
+  auto trip_limit_weights = converters::Weights(ctx, trip_count);
+  auto trip_limit = ctx->net->addConstant(trip_limit_weights.shape, trip_limit_weights.data);
+  TRTORCH_CHECK(trip_limit, "Unable to create trip limit for loop: " << util::node_info(n));
+  loop->addTripLimit(*trip_limit->getOutput(0), nvinfer1::TripLimit::kCOUNT);
+
+  std::vector<nvinfer1::IRecurrenceLayer*> recurrences(n->outputs().size(), nullptr);
+  for (size_t i = 0; i < n->outputs().size(); i++) {
+    auto in = n->input(i + 2);
+    auto body_in = body->inputs()[i + 1];
+    auto body_out = body->outputs()[i + 1];
+    if (body_out == body_in) {
+      // Loop invariant values are visible to the body as is
+      MapIValues(ctx, {in}, {body_in}, 0, 0);
+      continue;
+    }
+
+    auto init = GetValueVar(ctx, in);
+    TRTORCH_CHECK(
+        init.isITensor() || init.IValue()->isTensor(),
+        "TRTorch can only convert loops where loop carried values are tensors or loop invariant, but "
+            << in->debugName() << " is of type " << *in->type());
+    auto recurrence = loop->addRecurrence(*init.ITensorOrFreeze(ctx));
+    TRTORCH_CHECK(recurrence, "Unable to create recurrence for loop carried value " << in->debugName());
+    ctx->AssociateValueAndTensor(body_in, recurrence->getOutput(0));
+    recurrences[i] = recurrence;
+  }
+
+  for (const auto bn : body->nodes()) {
+    if (bn->kind() == torch::jit::prim::Loop) {
+      ConvertOrEvaluateLoopBlock(ctx, bn);
+    } else if (bn->kind() == torch::jit::prim::If) {
+      // The body is only emitted once so conditionals with conditions that can
+      // be evaluated at conversion time are fine here
+      EvaluateConditionalBlock(ctx, bn);
+    } else if (IsEvaluatedNode(ctx, bn)) {
+      auto eval = EvaluateNode(ctx, bn);
+      if (eval) {
+        ctx->AssociateValueAndIValue(bn->output(0), eval.value());
+      }
+    } else if (ClassifyNode(ctx, bn).handling != NodeHandling::kIgnore) {
+      AddLayer(ctx, bn);
+    }
+  }
+
+  auto cond = body->outputs()[0];
+  TRTORCH_CHECK(
+      ctx->evaluated_value_map.find(cond) != ctx->evaluated_value_map.end() &&
+          ctx->evaluated_value_map[cond].toBool(),
+      "TRTorch can only convert loops which run for a fixed number of iterations, but the loop condition "
+          << cond->debugName() << " is not always true at conversion time");
+
+  for (size_t i = 0; i < n->outputs().size(); i++) {
+    if (recurrences[i] == nullptr) {
+      MapIValues(ctx, {n->input(i + 2)}, {n->output(i)}, 0, 0);
+      continue;
+    }
+
+    auto next = GetValueVar(ctx, body->outputs()[i + 1]).ITensorOrFreeze(ctx);
+    recurrences[i]->setInput(1, *next);
+    auto loop_out = loop->addLoopOutput(*next, nvinfer1::LoopOutput::kLAST_VALUE);
+    TRTORCH_CHECK(loop_out, "Unable to create loop output for " << n->output(i)->debugName());
+    ctx->AssociateValueAndTensor(n->output(i), loop_out->getOutput(0));
+  }
+}
+
+void ConvertOrEvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n) {
+  if (LoopRequiresConversion(ctx, n)) {
+    ConvertLoopBlock(ctx, n);
+  } else {
+    EvaluateLoopBlock(ctx, n);
+  }
+}
+
+void CollectNestedValues(const torch::jit::Block* b, std::vector<const torch::jit::Value*>& values) {
+  for (auto in : b->inputs()) {
+    values.push_back(in);
+  }
+  for (const auto n : b->nodes()) {
+    for (auto out : n->outputs()) {
+      values.push_back(out);
+    }
+    for (const auto sub_b : n->blocks()) {
+      CollectNestedValues(sub_b, values);
+    }
+  }
+}
+
+// Computes, for each node in the block, the set of values that are dead once
+// that node has been converted. Uses inside of sub-blocks are attributed to the
+// top level node that owns the sub-block and values defined inside of sub-blocks
+// die with their owning node. Block outputs are never considered dead.
+std::unordered_map<const torch::jit::Node*, std::vector<const torch::jit::Value*>> ComputeLastUses(
+    const torch::jit::Block* b) {
+  std::unordered_map<const torch::jit::Node*, size_t> node_idx;
+  size_t idx = 0;
+  for (const auto n : b->nodes()) {
+    node_idx[n] = idx++;
+  }
+
+  std::unordered_map<const torch::jit::Node*, std::vector<const torch::jit::Value*>> last_uses;
+  auto find_last_use = [&](const torch::jit::Value* v, const torch::jit::Node* def) {
+    // Values with no users are dead as soon as they are produced
+    const torch::jit::Node* last = def;
+    for (auto use : v->uses()) {
+      const torch::jit::Node* user = use.user;
+      while (user->owningBlock() != b) {
+        user = user->owningBlock()->owningNode();
+      }
+      if (user == b->return_node()) {
+        return;
+      }
+      if (last == nullptr || node_idx.at(user) > node_idx.at(last)) {
+        last = user;
+      }
+    }
+    if (last) {
+      last_uses[last].push_back(v);
+    }
+  };
+
+  for (auto in : b->inputs()) {
+    find_last_use(in, nullptr);
+  }
+
+  for (const auto n : b->nodes()) {
+    for (auto out : n->outputs()) {
+      find_last_use(out, n);
+    }
+    for (const auto sub_b : n->blocks()) {
+      CollectNestedValues(sub_b, last_uses[n]);
+    }
+  }
+
+  return last_uses;
+}
+
 void ConvertBlockToNetDef(
     ConversionCtx* ctx,
     const torch::jit::Block* b,
     ConversionInfo build_info,
     GraphParams& static_params) {
+  TRTORCH_TRACE_SCOPE("ConvertBlockToNetDef", "conversion");
   LOG_INFO(ctx->logger, "Converting Block");
 
   auto inputs = b->inputs();
@@ -330,13 +682,20 @@ void ConvertBlockToNetDef(
   AddInputs(ctx, inputs, build_info.input_ranges);
 
   auto nodes = b->nodes();
+  auto last_uses = ComputeLastUses(b);
+
+  // Decide how every node is handled up front, conversion below and nested
+  // loop / conditional evaluation only consult these tags
+  ctx->node_classifier = std::make_shared<NodeClassifier>();
+  ctx->node_classifier->ClassifyBlock(b);
 
   for (const auto n : nodes) {
-    bool to_eval = evaluators::shouldEvalAtConversionTime(n);
-    bool ignored = isNodeConversionIgnored(n);
-    if (n->kind() == torch::jit::prim::Loop) {
-      EvaluateLoopBlock(ctx, n);
-    } else if (n->kind() == torch::jit::prim::If) {
+    auto handling = ClassifyNode(ctx, n).handling;
+    bool to_eval = handling == NodeHandling::kEvaluate;
+    bool ignored = handling == NodeHandling::kIgnore;
+    if (handling == NodeHandling::kLoop) {
+      ConvertOrEvaluateLoopBlock(ctx, n);
+    } else if (handling == NodeHandling::kConditional) {
       EvaluateConditionalBlock(ctx, n);
     } else if (to_eval) {
       auto eval = EvaluateNode(ctx, n);
@@ -361,14 +720,45 @@ void ConvertBlockToNetDef(
       }
       LOG_DEBUG(ctx->logger, "Skipping Node: " << util::node_info(n) << reason);
     }
-  }
 
-  for (const auto n : nodes) {
     ctx->CheckLayerAddition(n);
+
+    // Free evaluated values (intermediate tensors, frozen params, etc.) which
+    // no remaining node depends on
+    auto dead_values = last_uses.find(n);
+    if (dead_values != last_uses.end()) {
+      for (auto v : dead_values->second) {
+        ctx->ReleaseValue(v);
+      }
+    }
   }
 
   auto outputs = b->outputs();
   MarkOutputs(ctx, outputs);
+  if (build_info.mark_activations) {
+    MarkActivations(ctx, b);
+  }
+  ctx->ReportLayerPrecisions();
+
+  if (ctx->op_precision == nvinfer1::DataType::kINT8 && ctx->settings.calibrator == nullptr) {
+    TRTORCH_CHECK(
+        ctx->num_dynamic_ranges > 0,
+        "Requested inference in INT8 but no calibrator or calibration file provided and the graph has no fake quantization from quantization aware training, set the ptq_calibrator or calibration_file field in the CompileSpec struct");
+    LOG_INFO(
+        ctx->logger,
+        "Using the dynamic ranges of " << ctx->num_dynamic_ranges
+                                       << " tensors for INT8, tensors without one fall back to higher precision");
+  }
+
+  // Evaluated values are not needed to build the engine, all weights have
+  // already been copied into the builder resources
+  std::vector<const torch::jit::Value*> remaining_values;
+  for (auto v : ctx->evaluated_value_map) {
+    remaining_values.push_back(v.first);
+  }
+  for (auto v : remaining_values) {
+    ctx->ReleaseValue(v);
+  }
 }
 
 // Converts a already lowered block (blocks with no sub blocks) to
@@ -378,14 +768,26 @@ void ConvertBlockToNetDef(
 std::string ConvertBlockToEngine(const torch::jit::Block* b, ConversionInfo build_info, GraphParams& static_params) {
   ConversionCtx ctx(build_info.engine_settings);
   ConvertBlockToNetDef(&ctx, b, build_info, static_params);
+  LOG_INFO(
+      ctx.logger,
+      "Peak memory held by the conversion context: " << ctx.peak_held_bytes / (1024.0 * 1024.0) << " MiB ("
+                                                      << ctx.held_bytes / (1024.0 * 1024.0)
+                                                      << " MiB in weights carried into the engine build)");
+  LOG_DEBUG(
+      ctx.logger,
+      "Reused " << ctx.num_reused_frozen_tensors << " frozen tensors instead of adding duplicate constant layers");
   std::string engine = ctx.SerializeEngine();
   return engine;
 }
 
-std::set<std::string> GetUnsupportedOpsInBlock(const torch::jit::Block* b) {
+std::set<std::string> GetUnsupportedOpsInBlock(NodeClassifier& classifier, const torch::jit::Block* b) {
   std::set<std::string> unsupported_ops;
   for (const auto n : b->nodes()) {
-    if (n->kind() != torch::jit::prim::Loop && n->kind() != torch::jit::prim::If && !OpSupported(n)) {
+    auto& classification = classifier.Classify(n);
+    bool supported = classification.handling == NodeHandling::kLoop ||
+        classification.handling == NodeHandling::kConditional ||
+        classification.handling == NodeHandling::kEvaluate || classification.converter;
+    if (!supported) {
       auto schema = n->maybeSchema();
       TRTORCH_CHECK(
           schema,
@@ -395,7 +797,7 @@ std::set<std::string> GetUnsupportedOpsInBlock(const torch::jit::Block* b) {
       unsupported_ops.insert(ss.str());
     }
     for (const auto sub_b : n->blocks()) {
-      auto sub_b_unsupported_ops = GetUnsupportedOpsInBlock(sub_b);
+      auto sub_b_unsupported_ops = GetUnsupportedOpsInBlock(classifier, sub_b);
       unsupported_ops.insert(sub_b_unsupported_ops.begin(), sub_b_unsupported_ops.end());
     }
   }
@@ -403,7 +805,8 @@ std::set<std::string> GetUnsupportedOpsInBlock(const torch::jit::Block* b) {
 }
 
 bool VerifyConverterSupportForBlock(const torch::jit::Block* b) {
-  auto unsupported_ops = GetUnsupportedOpsInBlock(b);
+  NodeClassifier classifier;
+  auto unsupported_ops = GetUnsupportedOpsInBlock(classifier, b);
 
   if (unsupported_ops.size() != 0) {
     std::stringstream unsupported_msg;
@@ -24,6 +24,11 @@ struct InputRange {
 struct ConversionInfo {
   std::vector<InputRange> input_ranges;
   BuilderSettings engine_settings;
+  // Also mark every tensor produced by a converted node of the block as an
+  // output of the engine, after the outputs of the block (see
+  // ConversionCtx::marked_activations), so activations can be compared against
+  // TorchScript
+  bool mark_activations = false;
   ConversionInfo(std::vector<InputRange> input_ranges)
       : input_ranges(std::move(input_ranges)), engine_settings(BuilderSettings()) {}
 };
@@ -34,8 +39,17 @@ using GraphParams = std::map<torch::jit::Value*, torch::jit::IValue>;
 
 GraphParams get_named_params(c10::ArrayRef<torch::jit::Value*> inputs, std::vector<torch::jit::IValue> params);
 
+// Populates the network definition of ctx from an already lowered block
+// without building an engine
+void ConvertBlockToNetDef(
+    ConversionCtx* ctx,
+    const torch::jit::Block* b,
+    ConversionInfo build_info,
+    GraphParams& static_params);
+
 // Converts a already lowered block (blocks with no sub blocks) to
 // a serialized TensorRT engine that can be deserialized and run
+// static_params is consumed during conversion
 std::string ConvertBlockToEngine(const torch::jit::Block* b, ConversionInfo build_info, GraphParams& static_params);
 
 bool OpSupported(const torch::jit::Node* n);
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <iostream>
+#include <regex>
 #include <sstream>
 #include <utility>
 
@@ -8,6 +10,115 @@ namespace trtorch {
 namespace core {
 namespace conversion {
 
+namespace {
+uint64_t tensorBytes(const torch::jit::IValue& ivalue) {
+  if (ivalue.isTensor()) {
+    auto t = ivalue.toTensor();
+    return t.defined() ? t.nbytes() : 0;
+  } else if (ivalue.isTensorList()) {
+    uint64_t bytes = 0;
+    for (auto t : ivalue.toTensorList().vec()) {
+      bytes += t.defined() ? t.nbytes() : 0;
+    }
+    return bytes;
+  }
+  return 0;
+}
+
+// Shapes TensorRT calibrates each input of the network with
+calibration::BindingDims calibrationBindingDims(nvinfer1::INetworkDefinition* net, nvinfer1::IBuilderConfig* cfg) {
+  calibration::BindingDims dims;
+  for (int32_t i = 0; i < net->getNbInputs(); i++) {
+    auto in = net->getInput(i);
+#if NV_TENSORRT_MAJOR > 7 || (NV_TENSORRT_MAJOR == 7 && NV_TENSORRT_MINOR >= 1)
+    auto profile = cfg->getCalibrationProfile();
+    if (profile) {
+      dims[in->getName()] = util::toVec(profile->getDimensions(in->getName(), nvinfer1::OptProfileSelector::kOPT));
+      continue;
+    }
+#endif
+    auto shape = util::toVec(in->getDimensions());
+    // Dynamic inputs are calibrated at the optimal shape of a profile, without
+    // a calibration profile to read it from the shape is left unchecked
+    if (std::find(shape.begin(), shape.end(), -1) == shape.end()) {
+      dims[in->getName()] = shape;
+    }
+  }
+  return dims;
+}
+} // namespace
+
+struct LayerPrecisionMatcher {
+  struct Rule {
+    c10::optional<std::regex> kind;
+    c10::optional<std::regex> scope;
+    c10::optional<std::regex> name;
+    nvinfer1::DataType precision;
+    std::string description;
+    uint64_t num_matches = 0;
+  };
+
+  LayerPrecisionMatcher(const std::vector<LayerPrecisionRule>& layer_precisions) {
+    for (auto& r : layer_precisions) {
+      std::stringstream ss;
+      ss << "{kind: \"" << r.kind << "\", scope: \"" << r.scope << "\", name: \"" << r.name << "\"} -> " << r.precision;
+      TRTORCH_CHECK(
+          !r.kind.empty() || !r.scope.empty() || !r.name.empty(),
+          "Layer precision rule " << ss.str() << " needs at least one of kind, scope or name set");
+      TRTORCH_CHECK(
+          r.precision == nvinfer1::DataType::kFLOAT || r.precision == nvinfer1::DataType::kHALF ||
+              r.precision == nvinfer1::DataType::kINT8,
+          "Layer precision rule " << ss.str() << " requests an unsupported precision");
+
+      Rule rule;
+      rule.precision = r.precision;
+      rule.description = ss.str();
+      try {
+        if (!r.kind.empty()) {
+          rule.kind = std::regex(r.kind);
+        }
+        if (!r.scope.empty()) {
+          rule.scope = std::regex(r.scope);
+        }
+        if (!r.name.empty()) {
+          rule.name = std::regex(r.name);
+        }
+      } catch (std::regex_error& e) {
+        TRTORCH_THROW_ERROR("Invalid pattern in layer precision rule " << ss.str() << ": " << e.what());
+      }
+      rules.push_back(std::move(rule));
+    }
+  }
+
+  c10::optional<nvinfer1::DataType> Match(const torch::jit::Node* n) {
+    std::string kind = n->kind().toQualString();
+    std::string scope = n->scope() ? n->scope()->namesFromRoot() : "";
+    // Later rules take precedence over earlier ones
+    for (auto r = rules.rbegin(); r != rules.rend(); r++) {
+      if (r->kind && !std::regex_match(kind, *r->kind)) {
+        continue;
+      }
+      if (r->scope && !std::regex_match(scope, *r->scope)) {
+        continue;
+      }
+      if (r->name) {
+        bool named = false;
+        for (auto out : n->outputs()) {
+          named |= std::regex_match(out->debugName(), *r->name);
+        }
+        if (!named) {
+          continue;
+        }
+      }
+      r->num_matches++;
+      return r->precision;
+    }
+    return {};
+  }
+
+  std::vector<Rule> rules;
+};
+
 // clang-format off
 std::ostream& operator<<(std::ostream& os, const BuilderSettings& s) {
     os << "Settings requested for TensorRT engine:"                                        \
@@ -34,7 +145,14 @@ std::ostream& operator<<(std::ostream& os, const BuilderSettings& s) {
         os << "\n    DLACore: " << s.device.dla_core;
     }
     os << "\n    Engine Capability: " << s.capability                                      \
-       << "\n    Calibrator Created: " << (s.calibrator != nullptr);
+       << "\n    Calibrator Created: " << (s.calibrator != nullptr)                      \
+       << "\n    Layer Precision Rules: " << s.layer_precisions.size();
+    if (!s.calibration_file.empty()) {
+        os << "\n    Calibration File: " << s.calibration_file;
+    }
+    if (!s.precision_profile.empty()) {
+        os << "\n    Precision Profile: " << s.precision_profile;
+    }
     return os;
 }
 // clang-format on
@@ -51,12 +169,12 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
 
   LOG_DEBUG(build_settings);
   cfg = builder->createBuilderConfig();
+  ApplyPrecisionSettings();
 
   switch (settings.op_precision) {
     case nvinfer1::DataType::kHALF:
       TRTORCH_CHECK(builder->platformHasFastFp16(), "Requested inference in FP16 but platform does support FP16");
       cfg->setFlag(nvinfer1::BuilderFlag::kFP16);
-      input_type = nvinfer1::DataType::kHALF;
       break;
     case nvinfer1::DataType::kINT8:
       TRTORCH_CHECK(builder->platformHasFastInt8(), "Requested inference in INT8 but platform does support INT8");
@@ -64,18 +182,17 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
       if (!settings.strict_types) {
         cfg->setFlag(nvinfer1::BuilderFlag::kFP16);
       }
-      input_type = nvinfer1::DataType::kFLOAT;
-      TRTORCH_CHECK(
-          settings.calibrator != nullptr,
-          "Requested inference in INT8 but no calibrator provided, set the ptq_calibrator field in the CompileSpec struct with your calibrator");
-      cfg->setInt8Calibrator(settings.calibrator);
+      // Without a calibrator the dynamic ranges of quantization aware trained
+      // models or from the calibration file are used, checked once the network
+      // is converted
+      if (settings.calibrator != nullptr) {
+        cfg->setInt8Calibrator(settings.calibrator);
+      }
       break;
     case nvinfer1::DataType::kFLOAT:
     default:
-      input_type = nvinfer1::DataType::kFLOAT;
       break;
   }
-  op_precision = settings.op_precision;
 
   if (settings.refit) {
     cfg->setFlag(nvinfer1::BuilderFlag::kREFIT);
@@ -89,6 +206,18 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
     cfg->setFlag(nvinfer1::BuilderFlag::kSTRICT_TYPES);
   }
 
+  if (layer_precision_matcher) {
+    if (unmatched_layer_precision) {
+      // Rules run layers in FP16 in an FP32 engine
+      TRTORCH_CHECK(builder->platformHasFastFp16(), "Requested layers in FP16 but platform does support FP16");
+      cfg->setFlag(nvinfer1::BuilderFlag::kFP16);
+    }
+    // Without strict types the precision of a layer is only a preference
+    // TensorRT may ignore in favor of a faster kernel, layers without a pinned
+    // precision are still free to pick any enabled precision
+    cfg->setFlag(nvinfer1::BuilderFlag::kSTRICT_TYPES);
+  }
+
   if (settings.device.allow_gpu_fallback) {
     cfg->setFlag(nvinfer1::BuilderFlag::kGPU_FALLBACK);
   }
@@ -118,10 +247,56 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
   }
 }
 
+ConversionCtx::ConversionCtx(BuilderSettings build_settings, nvinfer1::INetworkDefinition* network)
+    : settings(build_settings),
+      logger(
+          "[TRTorch Conversion Context] - ",
+          util::logging::get_logger().get_reportable_severity(),
+          util::logging::get_logger().get_is_colored_output_on()) {
+  net = network;
+  LOG_DEBUG(build_settings);
+  ApplyPrecisionSettings();
+}
+
+void ConversionCtx::ApplyPrecisionSettings() {
+  op_precision = settings.op_precision;
+  input_type = op_precision == nvinfer1::DataType::kHALF ? nvinfer1::DataType::kHALF : nvinfer1::DataType::kFLOAT;
+  if (op_precision == nvinfer1::DataType::kINT8 && !settings.calibration_file.empty()) {
+    activation_ranges = calibration::ReadCalibrationFile(settings.calibration_file);
+  }
+
+  auto layer_precisions = settings.layer_precisions;
+  if (!settings.precision_profile.empty()) {
+    auto profile = ReadPrecisionProfile(settings.precision_profile);
+    layer_precisions.insert(layer_precisions.begin(), profile.begin(), profile.end());
+  }
+  if (layer_precisions.empty()) {
+    return;
+  }
+
+  layer_precision_matcher = std::make_shared<LayerPrecisionMatcher>(layer_precisions);
+  for (auto& r : layer_precisions) {
+    if (r.precision == nvinfer1::DataType::kHALF && op_precision == nvinfer1::DataType::kFLOAT) {
+      // FP16 gets enabled for the whole network, so everything the rules do not
+      // match is pinned to FP32 to keep the rest of the engine in FP32
+      unmatched_layer_precision = nvinfer1::DataType::kFLOAT;
+    }
+    // INT8 layers need dynamic ranges, which are only provided for INT8
+    // engines
+    TRTORCH_CHECK(
+        r.precision != nvinfer1::DataType::kINT8 || op_precision == nvinfer1::DataType::kINT8,
+        "Layers can only be pinned to INT8 when the operating precision is INT8");
+  }
+}
+
 ConversionCtx::~ConversionCtx() {
-  builder->destroy();
+  if (builder) {
+    builder->destroy();
+  }
   net->destroy();
-  cfg->destroy();
+  if (cfg) {
+    cfg->destroy();
+  }
   for (auto ptr : builder_resources) {
     free(ptr);
   }
@@ -130,21 +305,134 @@ ConversionCtx::~ConversionCtx() {
 nvinfer1::ITensor* ConversionCtx::AssociateValueAndTensor(const torch::jit::Value* value, nvinfer1::ITensor* tensor) {
   tensor->setName(value->debugName().c_str());
   this->value_tensor_map[value] = tensor;
+  ApplyActivationRange(value, tensor);
   return tensor;
 }
 
+void ConversionCtx::ApplyActivationRange(const torch::jit::Value* value, nvinfer1::ITensor* tensor) {
+  if (activation_ranges.empty()) {
+    return;
+  }
+  auto iter = activation_ranges.find(value->debugName());
+  if (iter != activation_ranges.end()) {
+    LOG_GRAPH(logger, "Setting the dynamic range of " << value->debugName() << " to +/-" << iter->second);
+    tensor->setDynamicRange(-iter->second, iter->second);
+    num_dynamic_ranges++;
+  }
+}
+
 torch::jit::IValue* ConversionCtx::AssociateValueAndIValue(const torch::jit::Value* value, torch::jit::IValue ivalue) {
+  auto iter = this->evaluated_value_map.find(value);
+  if (iter != this->evaluated_value_map.end()) {
+    TrackRelease(tensorBytes(iter->second));
+  }
+  TrackAllocation(tensorBytes(ivalue));
   this->evaluated_value_map[value] = std::move(ivalue);
   return &this->evaluated_value_map[value];
 }
 
+void ConversionCtx::ReleaseValue(const torch::jit::Value* value) {
+  auto iter = this->evaluated_value_map.find(value);
+  if (iter != this->evaluated_value_map.end()) {
+    LOG_GRAPH(logger, "Releasing evaluated value " << value->debugName() << " after its last use");
+    TrackRelease(tensorBytes(iter->second));
+    this->evaluated_value_map.erase(iter);
+  }
+}
+
+void ConversionCtx::TrackAllocation(uint64_t bytes) {
+  held_bytes += bytes;
+  peak_held_bytes = std::max(peak_held_bytes, held_bytes);
+}
+
+void ConversionCtx::TrackRelease(uint64_t bytes) {
+  held_bytes -= std::min(held_bytes, bytes);
+}
+
 std::string ConversionCtx::SerializeEngine() {
+  TRTORCH_TRACE_SCOPE("BuildEngine", "conversion");
+  TRTORCH_CHECK(builder, "Unable to build an engine from a context converting into a caller provided network");
+  bool calibrating = op_precision == nvinfer1::DataType::kINT8 && settings.calibrator != nullptr;
+  if (calibrating) {
+    calibration::RegisterCalibrationBindings(settings.calibrator, calibrationBindingDims(net, cfg));
+  }
   auto engine = builder->buildEngineWithConfig(*net, *cfg);
+  if (calibrating) {
+    // Rethrows anything that went wrong feeding batches to the calibrator,
+    // which TensorRT would otherwise take as the end of the calibration data
+    try {
+      calibration::ReleaseCalibrationBindings(settings.calibrator);
+    } catch (...) {
+      if (engine) {
+        engine->destroy();
+      }
+      throw;
+    }
+  }
+  TRTORCH_CHECK(engine, "Failed to build the TensorRT engine, see the TensorRT log for details");
   auto serialized_engine = engine->serialize();
   engine->destroy();
   return std::string((const char*)serialized_engine->data(), serialized_engine->size());
 }
 
+c10::optional<nvinfer1::DataType> ConversionCtx::LayerPrecision(const torch::jit::Node* n) {
+  if (!layer_precision_matcher) {
+    return {};
+  }
+  auto precision = layer_precision_matcher->Match(n);
+  return precision ? precision : unmatched_layer_precision;
+}
+
+void ConversionCtx::PinLayerPrecision(const torch::jit::Node* n, int32_t first_layer, nvinfer1::DataType precision) {
+  for (int32_t i = first_layer; i < net->getNbLayers(); i++) {
+    auto layer = net->getLayer(i);
+    // Weights and shape computations have no arithmetic to pin, nor do layers
+    // working on integers (indices, shapes)
+    if (layer->getType() == nvinfer1::LayerType::kCONSTANT || layer->getType() == nvinfer1::LayerType::kSHAPE) {
+      continue;
+    }
+    bool computes_floats = true;
+    for (int32_t j = 0; j < layer->getNbOutputs(); j++) {
+      auto type = layer->getOutput(j)->getType();
+      computes_floats &= type != nvinfer1::DataType::kINT32 && type != nvinfer1::DataType::kBOOL;
+    }
+    if (!computes_floats) {
+      continue;
+    }
+
+    LOG_DEBUG(
+        logger, "Pinning layer " << layer->getName() << " of " << util::node_info(n) << " to " << precision);
+    layer->setPrecision(precision);
+    for (int32_t j = 0; j < layer->getNbOutputs(); j++) {
+      layer->setOutputType(j, precision);
+    }
+    num_pinned_layers++;
+  }
+}
+
+std::vector<std::string> ConversionCtx::UnmatchedLayerPrecisionRules() {
+  std::vector<std::string> unmatched;
+  if (!layer_precision_matcher) {
+    return unmatched;
+  }
+  for (auto& r : layer_precision_matcher->rules) {
+    if (r.num_matches == 0) {
+      unmatched.push_back(r.description);
+    }
+  }
+  return unmatched;
+}
+
+void ConversionCtx::ReportLayerPrecisions() {
+  if (!layer_precision_matcher) {
+    return;
+  }
+  for (auto& r : UnmatchedLayerPrecisionRules()) {
+    LOG_WARNING(logger, "Layer precision rule " << r << " did not match any converted node");
+  }
+  LOG_INFO(logger, "Pinned the precision of " << num_pinned_layers << " layers with layer precision rules");
+}
+
 bool ConversionCtx::CheckLayerAddition(const torch::jit::Node* n) {
   for (auto out : n->outputs()) {
     auto iter_t = this->value_tensor_map.find(out);
@@ -2,12 +2,15 @@
 
 #include <map>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "NvInfer.h"
 #include "torch/csrc/jit/ir/ir.h"
 
 #include <cuda_runtime.h>
+#include "core/calibration/calibration.h"
 #include "core/util/prelude.h"
 
 namespace trtorch {
@@ -22,6 +25,26 @@ struct Device {
   Device() : device_type(nvinfer1::DeviceType::kGPU), gpu_id(0), dla_core(0), allow_gpu_fallback(false) {}
 };
 
+// Pins the layers a node is converted to, and their output tensors, to a
+// precision. Patterns are regular expressions which have to match in full, a
+// node matches the rule if it matches every pattern that is set
+struct LayerPrecisionRule {
+  // Kind of the node, Ex. aten::linear
+  std::string kind;
+  // Scope of the node (the module hierarchy recorded by tracing), Ex.
+  // __module.features/__module.features.0
+  std::string scope;
+  // Debug name of any output of the node in the lowered graph
+  std::string name;
+  nvinfer1::DataType precision = nvinfer1::DataType::kFLOAT;
+};
+
+// Precision profiles are plain text, a header line followed by one rule per
+// line: the precision (float, half or int8) then tab separated
+// "<kind|scope|name>=<pattern>" selectors (defined in PrecisionProfile.cpp)
+void WritePrecisionProfile(const std::string& path, const std::vector<LayerPrecisionRule>& rules);
+std::vector<LayerPrecisionRule> ReadPrecisionProfile(const std::string& path);
+
 struct BuilderSettings {
   nvinfer1::DataType op_precision = nvinfer1::DataType::kFLOAT;
   bool refit = false;
@@ -30,6 +53,15 @@ struct BuilderSettings {
   Device device;
   nvinfer1::EngineCapability capability = nvinfer1::EngineCapability::kDEFAULT;
   nvinfer1::IInt8Calibrator* calibrator = nullptr;
+  // Activation ranges collected by calibration::CollectActivationRanges, used
+  // as dynamic ranges for INT8 instead of calibrating with TensorRT
+  std::string calibration_file = "";
+  // When several rules match a node the last one wins
+  std::vector<LayerPrecisionRule> layer_precisions;
+  // Layer precision rules saved by precision_search::SearchLayerPrecisions (or
+  // WritePrecisionProfile), applied before layer_precisions so those take
+  // precedence
+  std::string precision_profile = "";
   uint64_t num_min_timing_iters = 2;
   uint64_t num_avg_timing_iters = 1;
   uint64_t workspace_size = 0;
@@ -40,21 +72,54 @@ struct BuilderSettings {
   friend std::ostream& operator<<(std::ostream& os, const BuilderSettings& s);
 };
 
+// Defined in core/conversion/conversion.cpp
+struct NodeClassifier;
+
+// Defined in core/conversion/conversionctx/ConversionCtx.cpp
+struct LayerPrecisionMatcher;
+
+// A tensor frozen into an IConstantLayer, data points at the copy held in the
+// builder resources
+struct FrozenTensor {
+  at::ScalarType dtype;
+  std::vector<int64_t> sizes;
+  const void* data;
+  size_t nbytes;
+  nvinfer1::ITensor* tensor;
+};
+
 struct ConversionCtx {
   ConversionCtx(BuilderSettings settings);
+  // Converts into a network definition provided by the caller, which the
+  // context takes ownership of, without creating a builder. Used to inspect
+  // converted networks, contexts created this way cannot build engines
+  ConversionCtx(BuilderSettings settings, nvinfer1::INetworkDefinition* network);
+  // Sets up the operating precision, the activation ranges of the calibration
+  // file and the layer precision rules from the settings, shared by both
+  // constructors
+  void ApplyPrecisionSettings();
   std::string SerializeEngine();
   nvinfer1::ITensor* AssociateValueAndTensor(const torch::jit::Value* value, nvinfer1::ITensor* tensor);
+  void ApplyActivationRange(const torch::jit::Value* value, nvinfer1::ITensor* tensor);
   torch::jit::IValue* AssociateValueAndIValue(const torch::jit::Value* value, torch::jit::IValue tensor);
+  void ReleaseValue(const torch::jit::Value* value);
+  void TrackAllocation(uint64_t bytes);
+  void TrackRelease(uint64_t bytes);
   bool CheckLayerAddition(const torch::jit::Node* n);
+  c10::optional<nvinfer1::DataType> LayerPrecision(const torch::jit::Node* n);
+  void PinLayerPrecision(const torch::jit::Node* n, int32_t first_layer, nvinfer1::DataType precision);
+  // Descriptions of the layer precision rules which have not matched a node
+  std::vector<std::string> UnmatchedLayerPrecisionRules();
+  void ReportLayerPrecisions();
 
   ~ConversionCtx();
 
   uint64_t num_inputs = 0;
   uint64_t num_outputs = 0;
   bool input_is_dynamic = false;
-  nvinfer1::IBuilder* builder;
-  nvinfer1::INetworkDefinition* net;
-  nvinfer1::IBuilderConfig* cfg;
+  nvinfer1::IBuilder* builder = nullptr;
+  nvinfer1::INetworkDefinition* net = nullptr;
+  nvinfer1::IBuilderConfig* cfg = nullptr;
   nvinfer1::DataType input_type;
   nvinfer1::DataType op_precision;
   BuilderSettings settings;
@@ -65,9 +130,45 @@ struct ConversionCtx {
   // is constructed from a PyTorch Tensor it allocates the data here to store a
   // copy of the values
   std::vector<void*> builder_resources;
+  // Bytes of tensor data currently held by the context (evaluated tensors and
+  // weight copies) and the high water mark reached during conversion. Constants
+  // embedded in the graph being converted are held by the graph as well until
+  // the caller drops it (see LoweringCache::Release), that is not counted here
+  uint64_t held_bytes = 0;
+  uint64_t peak_held_bytes = 0;
 
   std::unordered_map<const torch::jit::Value*, nvinfer1::ITensor*> value_tensor_map;
   std::unordered_map<const torch::jit::Value*, torch::jit::IValue> evaluated_value_map;
+  // Tensors already frozen into IConstantLayers, by the tensor they came from
+  // and by content hash, so weights used by several nodes or equal constants
+  // are only added to the network once (see Var::ITensorOrFreeze). The weak
+  // reference keeps a released tensor from being reallocated at the same
+  // address during conversion while still letting its storage be freed
+  std::unordered_map<
+      const c10::TensorImpl*,
+      std::pair<c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>, nvinfer1::ITensor*>>
+      frozen_impl_map;
+  std::unordered_multimap<size_t, FrozenTensor> frozen_tensor_map;
+  uint64_t num_reused_frozen_tensors = 0;
+  // Ranges from the calibration file, by value name
+  calibration::ActivationRanges activation_ranges;
+  // Tensors given a dynamic range from the fake quantization of a quantization
+  // aware trained model or from the calibration file, INT8 builds need either
+  // these or a calibrator
+  uint64_t num_dynamic_ranges = 0;
+  // How each node is handled (evaluated, converted, ignored) along with the
+  // resolved evaluator or converter, so the registries are only queried once
+  // per node
+  std::shared_ptr<NodeClassifier> node_classifier;
+  // Layer precision rules with their patterns compiled
+  std::shared_ptr<LayerPrecisionMatcher> layer_precision_matcher;
+  // Precision of the layers no rule matches, set to FP32 when rules enable FP16
+  // in an FP32 engine so only the layers they match run in FP16
+  c10::optional<nvinfer1::DataType> unmatched_layer_precision;
+  uint64_t num_pinned_layers = 0;
+  // Values marked as outputs of the engine when ConversionInfo::mark_activations
+  // is set, in order of the outputs following the outputs of the block
+  std::vector<const torch::jit::Value*> marked_activations;
 };
 
 } // namespace conversion
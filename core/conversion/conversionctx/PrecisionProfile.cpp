@@ -0,0 +1,108 @@
+#include <fstream>
+#include <sstream>
+
+#include "core/conversion/conversionctx/ConversionCtx.h"
+
+namespace trtorch {
+namespace core {
+namespace conversion {
+
+namespace {
+const std::string kPrecisionProfileHeader = "TRTorch-PrecisionProfile-1";
+
+std::string PrecisionName(nvinfer1::DataType precision) {
+  switch (precision) {
+    case nvinfer1::DataType::kHALF:
+      return "half";
+    case nvinfer1::DataType::kINT8:
+      return "int8";
+    case nvinfer1::DataType::kFLOAT:
+    default:
+      return "float";
+  }
+}
+
+c10::optional<nvinfer1::DataType> ParsePrecision(const std::string& name) {
+  if (name == "float" || name == "float32" || name == "f32") {
+    return nvinfer1::DataType::kFLOAT;
+  } else if (name == "half" || name == "float16" || name == "f16") {
+    return nvinfer1::DataType::kHALF;
+  } else if (name == "int8" || name == "i8") {
+    return nvinfer1::DataType::kINT8;
+  }
+  return {};
+}
+} // namespace
+
+void WritePrecisionProfile(const std::string& path, const std::vector<LayerPrecisionRule>& rules) {
+  std::ofstream file(path);
+  TRTORCH_CHECK(file.good(), "Unable to open precision profile " << path << " for writing");
+  file << kPrecisionProfileHeader << '\n';
+  for (auto& r : rules) {
+    file << PrecisionName(r.precision);
+    if (!r.kind.empty()) {
+      file << "\tkind=" << r.kind;
+    }
+    if (!r.scope.empty()) {
+      file << "\tscope=" << r.scope;
+    }
+    if (!r.name.empty()) {
+      file << "\tname=" << r.name;
+    }
+    file << '\n';
+  }
+  TRTORCH_CHECK(file.good(), "Failed to write precision profile " << path);
+  LOG_INFO("Saved " << rules.size() << " layer precision rules to " << path);
+}
+
+std::vector<LayerPrecisionRule> ReadPrecisionProfile(const std::string& path) {
+  std::ifstream file(path);
+  TRTORCH_CHECK(file.good(), "Unable to open precision profile " << path);
+
+  std::string line;
+  std::getline(file, line);
+  TRTORCH_CHECK(
+      line == kPrecisionProfileHeader,
+      path << " is not a TRTorch precision profile (expected a " << kPrecisionProfileHeader << " header)");
+
+  std::vector<LayerPrecisionRule> rules;
+  size_t line_num = 1;
+  while (std::getline(file, line)) {
+    line_num++;
+    if (line.empty()) {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string field;
+    std::getline(fields, field, '\t');
+    auto precision = ParsePrecision(field);
+    TRTORCH_CHECK(precision, "Invalid precision " << field << " on line " << line_num << " of " << path);
+
+    LayerPrecisionRule rule;
+    rule.precision = *precision;
+    while (std::getline(fields, field, '\t')) {
+      auto pattern_start = field.find('=');
+      TRTORCH_CHECK(
+          pattern_start != std::string::npos,
+          "Malformed selector on line " << line_num << " of " << path << ": " << field);
+      auto key = field.substr(0, pattern_start);
+      auto pattern = field.substr(pattern_start + 1);
+      if (key == "kind") {
+        rule.kind = pattern;
+      } else if (key == "scope") {
+        rule.scope = pattern;
+      } else if (key == "name") {
+        rule.name = pattern;
+      } else {
+        TRTORCH_THROW_ERROR("Unknown selector " << key << " on line " << line_num << " of " << path);
+      }
+    }
+    rules.push_back(std::move(rule));
+  }
+  LOG_DEBUG("Read " << rules.size() << " layer precision rules from " << path);
+  return rules;
+}
+
+} // namespace conversion
+} // namespace core
+} // namespace trtorch
@@ -1,3 +1,6 @@
+#include <chrono>
+#include <mutex>
+
 #include "core/conversion/converters/converters.h"
 #include "core/util/prelude.h"
 #include "torch/csrc/jit/frontend/function_schema_parser.h"
@@ -46,17 +49,24 @@ using ConverterLUT = std::unordered_map<c10::OperatorName, OpConverter>;
 class NodeConverterRegistry {
  public:
   bool RegisterConverter(torch::jit::FunctionSchema* signature, OpConverter& converter) {
-    LOG_DEBUG("Registering converter for " << canonical_schema_string(*signature));
-    auto name = signature->operator_name();
-    auto iter = converter_lut_.find(name);
-    if (iter != converter_lut_.end()) {
-      LOG_WARNING("Overriding already registered converter " << signature->name() << ", unexpected behavior may occur");
-    }
-    converter_lut_[name] = std::move(converter);
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    // Keep registration order so that overrides behave the same regardless of
+    // which patterns are still pending
+    ParsePendingPatterns();
+    InsertConverter(*signature, converter);
     return true;
   }
 
+  void RegisterPattern(ConversionPattern p) {
+    // Schemas are only parsed on first lookup so processes which just run
+    // compiled modules do not pay for parsing every converter schema on load
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    pending_patterns_.push_back(std::move(p));
+  }
+
   OpConverter GetConverter(const torch::jit::FunctionSchema* signature) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    ParsePendingPatterns();
     auto name = signature->operator_name();
     auto iter = converter_lut_.find(name);
     if (iter == converter_lut_.end()) {
@@ -67,24 +77,72 @@ class NodeConverterRegistry {
     return iter->second;
   }
 
-  bool Convertable(const torch::jit::Node* n) {
+  OpConverter FindConverter(const torch::jit::Node* n) {
     auto schema = n->maybeSchema();
     if (schema) {
+      std::lock_guard<std::mutex> lock(registry_mutex_);
+      ParsePendingPatterns();
       auto name = schema->operator_name();
       auto iter = converter_lut_.find(name);
       if (iter == converter_lut_.end()) {
-        return false;
+        return nullptr;
       } else {
-        return true;
+        return iter->second;
       }
     } else {
-      LOG_DEBUG("Unable to get schema for Node " << util::node_info(n) << " (NodeConverterRegistry.Convertable)");
-      return false;
+      LOG_DEBUG("Unable to get schema for Node " << util::node_info(n) << " (NodeConverterRegistry.FindConverter)");
+      return nullptr;
     }
   }
 
+  bool Convertable(const torch::jit::Node* n) {
+    return FindConverter(n) != nullptr;
+  }
+
  private:
+  void InsertConverter(const torch::jit::FunctionSchema& signature, OpConverter& converter) {
+    LOG_DEBUG("Registering converter for " << canonical_schema_string(signature));
+    auto name = signature.operator_name();
+    auto iter = converter_lut_.find(name);
+    if (iter != converter_lut_.end()) {
+      LOG_WARNING("Overriding already registered converter " << signature.name() << ", unexpected behavior may occur");
+    }
+    converter_lut_[name] = std::move(converter);
+  }
+
+  // Expects registry_mutex_ to be held
+  void ParsePendingPatterns() {
+    if (pending_patterns_.size() == 0) {
+      return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto num_patterns = pending_patterns_.size();
+    // All schemas are parsed before any converter is inserted so a bad schema
+    // leaves the registry as it was instead of half populated
+    std::vector<torch::jit::FunctionSchema> schemas;
+    schemas.reserve(num_patterns);
+    for (auto& p : pending_patterns_) {
+      try {
+        schemas.push_back(torch::jit::parseSchema(p.signature));
+      } catch (const std::exception& e) {
+        TRTORCH_THROW_ERROR("Unable to parse schema of converter " << p.signature << ": " << e.what());
+      }
+    }
+    for (size_t i = 0; i < num_patterns; i++) {
+      InsertConverter(schemas[i], pending_patterns_[i].converter);
+    }
+    pending_patterns_.clear();
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    LOG_DEBUG(
+        "Parsed " << num_patterns << " converter schemas in "
+                  << std::chrono::duration<float, std::milli>(stop - start).count() << " ms");
+  }
+
   ConverterLUT converter_lut_;
+  std::vector<ConversionPattern> pending_patterns_;
+  std::mutex registry_mutex_;
 };
 
 NodeConverterRegistry& get_converter_registry() {
@@ -98,19 +156,21 @@ void register_node_converter(torch::jit::FunctionSchema* signature, OpConverter&
 }
 
 void register_node_converter(std::string signature, OpConverter& converter) {
-  auto schema = torch::jit::parseSchema(signature);
-  // TODO: CHECKING THIS IS A VALID SCHEMA AND QUITING IF NOT
-  register_node_converter(&schema, converter);
+  get_converter_registry().RegisterPattern({std::move(signature), converter});
 }
 
 void register_node_converter(ConversionPattern p) {
-  register_node_converter(p.signature, p.converter);
+  get_converter_registry().RegisterPattern(std::move(p));
 }
 
 OpConverter get_node_converter_for(const torch::jit::FunctionSchema* signature) {
   return get_converter_registry().GetConverter(signature);
 }
 
+OpConverter find_node_converter_for(const torch::jit::Node* n) {
+  return get_converter_registry().FindConverter(n);
+}
+
 bool node_is_convertable(const torch::jit::Node* n) {
   return get_converter_registry().Convertable(n);
 }
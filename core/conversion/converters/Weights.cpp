@@ -1,3 +1,5 @@
+#include <limits>
+
 #include "core/conversion/converters/Weights.h"
 #include "core/util/prelude.h"
 
@@ -24,6 +26,7 @@ Weights::Weights(ConversionCtx* ctx, float val) {
   this->data.values = buf;
   this->data.count = 1;
   ctx->builder_resources.push_back(buf);
+  ctx->TrackAllocation(this->data.count * sizeof(float));
 
   this->shape.nbDims = 0;
   this->kernel_shape.nbDims = 0;
@@ -39,6 +42,7 @@ Weights::Weights(ConversionCtx* ctx, int32_t val) {
   this->data.values = buf;
   this->data.count = 1;
   ctx->builder_resources.push_back(buf);
+  ctx->TrackAllocation(this->data.count * sizeof(int32_t));
 
   this->shape.nbDims = 0;
   this->kernel_shape.nbDims = 0;
@@ -73,6 +77,15 @@ Weights::Weights(ConversionCtx* ctx, at::Tensor t) {
   }
   auto t_cpu = t.to(at::kCPU);
   t_cpu = t_cpu.contiguous();
+  if (t_cpu.scalar_type() == at::kLong) {
+    // TensorRT has no int64, narrow if the values fit
+    TRTORCH_CHECK(
+        t_cpu.numel() == 0 ||
+            (t_cpu.min().item<int64_t>() >= std::numeric_limits<int32_t>::min() &&
+             t_cpu.max().item<int64_t>() <= std::numeric_limits<int32_t>::max()),
+        "Unable to narrow int64 tensor to int32 for nvinfer1::Weights, values are out of range");
+    t_cpu = t_cpu.to(at::kInt);
+  }
   auto dtype_optional = util::toTRTDataType(t_cpu.dtype());
   if (!dtype_optional) {
     TRTORCH_THROW_ERROR("The tensor requested to be converted to nvinfer1::Weights is of an unsupported type");
@@ -82,6 +95,7 @@ Weights::Weights(ConversionCtx* ctx, at::Tensor t) {
   // complete
   void* buf = malloc(t_cpu.numel() * sizeof(float));
   ctx->builder_resources.push_back(buf);
+  ctx->TrackAllocation(t_cpu.numel() * sizeof(float));
   memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * sizeof(float));
 
   this->data.type = dtype_optional.value();
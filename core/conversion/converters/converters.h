@@ -39,6 +39,8 @@ class RegisterNodeConversionPatterns {
 
 bool node_is_convertable(const torch::jit::Node* n);
 OpConverter get_node_converter_for(const torch::jit::FunctionSchema* signature);
+// Returns nullptr if there is no converter for the node
+OpConverter find_node_converter_for(const torch::jit::Node* n);
 
 } // namespace converters
 } // namespace conversion
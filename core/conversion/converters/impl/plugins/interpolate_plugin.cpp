@@ -9,6 +9,16 @@ namespace converters {
 namespace impl {
 namespace plugins {
 
+namespace {
+bool cudaSucceeded(cudaError_t err, const char* action) {
+  if (err != cudaSuccess) {
+    LOG_ERROR("Interpolate plugin failed to " << action << ": " << cudaGetErrorString(err));
+    return false;
+  }
+  return true;
+}
+} // namespace
+
 /*
  * InterpolatePlugin class implementations
  */
@@ -93,8 +103,10 @@ nvinfer1::DimsExprs InterpolatePlugin::getOutputDimensions(
     nvinfer1::IExprBuilder& exprBuilder) {
   nvinfer1::DimsExprs output(inputs[0]);
 
-  for (unsigned int i = 0; i < out_shape_.size(); i++) {
-    output.d[i] = exprBuilder.constant(out_shape_[i]);
+  // Only the trailing dimensions are resized, the leading ones follow the input
+  // so that they may be dynamic
+  for (size_t i = 0; i < size_.size(); i++) {
+    output.d[output.nbDims - size_.size() + i] = exprBuilder.constant(size_[i]);
   }
 
   return output;
@@ -105,17 +117,37 @@ nvinfer1::DataType InterpolatePlugin::getOutputDataType(int index, const nvinfer
   return DataType::kFLOAT;
 }
 
-int InterpolatePlugin::initialize() {
-#if NV_TENSORRT_MAJOR < 7 || (NV_TENSORRT_MAJOR == 7 && NV_TENSORRT_MINOR < 1)
-  tensor_options_ = tensor_options_.device(c10::kCUDA);
-#else
-  tensor_options_ = tensor_options_.device(c10::kCPU);
-#endif
+InterpolatePlugin::~InterpolatePlugin() {
+  terminate();
+}
 
-  // c10::kFloat = FLOAT32
-  tensor_options_ = tensor_options_.dtype(c10::kFloat);
+bool InterpolatePlugin::createEvents() {
+  // Clones and deserialized plugins are not always initialized before they are
+  // enqueued, so the events are created by whichever comes first
+  if (!input_ready_ &&
+      !cudaSucceeded(cudaEventCreateWithFlags(&input_ready_, cudaEventDisableTiming), "create event")) {
+    return false;
+  }
+  if (!output_ready_ &&
+      !cudaSucceeded(cudaEventCreateWithFlags(&output_ready_, cudaEventDisableTiming), "create event")) {
+    return false;
+  }
+  return true;
+}
 
-  return 0;
+int InterpolatePlugin::initialize() {
+  return createEvents() ? 0 : 1;
+}
+
+void InterpolatePlugin::terminate() {
+  if (input_ready_) {
+    cudaEventDestroy(input_ready_);
+    input_ready_ = nullptr;
+  }
+  if (output_ready_) {
+    cudaEventDestroy(output_ready_);
+    output_ready_ = nullptr;
+  }
 }
 
 void InterpolatePlugin::serialize(void* buffer) const {
@@ -188,67 +220,52 @@ int InterpolatePlugin::enqueue(
     void* const* outputs,
     void* workspace,
     cudaStream_t stream) {
-#if NV_TENSORRT_MAJOR < 7 || (NV_TENSORRT_MAJOR == 7 && NV_TENSORRT_MINOR < 1)
-  at::Tensor input = at::from_blob((void*)inputs[0], util::toVec(inputDesc->dims), [](void*) {}, tensor_options_);
-  at::Tensor output = at::from_blob(outputs[0], util::volume(outputDesc->dims), [](void*) {}, tensor_options_);
-
-  at::cuda::CUDAStream torch_stream = at::cuda::getStreamFromPool();
-  at::cuda::CUDAStreamGuard torch_guard(torch_stream);
-
-  cudaEvent_t event;
-  cudaEventCreate(&event);
-  cudaEventRecord(event, stream);
-
-  cudaStreamWaitEvent(torch_stream.stream(), event, 0);
-
-  if (mode_ == "linear") {
-    at::upsample_linear1d_out(output, input, {size_[0]}, align_corners_);
-  } else if (mode_ == "bilinear") {
-    at::upsample_bilinear2d_out(output, input, {size_[0], size_[1]}, align_corners_);
-  } else if (mode_ == "trilinear") {
-    at::upsample_trilinear3d_out(output, input, {size_[0], size_[1], size_[2]}, align_corners_);
-  } else if (mode_ == "adaptive_pool2d") {
-    at::adaptive_avg_pool2d_out(output, input, {size_[0], size_[1]});
+  // The input and output bindings are wrapped in place and the ATen CUDA kernels
+  // run on a stream from the pool, ordered against TensorRT's stream with events,
+  // so nothing is copied to the host and the stream is never synchronized
+  int device;
+  if (!cudaSucceeded(cudaGetDevice(&device), "get the current device") || !createEvents()) {
+    return 1;
   }
-
-  cudaEvent_t torch_event;
-  cudaEventCreate(&torch_event);
-  cudaEventRecord(torch_event, torch_stream.stream());
-
-  cudaStreamWaitEvent(stream, torch_event, 0);
-
-  cudaEventDestroy(event);
-  cudaEventDestroy(torch_event);
-
-  return 0;
-#else
-  // TODO: When PyTorch updates to cuDNN 8 try moving back to CUDA based ATen
-  // kernels HACK: WAR because there is a segfault if you try to create a CUDA
-  // Tensor in the context of TensorRT execution
-  float* input_blob = (float*)malloc(util::volume(inputDesc->dims) * sizeof(float));
-  cudaMemcpyAsync(
-      input_blob,
-      static_cast<const void*>(inputs[0]),
-      util::volume(inputDesc->dims) * sizeof(float),
-      cudaMemcpyDeviceToHost,
-      stream);
-  cudaStreamSynchronize(stream);
-
-  at::Tensor input = at::from_blob((void*)input_blob, util::toVec(inputDesc->dims), tensor_options_);
-
-  at::Tensor output;
-  if (mode_ == "adaptive_pool2d") {
-    output = at::adaptive_avg_pool2d(input, {size_[0], size_[1]});
+  auto options = tensor_options_.device(c10::Device(c10::kCUDA, device));
+
+  // Exceptions cannot be thrown through TensorRT, failures are reported through
+  // the return code instead
+  try {
+    at::Tensor input = at::from_blob((void*)inputs[0], util::toVec(inputDesc->dims), [](void*) {}, options);
+    at::Tensor output = at::from_blob(outputs[0], util::toVec(outputDesc->dims), [](void*) {}, options);
+
+    at::cuda::CUDAStream torch_stream = at::cuda::getStreamFromPool(false, device);
+    at::cuda::CUDAStreamGuard torch_guard(torch_stream);
+
+    if (!cudaSucceeded(cudaEventRecord(input_ready_, stream), "record event") ||
+        !cudaSucceeded(cudaStreamWaitEvent(torch_stream.stream(), input_ready_, 0), "wait on event")) {
+      return 1;
+    }
+
+    if (mode_ == "linear") {
+      at::upsample_linear1d_out(output, input, {size_[0]}, align_corners_);
+    } else if (mode_ == "bilinear") {
+      at::upsample_bilinear2d_out(output, input, {size_[0], size_[1]}, align_corners_);
+    } else if (mode_ == "trilinear") {
+      at::upsample_trilinear3d_out(output, input, {size_[0], size_[1], size_[2]}, align_corners_);
+    } else if (mode_ == "adaptive_pool2d") {
+      at::adaptive_avg_pool2d_out(output, input, {size_[0], size_[1]});
+    } else {
+      LOG_ERROR("Interpolate plugin does not support mode " << mode_);
+      return 1;
+    }
+
+    if (!cudaSucceeded(cudaEventRecord(output_ready_, torch_stream.stream()), "record event") ||
+        !cudaSucceeded(cudaStreamWaitEvent(stream, output_ready_, 0), "wait on event")) {
+      return 1;
+    }
+  } catch (std::exception& e) {
+    LOG_ERROR("Interpolate plugin failed to run " << mode_ << ": " << e.what());
+    return 1;
   }
 
-  cudaMemcpyAsync(
-      outputs[0], output.data_ptr(), util::volume(outputDesc->dims) * sizeof(float), cudaMemcpyHostToDevice, stream);
-  cudaStreamSynchronize(stream);
-
-  free(input_blob);
-
   return 0;
-#endif
 }
 
 /*
@@ -25,8 +25,13 @@ namespace plugins {
 
 class InterpolatePlugin : public nvinfer1::IPluginV2DynamicExt {
  private:
-  at::TensorOptions tensor_options_;
+  // c10::kFloat = FLOAT32
+  at::TensorOptions tensor_options_ = at::TensorOptions().dtype(c10::kFloat);
   DataType dtype_;
+  // Order the ATen kernels after the work already on TensorRT's stream and the
+  // work enqueued after the plugin after the kernels, without blocking the host
+  cudaEvent_t input_ready_ = nullptr;
+  cudaEvent_t output_ready_ = nullptr;
 
   std::vector<int64_t> in_shape_;
   std::vector<int64_t> out_shape_;
@@ -34,6 +39,9 @@ class InterpolatePlugin : public nvinfer1::IPluginV2DynamicExt {
   std::string mode_;
   bool align_corners_;
 
+  // Creates the events if they do not exist yet, returns false on failure
+  bool createEvents();
+
  protected:
   // To prevent compiler warnings
   using nvinfer1::IPluginV2DynamicExt::canBroadcastInputAcrossBatch;
@@ -56,6 +64,8 @@ class InterpolatePlugin : public nvinfer1::IPluginV2DynamicExt {
 
   InterpolatePlugin() = delete;
 
+  ~InterpolatePlugin();
+
   std::vector<int64_t> getInputShape();
 
   std::vector<int64_t> getOutputShape();
@@ -84,7 +94,7 @@ class InterpolatePlugin : public nvinfer1::IPluginV2DynamicExt {
 
   int initialize() override;
 
-  void terminate() override {}
+  void terminate() override;
 
   void serialize(void* buffer) const;
 
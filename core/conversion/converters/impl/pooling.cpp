@@ -1,3 +1,4 @@
+#include <bitset>
 #include "core/conversion/converters/converters.h"
 #include "core/util/prelude.h"
 #include "plugins/interpolate_plugin.h"
@@ -303,14 +304,34 @@ auto pooling_registrations TRTORCH_UNUSED =
                // auto out_size = args[1].IValue()->toIntList();
                auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
 
-               if (ctx->input_is_dynamic) {
-#if NV_TENSORRT_MAJOR < 7 || (NV_TENSORRT_MAJOR == 7 && NV_TENSORRT_MINOR < 1)
-                 LOG_WARNING(
-                     "Adaptive pooling layer will be run through ATen, via not TensorRT, performace will be lower than expected. Consider switching either to static input shape or moving to non adaptive pooling if this is an issue");
-#else
+               // The native pooling layer only matches adaptive pooling when the windows are all the same size, i.e.
+               // the pooled dimensions are known when building and are multiples of the output size
+               bool uniform_windows = true;
+               bool global = true;
+               for (size_t i = 0; i < out_size.size(); i++) {
+                 auto in_dim = in_shape[in_shape.size() - out_size.size() + i];
+                 uniform_windows = uniform_windows && in_dim > 0 && in_dim % out_size[i] == 0;
+                 global = global && out_size[i] == 1;
+               }
+
+               if (global) {
+                 // Averaging the whole of the pooled dimensions does not depend on their size
+                 uint32_t axes_mask = 0;
+                 for (size_t i = 0; i < out_size.size(); i++) {
+                   axes_mask |= 1 << (in_shape.size() - out_size.size() + i);
+                 }
+                 LOG_DEBUG("Reduce axes mask: " << std::bitset<32>(axes_mask));
+
+                 auto reduce_layer = ctx->net->addReduce(*in, nvinfer1::ReduceOperation::kAVG, axes_mask, true);
+                 TRTORCH_CHECK(reduce_layer, "Unable to create pooling (reduce) layer from node: " << *n);
+
+                 reduce_layer->setName(util::node_info(n).c_str());
+                 auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], reduce_layer->getOutput(0));
+
+                 LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+               } else if (!uniform_windows) {
                  LOG_WARNING(
-                     "Adaptive pooling layer will be run through ATen (on CPU), via not TensorRT, performace will suffer. Consider switching either to static input shape or moving to non adaptive pooling");
-#endif
+                     "Adaptive pooling layer will be run through ATen (on the GPU), not TensorRT, since the size of its input is not known when building or is not a multiple of the output size. Consider switching either to static input shape or moving to non adaptive pooling if this is an issue");
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
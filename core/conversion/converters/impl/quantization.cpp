@@ -0,0 +1,51 @@
+#include "core/conversion/converters/converters.h"
+#include "core/util/prelude.h"
+
+namespace trtorch {
+namespace core {
+namespace conversion {
+namespace converters {
+namespace impl {
+namespace {
+
+// The range a quantization aware trained model fake quantized a tensor to is
+// set as its dynamic range, so INT8 engines can be built from these models
+// without calibration. The output is the input tensor itself
+bool add_dynamic_range(ConversionCtx* ctx, const torch::jit::Node* n, nvinfer1::ITensor* in, double min, double max) {
+  TRTORCH_CHECK(
+      in->setDynamicRange(static_cast<float>(min), static_cast<float>(max)),
+      "Unable to set dynamic range [" << min << ", " << max << "] for node: " << *n);
+  ctx->num_dynamic_ranges++;
+  // Not associated through AssociateValueAndTensor since that renames the
+  // tensor, which may be an input of the engine
+  ctx->value_tensor_map[n->outputs()[0]] = in;
+  LOG_DEBUG("Dynamic range of " << in->getName() << " set to [" << min << ", " << max << "]");
+  return true;
+}
+
+auto quantization_registrations TRTORCH_UNUSED =
+    RegisterNodeConversionPatterns()
+        .pattern({"trt::dynamic_range(Tensor self, float min, float max) -> (Tensor)",
+                  [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+                    auto in = args[0].ITensorOrFreeze(ctx);
+                    return add_dynamic_range(ctx, n, in, args[1].unwrapToDouble(), args[2].unwrapToDouble());
+                  }})
+        .pattern({"aten::fake_quantize_per_tensor_affine(Tensor self, float scale, int zero_point, int quant_min, int quant_max) -> (Tensor)",
+                  [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+                    // Only reached when the quantization parameters are not
+                    // constants during lowering (see LowerFakeQuantize)
+                    auto in = args[0].ITensorOrFreeze(ctx);
+                    auto scale = args[1].unwrapToDouble();
+                    auto zero_point = args[2].unwrapToInt();
+                    auto quant_min = args[3].unwrapToInt();
+                    auto quant_max = args[4].unwrapToInt();
+                    return add_dynamic_range(
+                        ctx, n, in, (quant_min - zero_point) * scale, (quant_max - zero_point) * scale);
+                  }});
+
+} // namespace
+} // namespace impl
+} // namespace converters
+} // namespace conversion
+} // namespace core
+} // namespace trtorch
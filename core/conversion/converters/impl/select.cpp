@@ -144,6 +144,8 @@ auto select_registrations TRTORCH_UNUSED =
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
                auto in = args[0].ITensor();
                auto axis = args[1].unwrapToInt();
+               // Handle case when given axis is negative
+               axis = axis < 0 ? axis + in->getDimensions().nbDims : axis;
                auto maxDim = static_cast<int64_t>(in->getDimensions().d[axis]);
                // Handle case when given tensor index is negative
                auto startIdx = args[2].unwrapToInt();
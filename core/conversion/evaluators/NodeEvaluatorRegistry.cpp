@@ -1,9 +1,11 @@
+#include <mutex>
 #include <unordered_map>
 
 #include "ATen/core/List.h"
 #include "ATen/core/functional.h"
 #include "ATen/core/ivalue.h"
 #include "ATen/core/stack.h"
+#include "torch/csrc/jit/frontend/function_schema_parser.h"
 #include "torch/csrc/jit/ir/constants.h"
 #include "torch/csrc/jit/ir/ir.h"
 
@@ -17,18 +19,10 @@ namespace evaluators {
 namespace {
 using EvaluatorLUT = std::unordered_map<torch::jit::NodeKind, EvalRegistration>;
 
-bool FindInVec(std::vector<c10::OperatorName>& names, c10::OperatorName target) {
-  for (auto n : names) {
-    if (n == target) {
-      return true;
-    }
-  }
-  return false;
-}
-
 class NodeEvaluatorRegistry {
  public:
   void RegisterEvaluator(torch::jit::NodeKind node_kind, EvalRegistration eval_reg) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
     LOG_DEBUG("Registering evaluator for " << node_kind.toQualString());
     auto iter = evaluator_lut_.find(node_kind);
     if (iter != evaluator_lut_.end()) {
@@ -36,16 +30,19 @@ class NodeEvaluatorRegistry {
           "Attempting to override already registered evaluator " << node_kind.toQualString()
                                                                  << ", merge implementations instead");
     }
+    has_unparsed_schemas_ |= eval_reg.options.unparsed_valid_schemas.size() != 0;
     evaluator_lut_[node_kind] = std::move(eval_reg);
   }
 
   NodeEvaluator FindEvaluator(const torch::jit::Node* n) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    ParseValidSchemas();
     auto node_kind = n->kind();
     auto iter = evaluator_lut_.find(node_kind);
     if (iter == evaluator_lut_.end()) {
       return nullptr;
     }
-    auto eval_reg = iter->second;
+    auto& eval_reg = iter->second;
     if (eval_reg.options.use()) {
       for (auto o : n->outputs()) {
         if (eval_reg.options.blacklisted_output_types.find(o->type()) !=
@@ -60,7 +57,7 @@ class NodeEvaluatorRegistry {
             schema,
             "Evaluator for " << node_kind.toQualString()
                              << "only runs on certain schemas, but schema for node is not retrievable");
-        if (!FindInVec(eval_reg.options.valid_schemas, schema->operator_name())) {
+        if (eval_reg.options.valid_schemas.find(schema->operator_name()) == eval_reg.options.valid_schemas.end()) {
           return nullptr;
         }
       }
@@ -86,7 +83,39 @@ class NodeEvaluatorRegistry {
   }
 
  private:
+  // Schemas restricting evaluators are parsed on first lookup so processes
+  // which just run compiled modules do not pay for it on load. Expects
+  // registry_mutex_ to be held
+  void ParseValidSchemas() {
+    if (!has_unparsed_schemas_) {
+      return;
+    }
+    // Parsed into a separate table first so a bad schema leaves the registry
+    // as it was
+    std::unordered_map<torch::jit::NodeKind, std::vector<c10::OperatorName>> parsed;
+    for (auto& e : evaluator_lut_) {
+      for (auto& s : e.second.options.unparsed_valid_schemas) {
+        try {
+          parsed[e.first].push_back(torch::jit::parseSchema(s).operator_name());
+        } catch (const std::exception& ex) {
+          TRTORCH_THROW_ERROR("Unable to parse schema of evaluator " << s << ": " << ex.what());
+        }
+      }
+    }
+    for (auto& e : evaluator_lut_) {
+      auto& options = e.second.options;
+      auto names = parsed.find(e.first);
+      if (names != parsed.end()) {
+        options.valid_schemas.insert(names->second.begin(), names->second.end());
+      }
+      options.unparsed_valid_schemas.clear();
+    }
+    has_unparsed_schemas_ = false;
+  }
+
   EvaluatorLUT evaluator_lut_;
+  bool has_unparsed_schemas_ = false;
+  std::mutex registry_mutex_;
 };
 
 NodeEvaluatorRegistry& get_evaluator_registry() {
@@ -99,6 +128,10 @@ bool shouldEvalAtConversionTime(const torch::jit::Node* n) {
   return get_evaluator_registry().EvalAtConversionTime(n);
 }
 
+NodeEvaluator find_node_evaluator_for(const torch::jit::Node* n) {
+  return get_evaluator_registry().FindEvaluator(n);
+}
+
 c10::optional<torch::jit::IValue> EvalNode(const torch::jit::Node* n, kwargs& args) {
   auto evaluator = get_evaluator_registry().GetEvaluator(n);
   return evaluator(n, args);
@@ -3,6 +3,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_set>
 
 #include "torch/csrc/jit/ir/ir.h"
 
@@ -37,7 +38,10 @@ typedef std::function<c10::optional<torch::jit::IValue>(const torch::jit::Node*,
 
 struct EvalOptions {
   std::set<c10::TypePtr> blacklisted_output_types;
-  std::vector<c10::OperatorName> valid_schemas;
+  std::unordered_set<c10::OperatorName> valid_schemas;
+  // Schemas are kept as strings until the evaluator is first looked up, see
+  // NodeEvaluatorRegistry
+  std::vector<std::string> unparsed_valid_schemas;
   EvalOptions() = default;
   EvalOptions& blacklistOutputTypes(std::set<c10::TypePtr> types) {
     use_options = true;
@@ -46,9 +50,7 @@ struct EvalOptions {
   }
   EvalOptions& validSchemas(std::set<std::string> schemas) {
     use_options = true;
-    for (auto s : schemas) {
-      valid_schemas.push_back(torch::jit::parseSchema(s).operator_name());
-    }
+    unparsed_valid_schemas.insert(unparsed_valid_schemas.end(), schemas.begin(), schemas.end());
     return *this;
   }
   bool use() {
@@ -72,6 +74,8 @@ struct EvalRegistration {
 
 c10::optional<torch::jit::IValue> EvalNode(const torch::jit::Node* n, kwargs& args);
 bool shouldEvalAtConversionTime(const torch::jit::Node* n);
+// Returns nullptr if there is no evaluator for the node
+NodeEvaluator find_node_evaluator_for(const torch::jit::Node* n);
 void register_node_evaluator(torch::jit::NodeKind node_kind, NodeEvaluator evaluator);
 void register_node_evaluator(EvalRegistration r);
 
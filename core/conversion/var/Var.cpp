@@ -1,3 +1,4 @@
+#include <cstring>
 #include <sstream>
 
 #include "core/conversion/var/Var.h"
@@ -85,6 +86,39 @@ std::string Var::type_name() const {
   }
 }
 
+namespace {
+// Tensors larger than this are only deduplicated by identity
+const size_t kMaxContentDedupBytes = 64 * 1024;
+
+// FNV-1a over the tensor bytes, only used to find candidates which are then
+// compared in full
+size_t hashTensorContents(const at::Tensor& t_cpu) {
+  uint64_t hash = 14695981039346656037ULL;
+  auto bytes = static_cast<const uint8_t*>(t_cpu.data_ptr());
+  for (size_t i = 0; i < t_cpu.nbytes(); i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  hash ^= static_cast<uint64_t>(t_cpu.scalar_type());
+  for (auto s : t_cpu.sizes()) {
+    hash = hash * 31 + s;
+  }
+  return static_cast<size_t>(hash);
+}
+
+nvinfer1::ITensor* findFrozenTensor(ConversionCtx* ctx, const at::Tensor& t_cpu, size_t hash) {
+  auto candidates = ctx->frozen_tensor_map.equal_range(hash);
+  for (auto it = candidates.first; it != candidates.second; it++) {
+    auto& frozen = it->second;
+    if (frozen.dtype == t_cpu.scalar_type() && frozen.sizes == t_cpu.sizes().vec() &&
+        frozen.nbytes == t_cpu.nbytes() && memcmp(frozen.data, t_cpu.data_ptr(), frozen.nbytes) == 0) {
+      return frozen.tensor;
+    }
+  }
+  return nullptr;
+}
+} // namespace
+
 nvinfer1::ITensor* Var::ITensorOrFreeze(ConversionCtx* ctx) {
   if (isIValue()) {
     LOG_DEBUG(ctx->logger, "Found IValue containing object of type " << *(ptr_.ivalue->type()));
@@ -96,18 +130,49 @@ nvinfer1::ITensor* Var::ITensorOrFreeze(ConversionCtx* ctx) {
   nvinfer1::ITensor* out;
 
   if (isIValue()) {
-    auto weights = converters::Weights(ctx, ptr_.ivalue->toTensor());
-
-    auto const_layer = ctx->net->addConstant(weights.shape, weights.data);
-    TRTORCH_CHECK(const_layer, "Unable to freeze tensor into constant layer");
-
-    out = const_layer->getOutput(0);
-
-    std::ostringstream tensor_id;
-    tensor_id << reinterpret_cast<int*>(out);
-
-    LOG_DEBUG(ctx->logger, "Freezing tensor " << tensor_id.str() << " as an IConstantLayer");
-    const_layer->setName(("[Freeze Tensor " + tensor_id.str() + " ]").c_str());
+    auto t = ptr_.ivalue->toTensor();
+
+    // The same tensor (e.g. a weight shared by several nodes) frozen again
+    auto frozen_impl = ctx->frozen_impl_map.find(t.unsafeGetTensorImpl());
+    if (frozen_impl != ctx->frozen_impl_map.end()) {
+      LOG_DEBUG(ctx->logger, "Reusing frozen tensor for already frozen value");
+      ctx->num_reused_frozen_tensors++;
+      return frozen_impl->second.second;
+    }
+
+    // A different tensor with the same contents (e.g. a broadcast scalar).
+    // int64 tensors are narrowed when building weights, so the weights copy
+    // cannot be compared against the source bytes. Large tensors are not
+    // hashed, equal copies of them are rare and hashing them is slow
+    auto t_cpu = t.to(at::kCPU).contiguous();
+    bool dedup_by_content = t_cpu.scalar_type() != at::kLong && t_cpu.nbytes() <= kMaxContentDedupBytes;
+    size_t hash = dedup_by_content ? hashTensorContents(t_cpu) : 0;
+    out = dedup_by_content ? findFrozenTensor(ctx, t_cpu, hash) : nullptr;
+    if (out) {
+      LOG_DEBUG(ctx->logger, "Reusing frozen tensor with identical contents");
+      ctx->num_reused_frozen_tensors++;
+    } else {
+      auto weights = converters::Weights(ctx, t_cpu);
+
+      auto const_layer = ctx->net->addConstant(weights.shape, weights.data);
+      TRTORCH_CHECK(const_layer, "Unable to freeze tensor into constant layer");
+
+      out = const_layer->getOutput(0);
+
+      std::ostringstream tensor_id;
+      tensor_id << reinterpret_cast<int*>(out);
+
+      LOG_DEBUG(ctx->logger, "Freezing tensor " << tensor_id.str() << " as an IConstantLayer");
+      const_layer->setName(("[Freeze Tensor " + tensor_id.str() + " ]").c_str());
+
+      if (dedup_by_content) {
+        ctx->frozen_tensor_map.emplace(
+            hash, FrozenTensor{t_cpu.scalar_type(), t_cpu.sizes().vec(), weights.data.values, t_cpu.nbytes(), out});
+      }
+    }
+    ctx->frozen_impl_map.emplace(
+        t.unsafeGetTensorImpl(),
+        std::make_pair(c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>(t.getIntrusivePtr()), out));
   } else {
     out = ptr_.tensor;
   }
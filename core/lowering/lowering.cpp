@@ -24,58 +24,126 @@ void LowerBlock(torch::jit::Block* b) {
   DropUnusedNodes(b);
 }
 
+// Each pass gets its own span in the trace of the compilation
+#define TRACE_PASS(pass)                    \
+  {                                         \
+    TRTORCH_TRACE_SCOPE(#pass, "lowering"); \
+    pass;                                   \
+  }
+
 void LowerGraph(std::shared_ptr<torch::jit::Graph>& g) {
-  torch::jit::EliminateRedundantGuards(g);
-  torch::jit::RemoveListMutation(g);
-  torch::jit::RemoveTensorMutation(g);
-  torch::jit::CreateFunctionalGraphs(g);
-  torch::jit::InlineFunctionalGraphs(g);
-  torch::jit::PeepholeOptimize(g, false);
-  passes::EliminateExceptionOrPassPattern(g);
-  torch::jit::FuseLinear(g);
-  torch::jit::LowerAllTuples(g);
-  passes::RemoveContiguous(g);
-  passes::RemoveDropout(g);
-  passes::FuseFlattenLinear(g);
-  passes::Conv2DToConvolution(g);
-  passes::Conv3DToConvolution(g);
-  passes::FuseAddMMBranches(g);
-  torch::jit::EliminateCommonSubexpression(g);
+  TRTORCH_TRACE_SCOPE("LowerGraph", "lowering");
+  TRACE_PASS(torch::jit::EliminateRedundantGuards(g));
+  TRACE_PASS(torch::jit::RemoveListMutation(g));
+  TRACE_PASS(torch::jit::RemoveTensorMutation(g));
+  TRACE_PASS(torch::jit::CreateFunctionalGraphs(g));
+  TRACE_PASS(torch::jit::InlineFunctionalGraphs(g));
+  TRACE_PASS(torch::jit::PeepholeOptimize(g, false));
+  TRACE_PASS(passes::EliminateExceptionOrPassPattern(g));
+  TRACE_PASS(passes::LowerFakeQuantize(g));
+  TRACE_PASS(torch::jit::FuseLinear(g));
+  TRACE_PASS(torch::jit::LowerAllTuples(g));
+  TRACE_PASS(passes::RemoveContiguous(g));
+  TRACE_PASS(passes::RemoveDropout(g));
+  TRACE_PASS(passes::FuseFlattenLinear(g));
+  TRACE_PASS(passes::Conv2DToConvolution(g));
+  TRACE_PASS(passes::Conv3DToConvolution(g));
+  TRACE_PASS(passes::FuseAddMMBranches(g));
+  TRACE_PASS(passes::FoldBatchNorm(g));
+  TRACE_PASS(passes::FuseSiblingBranches(g));
+  TRACE_PASS(torch::jit::EliminateCommonSubexpression(g));
   // torch::jit::UnrollLoops(g);
-  torch::jit::EliminateCommonSubexpression(g);
-  passes::UnpackAddMM(g);
+  TRACE_PASS(torch::jit::EliminateCommonSubexpression(g));
+  TRACE_PASS(passes::UnpackAddMM(g));
   // passes::UnpackBatchNorm(g);
-  passes::UnpackLogSoftmax(g);
-  passes::RemoveTo(g);
-  torch::jit::EliminateDeadCode(g);
+  TRACE_PASS(passes::UnpackLogSoftmax(g));
+  TRACE_PASS(passes::RemoveTo(g));
+  TRACE_PASS(passes::EliminateRedundantShuffles(g));
+  TRACE_PASS(passes::FoldConstantSubgraphs(g));
+  TRACE_PASS(passes::NarrowInt64ToInt32(g));
+  TRACE_PASS(torch::jit::EliminateDeadCode(g));
   LOG_GRAPH(*g);
 }
 
 torch::jit::Module LowerModule(const torch::jit::script::Module& mod) {
+  TRTORCH_TRACE_SCOPE("freeze_module", "lowering");
   auto mod_ = torch::jit::freeze_module(mod);
   return mod_;
 }
 
-std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> Lower(
-    const torch::jit::script::Module& mod,
-    std::string method_name) {
-  auto lowered_mod = LowerModule(mod);
-  auto g = lowered_mod.get_method(method_name).graph();
-  LOG_GRAPH(*g);
+LoweringCache::LoweringCache(const torch::jit::script::Module& mod) : frozen_mod(LowerModule(mod)) {}
 
-  // Go through TRTorch Lowering to reformat graph to be conversion friendly
-  // and also segment for accelerators and executors (TRT-DLA, TRT-GPU, PYT)
-  LOG_GRAPH("TRTorch Graph Lowering");
-  lowering::LowerGraph(g);
-  //=[torch::jit::FoldConvBatchNorm2d(lowered_mod);
-  LOG_GRAPH("LibTorch Lowering");
-  auto graph_and_ivalues = torch::jit::LowerGraph(*g, lowered_mod._ivalue());
-  // Is this necessary?
-  lowering::LowerBlock(g->block());
+std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> LoweringCache::Lower(
+    std::string method_name,
+    const std::vector<passes::InputShapeRange>& input_shapes) {
+  TRTORCH_CHECK(
+      released_methods.find(method_name) == released_methods.end(),
+      "Method " << method_name << " was already released from the lowering cache");
+  auto lowered_method = lowered_methods.find(method_name);
+  if (lowered_method == lowered_methods.end()) {
+    auto g = frozen_mod.get_method(method_name).graph();
+    LOG_GRAPH(*g);
+
+    // Go through TRTorch Lowering to reformat graph to be conversion friendly
+    // and also segment for accelerators and executors (TRT-DLA, TRT-GPU, PYT)
+    LOG_GRAPH("TRTorch Graph Lowering");
+    lowering::LowerGraph(g);
+    LOG_GRAPH("LibTorch Lowering");
+    auto graph_and_ivalues = [&]() {
+      TRTORCH_TRACE_SCOPE("torch::jit::LowerGraph", "lowering");
+      return torch::jit::LowerGraph(*g, frozen_mod._ivalue());
+    }();
+    // Is this necessary?
+    lowering::LowerBlock(g->block());
+
+    lowered_method = lowered_methods.emplace(method_name, std::move(graph_and_ivalues)).first;
+  } else {
+    LOG_DEBUG("Reusing lowered graph for method " << method_name);
+  }
+
+  auto graph_and_ivalues = lowered_method->second;
+  if (input_shapes.size() > 0) {
+    // Inputs to the lowered graph are the method arguments followed by the
+    // extracted parameters, so the input shapes line up with the first inputs.
+    // Specialization is done on a copy so the cached graph stays generic
+    LOG_GRAPH("Input Shape Specialization");
+    graph_and_ivalues.first = graph_and_ivalues.first->copy();
+    TRACE_PASS(passes::SpecializeInputShapes(graph_and_ivalues.first, input_shapes));
+    // Identity reshapes can only be recognized once the sizes of their inputs
+    // are known, which is mostly the case after specialization
+    TRACE_PASS(passes::EliminateRedundantShuffles(graph_and_ivalues.first));
+  }
 
   return graph_and_ivalues;
 }
 
+void LoweringCache::Release(std::string method_name) {
+  lowered_methods.erase(method_name);
+  // The frozen method was lowered in place and shares the frozen weights with
+  // the lowered graph, so its body has to go as well for them to be freed
+  auto g = frozen_mod.get_method(method_name).graph();
+  g->block()->return_node()->removeAllInputs();
+  torch::jit::EliminateDeadCode(g);
+  released_methods.insert(method_name);
+  LOG_DEBUG("Released lowered graph and params of method " << method_name);
+}
+
+const torch::jit::Module& LoweringCache::FrozenModule() const {
+  TRTORCH_CHECK(
+      released_methods.empty(),
+      "The frozen module is not available once methods (" << *released_methods.begin()
+                                                           << ") have been released from the lowering cache");
+  return frozen_mod;
+}
+
+std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> Lower(
+    const torch::jit::script::Module& mod,
+    std::string method_name,
+    const std::vector<passes::InputShapeRange>& input_shapes) {
+  LoweringCache lowering_cache(mod);
+  return lowering_cache.Lower(method_name, input_shapes);
+}
+
 } // namespace lowering
 } // namespace core
 } // namespace trtorch
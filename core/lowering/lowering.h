@@ -1,7 +1,13 @@
 #pragma once
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "torch/csrc/jit/api/module.h"
 #include "torch/csrc/jit/ir/ir.h"
 
+#include "core/lowering/passes/passes.h"
+
 namespace trtorch {
 namespace core {
 namespace lowering {
@@ -9,9 +15,36 @@ namespace lowering {
 void LowerBlock(torch::jit::Block* b);
 void LowerGraph(std::shared_ptr<torch::jit::Graph>& g);
 torch::jit::Module LowerModule(const torch::jit::script::Module& mod);
+
+// Freezes a module once and lowers each of its methods at most once, so that
+// support checks, conversion and backend preprocessing in a single compile
+// share the work
+struct LoweringCache {
+  LoweringCache(const torch::jit::script::Module& mod);
+  std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> Lower(
+      std::string method_name,
+      const std::vector<passes::InputShapeRange>& input_shapes = {});
+  // Drops the lowered graph and params of a method along with the body of the
+  // method in the frozen module, which hold the frozen weights as constants.
+  // Called once the engine for the method is built, the method cannot be
+  // lowered again
+  void Release(std::string method_name);
+  // The frozen module, methods of which have TRTorch lowering applied once
+  // they have been requested through Lower. Not available once a method has
+  // been released since that method no longer has a body
+  const torch::jit::Module& FrozenModule() const;
+
+ private:
+  torch::jit::Module frozen_mod;
+  std::unordered_map<std::string, std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>>>
+      lowered_methods;
+  std::unordered_set<std::string> released_methods;
+};
+
 std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> Lower(
     const torch::jit::script::Module& mod,
-    std::string method_name);
+    std::string method_name,
+    const std::vector<passes::InputShapeRange>& input_shapes = {});
 
 } // namespace lowering
 } // namespace core
@@ -0,0 +1,248 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/util/prelude.h"
+
+#include <vector>
+
+namespace trtorch {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+struct RedundantShuffleElimination {
+  RedundantShuffleElimination(std::shared_ptr<Graph> graph) : graph_(std::move(graph)) {}
+
+  void run() {
+    auto num_before = countShuffleNodes(graph_->block());
+    eliminateShuffles(graph_->block());
+    torch::jit::EliminateDeadCode(graph_);
+    auto num_after = countShuffleNodes(graph_->block());
+    LOG_DEBUG(
+        "EliminateRedundantShuffles - Removed " << num_before - num_after << " of " << num_before
+                                                << " permute / reshape nodes");
+    LOG_GRAPH("Post redundant shuffle elimination: " << *graph_);
+  }
+
+ private:
+  bool isShuffleNode(Node* n) {
+    return n->kind() == aten::permute || n->kind() == aten::transpose || n->kind() == aten::reshape ||
+        n->kind() == aten::view || n->kind() == aten::flatten;
+  }
+
+  bool isReshapeNode(Node* n) {
+    return n->kind() == aten::reshape || n->kind() == aten::view;
+  }
+
+  int64_t countShuffleNodes(Block* b) {
+    int64_t count = 0;
+    for (auto n : b->nodes()) {
+      if (isShuffleNode(n)) {
+        count++;
+      }
+      for (auto sub_b : n->blocks()) {
+        count += countShuffleNodes(sub_b);
+      }
+    }
+    return count;
+  }
+
+  c10::optional<std::vector<int64_t>> constIntList(Value* v) {
+    if (v->node()->kind() == prim::ListConstruct) {
+      std::vector<int64_t> list;
+      for (auto i : v->node()->inputs()) {
+        auto ivalue = toIValue(i);
+        if (!ivalue || !ivalue->isInt()) {
+          return {};
+        }
+        list.push_back(ivalue->toInt());
+      }
+      return list;
+    }
+
+    auto ivalue = toIValue(v);
+    if (!ivalue || !ivalue->isIntList()) {
+      return {};
+    }
+    return ivalue->toIntVector();
+  }
+
+  c10::optional<int64_t> staticRank(Value* v) {
+    // The rank is also known if the value is produced by a permute
+    if (v->node()->kind() == aten::permute) {
+      auto perm = constIntList(v->node()->input(1));
+      if (perm) {
+        return perm->size();
+      }
+    }
+
+    auto t = v->type()->cast<c10::TensorType>();
+    if (!t) {
+      return {};
+    }
+    return t->dim();
+  }
+
+  c10::optional<std::vector<int64_t>> staticSizes(Value* v) {
+    auto t = v->type()->cast<c10::TensorType>();
+    if (!t) {
+      return {};
+    }
+    return t->sizes().concrete_sizes();
+  }
+
+  c10::optional<std::vector<int64_t>> normalizedPermutation(Node* n) {
+    auto in = n->input(0);
+    if (n->kind() == aten::transpose) {
+      auto rank = staticRank(in);
+      auto dim0 = toIValue(n->input(1));
+      auto dim1 = toIValue(n->input(2));
+      if (!rank || !dim0 || !dim1) {
+        return {};
+      }
+      std::vector<int64_t> perm(*rank);
+      for (int64_t i = 0; i < *rank; i++) {
+        perm[i] = i;
+      }
+      auto d0 = dim0->toInt() < 0 ? dim0->toInt() + *rank : dim0->toInt();
+      auto d1 = dim1->toInt() < 0 ? dim1->toInt() + *rank : dim1->toInt();
+      if (d0 < 0 || d0 >= *rank || d1 < 0 || d1 >= *rank) {
+        return {};
+      }
+      std::swap(perm[d0], perm[d1]);
+      return perm;
+    }
+
+    auto perm = constIntList(n->input(1));
+    if (!perm) {
+      return {};
+    }
+    int64_t rank = perm->size();
+    for (auto& p : *perm) {
+      p = p < 0 ? p + rank : p;
+      if (p < 0 || p >= rank) {
+        return {};
+      }
+    }
+    return perm;
+  }
+
+  bool isIdentity(const std::vector<int64_t>& perm) {
+    for (size_t i = 0; i < perm.size(); i++) {
+      if (perm[i] != static_cast<int64_t>(i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Node* replaceWithPermute(Node* n, Value* in, const std::vector<int64_t>& perm) {
+    WithInsertPoint guard(n);
+    auto perm_const = graph_->insertConstant(perm);
+    auto permute = graph_->create(aten::permute, {in, perm_const}, 1);
+    permute->insertBefore(n);
+    permute->output()->setType(n->output()->type());
+    n->output()->replaceAllUsesWith(permute->output());
+    return permute;
+  }
+
+  // permute(permute(x, p1), p2) -> permute(x, p1[p2]), transposes on inputs
+  // of known rank are treated as permutations
+  bool simplifyPermute(Node* n) {
+    auto perm = normalizedPermutation(n);
+    if (!perm) {
+      return false;
+    }
+
+    auto in = n->input(0);
+    auto producer = in->node();
+    if (producer->kind() == aten::permute || producer->kind() == aten::transpose) {
+      auto producer_perm = normalizedPermutation(producer);
+      if (producer_perm && producer_perm->size() == perm->size()) {
+        std::vector<int64_t> composed(perm->size());
+        for (size_t i = 0; i < perm->size(); i++) {
+          composed[i] = (*producer_perm)[(*perm)[i]];
+        }
+        perm = composed;
+        in = producer->input(0);
+      }
+    }
+
+    if (isIdentity(*perm)) {
+      LOG_GRAPH("Found that node " << *n << " is an identity permutation (EliminateRedundantShuffles)" << std::endl);
+      n->output()->replaceAllUsesWith(in);
+      return true;
+    }
+
+    if (in != n->input(0) || n->kind() == aten::transpose) {
+      LOG_GRAPH("Composing node " << *n << " with its input permutation (EliminateRedundantShuffles)" << std::endl);
+      replaceWithPermute(n, in, *perm);
+      return true;
+    }
+    return false;
+  }
+
+  // reshape(reshape(x, s1), s2) -> reshape(x, s2), the same goes for views
+  // and flattens feeding a reshape. Reshapes to the static shape of the input
+  // are removed entirely
+  bool simplifyReshape(Node* n) {
+    auto in = n->input(0);
+    auto producer = in->node();
+    if (isReshapeNode(producer) || producer->kind() == aten::flatten) {
+      in = producer->input(0);
+    }
+
+    auto in_sizes = staticSizes(in);
+    auto target = constIntList(n->input(1));
+    if (in_sizes && target && *in_sizes == *target) {
+      LOG_GRAPH("Found that node " << *n << " is an identity reshape (EliminateRedundantShuffles)" << std::endl);
+      n->output()->replaceAllUsesWith(in);
+      return true;
+    }
+
+    if (in == n->input(0)) {
+      return false;
+    }
+
+    LOG_GRAPH("Merging node " << *n << " with its input reshape (EliminateRedundantShuffles)" << std::endl);
+    auto reshape = graph_->create(aten::reshape, {in, n->input(1)}, 1);
+    reshape->insertBefore(n);
+    reshape->output()->setType(n->output()->type());
+    n->output()->replaceAllUsesWith(reshape->output());
+    return true;
+  }
+
+  void eliminateShuffles(Block* b) {
+    for (auto it = b->nodes().begin(); it != b->nodes().end(); it++) {
+      auto n = *it;
+      for (auto sub_b : n->blocks()) {
+        eliminateShuffles(sub_b);
+      }
+
+      bool replaced = false;
+      if (n->kind() == aten::permute || n->kind() == aten::transpose) {
+        replaced = simplifyPermute(n);
+      } else if (isReshapeNode(n)) {
+        replaced = simplifyReshape(n);
+      }
+
+      if (replaced) {
+        it.destroyCurrent();
+      }
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+};
+} // namespace
+
+void EliminateRedundantShuffles(std::shared_ptr<Graph>& graph) {
+  RedundantShuffleElimination rse(graph);
+  rse.run();
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace trtorch
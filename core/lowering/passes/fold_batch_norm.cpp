@@ -0,0 +1,173 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/util/prelude.h"
+
+#include <vector>
+
+namespace trtorch {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+struct BatchNormFolding {
+  BatchNormFolding(std::shared_ptr<Graph> graph) : graph_(std::move(graph)) {}
+
+  void run() {
+    findBatchNormNodes(graph_->block());
+    torch::jit::EliminateDeadCode(graph_);
+    LOG_DEBUG("FoldBatchNorm - Folded " << num_folded_ << " batch norms into preceding convolution or linear layers");
+    LOG_GRAPH("Post batch norm folding: " << *graph_);
+  }
+
+ private:
+  // Returns true if v is a constant that is either a tensor or None, in the
+  // case of None t is left undefined
+  bool getConstTensor(Value* v, at::Tensor& t) {
+    if (v->node()->kind() != prim::Constant) {
+      return false;
+    }
+    auto ivalue = toIValue(v);
+    if (!ivalue) {
+      return false;
+    }
+    if (ivalue->isNone()) {
+      t = at::Tensor();
+      return true;
+    } else if (ivalue->isTensor()) {
+      t = ivalue->toTensor();
+      return true;
+    }
+    return false;
+  }
+
+  bool isFoldableProducer(Node* producer) {
+    // aten::conv{1,2,3}d are matched as well since scripted conv1d is never
+    // lowered to aten::_convolution and the pass may run before the others are
+    auto kind = producer->kind();
+    if (kind != aten::_convolution && kind != aten::conv1d && kind != aten::conv2d && kind != aten::conv3d &&
+        kind != aten::linear) {
+      return false;
+    }
+    // The output of the convolution / linear layer must only feed the batch norm
+    return producer->output()->uses().size() == 1;
+  }
+
+  bool tryFold(Node* bn) {
+    /// Check if this Node hosts a pattern like so:
+    /// %x : Tensor = aten::_convolution(%in, %w, %b, %stride, %pad, %dil, %transposed, %out_pad, %groups, ...)
+    ///     (or aten::conv{1,2,3}d(%in, %w, %b, ...) / aten::linear(%in, %w, %b))
+    /// %y : Tensor = aten::batch_norm(%x, %gamma, %beta, %mean, %var, %false, %momentum, %eps, %cudnn)
+    /// where all of %w, %b, %gamma, %beta, %mean, %var are constants
+    auto producer = bn->input(0)->node();
+    if (!isFoldableProducer(producer)) {
+      return false;
+    }
+
+    auto training = toIValue(bn->input(5));
+    auto eps_ivalue = toIValue(bn->input(7));
+    if (!training || !training->isBool() || training->toBool() || !eps_ivalue) {
+      return false;
+    }
+    auto eps = eps_ivalue->toDouble();
+
+    at::Tensor gamma, beta, mean, var, w, b;
+    if (!getConstTensor(bn->input(1), gamma) || !getConstTensor(bn->input(2), beta) ||
+        !getConstTensor(bn->input(3), mean) || !getConstTensor(bn->input(4), var) ||
+        !getConstTensor(producer->input(1), w) || !getConstTensor(producer->input(2), b)) {
+      return false;
+    }
+
+    if (!mean.defined() || !var.defined() || !w.defined()) {
+      return false;
+    }
+
+    auto opts = var.options().dtype(at::kFloat);
+    gamma = gamma.defined() ? gamma.to(opts) : at::ones_like(var, opts);
+    beta = beta.defined() ? beta.to(opts) : at::zeros_like(var, opts);
+    mean = mean.to(opts);
+    var = var.to(opts);
+
+    // y = (x - mean) * gamma / sqrt(var + eps) + beta
+    auto scale = gamma * at::rsqrt(var + eps);
+    auto shift = beta - mean * scale;
+
+    auto w_f = w.to(opts);
+    auto b_f = b.defined() ? b.to(opts) : at::zeros_like(mean, opts);
+
+    at::Tensor new_w;
+    if (producer->kind() == aten::linear) {
+      // weight: [out, in]
+      new_w = w_f * scale.unsqueeze(1);
+    } else {
+      // aten::conv{1,2,3}d are never transposed
+      bool transposed = false;
+      int64_t groups = 1;
+      if (producer->kind() == aten::_convolution) {
+        auto transposed_ivalue = toIValue(producer->input(6));
+        auto groups_ivalue = toIValue(producer->input(8));
+        if (!transposed_ivalue || !groups_ivalue) {
+          return false;
+        }
+        transposed = transposed_ivalue->toBool();
+        groups = groups_ivalue->toInt();
+      }
+
+      std::vector<int64_t> scale_shape(w_f.dim(), 1);
+      if (!transposed) {
+        // weight: [out, in / groups, k...]
+        scale_shape[0] = -1;
+        new_w = w_f * scale.view(scale_shape);
+      } else {
+        // weight: [in, out / groups, k...], output channels are grouped along
+        // dim 1 once the input channels are split per group
+        auto grouped_shape = util::toVec(w_f.sizes());
+        grouped_shape[0] = w_f.size(0) / groups;
+        grouped_shape.insert(grouped_shape.begin(), groups);
+        std::vector<int64_t> grouped_scale_shape(grouped_shape.size(), 1);
+        grouped_scale_shape[0] = groups;
+        grouped_scale_shape[2] = w_f.size(1);
+        new_w = (w_f.view(grouped_shape) * scale.view(grouped_scale_shape)).view(w_f.sizes());
+      }
+    }
+    auto new_b = b_f * scale + shift;
+
+    WithInsertPoint guard(producer);
+    auto new_w_const = graph_->insertConstant(new_w.to(w.dtype()).contiguous());
+    auto new_b_const = graph_->insertConstant(new_b.to(w.dtype()).contiguous());
+    producer->replaceInput(1, new_w_const);
+    producer->replaceInput(2, new_b_const);
+    bn->output()->replaceAllUsesWith(producer->output());
+    return true;
+  }
+
+  void findBatchNormNodes(Block* b) {
+    for (auto it = b->nodes().begin(); it != b->nodes().end(); it++) {
+      auto n = *it;
+      for (auto sub_b : n->blocks()) {
+        findBatchNormNodes(sub_b);
+      }
+
+      if (n->kind() == aten::batch_norm && tryFold(n)) {
+        LOG_GRAPH("Folded batch norm " << *n << " into " << *(n->input(0)->node()) << " (FoldBatchNorm)" << std::endl);
+        it.destroyCurrent();
+        num_folded_++;
+      }
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  uint64_t num_folded_ = 0;
+};
+} // namespace
+
+void FoldBatchNorm(std::shared_ptr<Graph>& graph) {
+  BatchNormFolding bnf(graph);
+  bnf.run();
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace trtorch
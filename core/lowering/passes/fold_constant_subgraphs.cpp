@@ -0,0 +1,137 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+#include "torch/csrc/jit/runtime/operator.h"
+
+#include "core/util/prelude.h"
+
+#include <vector>
+
+namespace trtorch {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+struct ConstantSubgraphFolding {
+  ConstantSubgraphFolding(std::shared_ptr<Graph> graph) : graph_(std::move(graph)) {}
+
+  void run() {
+    foldConstantNodes(graph_->block());
+    torch::jit::EliminateDeadCode(graph_);
+    LOG_DEBUG("FoldConstantSubgraphs - Folded " << num_folded_ << " nodes with only constant inputs into constants");
+    LOG_GRAPH("Post constant subgraph folding: " << *graph_);
+  }
+
+ private:
+  bool isFoldable(Node* n) {
+    /// Only pure aten ops that produce tensors from constant inputs are folded,
+    /// scalar and list arithmetic is left to the evaluators. Ex.
+    /// %w.1 : Float(10:1, 20:10) = prim::Constant[value=<Tensor>]()
+    /// %w_t : Tensor = aten::t(%w.1)
+    if (!n->kind().is_aten() || n->blocks().size() != 0) {
+      return false;
+    }
+
+    if (n->isNondeterministic() || n->hasSideEffects()) {
+      return false;
+    }
+
+    auto schema = n->maybeSchema();
+    if (!schema || schema->is_mutable()) {
+      return false;
+    }
+
+    for (auto o : n->outputs()) {
+      if (!o->type()->isSubtypeOf(c10::TensorType::get())) {
+        return false;
+      }
+    }
+
+    for (auto i : n->inputs()) {
+      if (i->node()->kind() != prim::Constant) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  c10::optional<Stack> evalOnCPU(Node* n, c10::Device& out_device) {
+    Stack stack;
+    bool found_device = false;
+    const auto& args = n->schema().arguments();
+    for (size_t idx = 0; idx < n->inputs().size(); idx++) {
+      auto ivalue = toIValue(n->input(idx));
+      if (!ivalue) {
+        return {};
+      }
+      if (idx < args.size() && args[idx].name() == "device" && ivalue->isDevice()) {
+        // Factory ops (e.g. aten::zeros) place their output on their device
+        // argument rather than on the device of an input tensor
+        out_device = ivalue->toDevice();
+        found_device = true;
+        stack.push_back(c10::IValue(c10::Device(at::kCPU)));
+      } else if (ivalue->isTensor()) {
+        auto t = ivalue->toTensor();
+        if (t.defined() && !found_device) {
+          out_device = t.device();
+          found_device = true;
+        }
+        stack.push_back(t.defined() ? t.to(at::kCPU) : t);
+      } else {
+        stack.push_back(*ivalue);
+      }
+    }
+
+    try {
+      at::NoGradGuard no_grad;
+      n->getOperation()(&stack);
+    } catch (std::exception& e) {
+      LOG_DEBUG("FoldConstantSubgraphs - Unable to evaluate " << util::node_info(n) << " on CPU: " << e.what());
+      return {};
+    }
+    return stack;
+  }
+
+  void foldConstantNodes(Block* b) {
+    for (auto it = b->nodes().begin(); it != b->nodes().end(); it++) {
+      auto n = *it;
+      for (auto sub_b : n->blocks()) {
+        foldConstantNodes(sub_b);
+      }
+
+      if (!isFoldable(n)) {
+        continue;
+      }
+
+      c10::Device out_device(at::kCPU);
+      auto outputs = evalOnCPU(n, out_device);
+      if (!outputs || outputs->size() != n->outputs().size()) {
+        continue;
+      }
+
+      LOG_GRAPH("Found that node " << *n << " only has constant inputs, folding (FoldConstantSubgraphs)" << std::endl);
+      WithInsertPoint guard(n);
+      for (size_t i = 0; i < n->outputs().size(); i++) {
+        auto t = (*outputs)[i].toTensor().detach().to(out_device);
+        auto new_const = b->owningGraph()->insertConstant(t);
+        n->outputs()[i]->replaceAllUsesWith(new_const);
+      }
+      it.destroyCurrent();
+      num_folded_++;
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  uint64_t num_folded_ = 0;
+};
+} // namespace
+
+void FoldConstantSubgraphs(std::shared_ptr<Graph>& graph) {
+  ConstantSubgraphFolding csf(graph);
+  csf.run();
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace trtorch
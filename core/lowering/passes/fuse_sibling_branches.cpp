@@ -0,0 +1,252 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/util/prelude.h"
+
+#include <vector>
+
+namespace trtorch {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+struct SiblingBranchFusion {
+  SiblingBranchFusion(std::shared_ptr<Graph> graph) : graph_(std::move(graph)) {}
+
+  void run() {
+    fuseSiblingsInBlock(graph_->block());
+    torch::jit::EliminateDeadCode(graph_);
+    LOG_DEBUG(
+        "FuseSiblingBranches - Merged " << num_fused_nodes_ << " linear / convolution nodes into " << num_groups_
+                                        << " wider nodes");
+    LOG_GRAPH("Post sibling branch fusion: " << *graph_);
+  }
+
+ private:
+  bool getConstTensor(Value* v, at::Tensor& t) {
+    if (v->node()->kind() != prim::Constant) {
+      return false;
+    }
+    auto ivalue = toIValue(v);
+    if (!ivalue) {
+      return false;
+    }
+    if (ivalue->isNone()) {
+      t = at::Tensor();
+      return true;
+    } else if (ivalue->isTensor()) {
+      t = ivalue->toTensor();
+      return true;
+    }
+    return false;
+  }
+
+  bool sameConstant(Value* a, Value* b) {
+    if (a == b) {
+      return true;
+    }
+    if (a->node()->kind() == prim::ListConstruct && b->node()->kind() == prim::ListConstruct) {
+      if (a->node()->inputs().size() != b->node()->inputs().size()) {
+        return false;
+      }
+      for (size_t i = 0; i < a->node()->inputs().size(); i++) {
+        if (!sameConstant(a->node()->input(i), b->node()->input(i))) {
+          return false;
+        }
+      }
+      return true;
+    }
+    auto a_ivalue = toIValue(a);
+    auto b_ivalue = toIValue(b);
+    if (!a_ivalue || !b_ivalue) {
+      return false;
+    }
+    if (a_ivalue->isInt() && b_ivalue->isInt()) {
+      return a_ivalue->toInt() == b_ivalue->toInt();
+    } else if (a_ivalue->isBool() && b_ivalue->isBool()) {
+      return a_ivalue->toBool() == b_ivalue->toBool();
+    } else if (a_ivalue->isDouble() && b_ivalue->isDouble()) {
+      return a_ivalue->toDouble() == b_ivalue->toDouble();
+    } else if (a_ivalue->isIntList() && b_ivalue->isIntList()) {
+      return a_ivalue->toIntVector() == b_ivalue->toIntVector();
+    }
+    return false;
+  }
+
+  bool isCandidate(Node* n, Value* shared_in) {
+    /// Looks for linear layers or convolutions with constant weights consuming
+    /// the same tensor. Ex. Q/K/V projections
+    /// %q : Tensor = aten::linear(%x, %w_q, %b_q)
+    /// %k : Tensor = aten::linear(%x, %w_k, %b_k)
+    /// %v : Tensor = aten::linear(%x, %w_v, %b_v)
+    if (n->input(0) != shared_in) {
+      return false;
+    }
+
+    at::Tensor w, b;
+    if (n->kind() == aten::linear) {
+      return getConstTensor(n->input(1), w) && getConstTensor(n->input(2), b) && w.defined() && w.dim() == 2;
+    } else if (n->kind() == aten::_convolution) {
+      if (!getConstTensor(n->input(1), w) || !getConstTensor(n->input(2), b) || !w.defined()) {
+        return false;
+      }
+      // Output channels of transposed or grouped convolutions are not laid out
+      // contiguously in the weights
+      auto transposed = toIValue(n->input(6));
+      auto groups = toIValue(n->input(8));
+      return transposed && !transposed->toBool() && groups && groups->toInt() == 1;
+    }
+    return false;
+  }
+
+  bool compatible(Node* a, Node* b) {
+    if (a->kind() != b->kind()) {
+      return false;
+    }
+
+    auto a_w = toIValue(a->input(1))->toTensor();
+    auto b_w = toIValue(b->input(1))->toTensor();
+    if (a_w.scalar_type() != b_w.scalar_type() || a_w.device() != b_w.device()) {
+      return false;
+    }
+
+    // Everything but the output channels has to match
+    if (a_w.sizes().slice(1) != b_w.sizes().slice(1)) {
+      return false;
+    }
+
+    // Stride, padding, dilation, etc. have to match for convolutions
+    for (size_t i = 3; i < a->inputs().size(); i++) {
+      if (!sameConstant(a->input(i), b->input(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void fuseGroup(std::vector<Node*>& group) {
+    auto first = group[0];
+    for (auto n : group) {
+      if (n->isBefore(first)) {
+        first = n;
+      }
+    }
+
+    std::vector<at::Tensor> weights, biases;
+    bool has_bias = false;
+    for (auto n : group) {
+      at::Tensor w, b;
+      getConstTensor(n->input(1), w);
+      getConstTensor(n->input(2), b);
+      weights.push_back(w);
+      biases.push_back(b);
+      has_bias |= b.defined();
+    }
+
+    if (has_bias) {
+      for (size_t i = 0; i < group.size(); i++) {
+        if (!biases[i].defined()) {
+          biases[i] = at::zeros({weights[i].size(0)}, weights[i].options());
+        }
+      }
+    }
+
+    WithInsertPoint guard(first);
+    auto fused_w = graph_->insertConstant(at::cat(weights, 0).contiguous());
+    auto fused_b = has_bias ? graph_->insertConstant(at::cat(biases, 0).contiguous()) : first->input(2);
+
+    std::vector<Value*> fused_inputs(first->inputs().begin(), first->inputs().end());
+    fused_inputs[1] = fused_w;
+    fused_inputs[2] = fused_b;
+    auto fused = graph_->create(first->kind(), fused_inputs, 1);
+    fused->insertBefore(first);
+    fused->output()->setType(c10::TensorType::get());
+
+    // Linear layers are split along the last dimension, convolutions along
+    // the channel dimension
+    auto split_dim = graph_->insertConstant(first->kind() == aten::linear ? -1 : 1);
+    auto step = graph_->insertConstant(1);
+    int64_t start = 0;
+    for (size_t i = 0; i < group.size(); i++) {
+      auto end = start + weights[i].size(0);
+      auto slice = graph_->create(
+          aten::slice,
+          {fused->output(), split_dim, graph_->insertConstant(start), graph_->insertConstant(end), step},
+          1);
+      slice->insertBefore(first);
+      slice->output()->setType(group[i]->output()->type());
+      group[i]->output()->replaceAllUsesWith(slice->output());
+      start = end;
+    }
+
+    LOG_GRAPH("Fused " << group.size() << " sibling nodes into " << *fused << " (FuseSiblingBranches)");
+    num_fused_nodes_ += group.size();
+    num_groups_++;
+  }
+
+  void fuseSiblingsOf(Value* shared_in, Block* b) {
+    std::vector<std::vector<Node*>> groups;
+    for (auto use : shared_in->uses()) {
+      auto n = use.user;
+      if (n->owningBlock() != b || use.offset != 0 || !isCandidate(n, shared_in)) {
+        continue;
+      }
+
+      bool placed = false;
+      for (auto& group : groups) {
+        if (compatible(group[0], n)) {
+          group.push_back(n);
+          placed = true;
+          break;
+        }
+      }
+      if (!placed) {
+        groups.push_back({n});
+      }
+    }
+
+    for (auto& group : groups) {
+      if (group.size() > 1) {
+        fuseGroup(group);
+      }
+    }
+  }
+
+  void fuseSiblingsInBlock(Block* b) {
+    for (auto in : b->inputs()) {
+      fuseSiblingsOf(in, b);
+    }
+
+    std::vector<Value*> values;
+    for (auto n : b->nodes()) {
+      for (auto sub_b : n->blocks()) {
+        fuseSiblingsInBlock(sub_b);
+      }
+      for (auto o : n->outputs()) {
+        values.push_back(o);
+      }
+    }
+
+    // New nodes are inserted while fusing so the candidate values are
+    // collected up front
+    for (auto v : values) {
+      fuseSiblingsOf(v, b);
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  uint64_t num_fused_nodes_ = 0;
+  uint64_t num_groups_ = 0;
+};
+} // namespace
+
+void FuseSiblingBranches(std::shared_ptr<Graph>& graph) {
+  SiblingBranchFusion sbf(graph);
+  sbf.run();
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace trtorch
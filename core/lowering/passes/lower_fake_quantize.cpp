@@ -0,0 +1,156 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/util/prelude.h"
+
+#include <vector>
+
+namespace trtorch {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+struct FakeQuantizeLowering {
+  FakeQuantizeLowering(std::shared_ptr<Graph> graph) : graph_(std::move(graph)) {}
+
+  void run() {
+    lowerBlock(graph_->block());
+    torch::jit::EliminateDeadCode(graph_);
+    LOG_DEBUG(
+        "LowerFakeQuantize - Folded " << num_weights_ << " fake quantized weights and replaced " << num_ranges_
+                                      << " fake quantized activations with dynamic ranges");
+    LOG_GRAPH("Post fake quantize lowering: " << *graph_);
+  }
+
+ private:
+  void lowerBlock(Block* b) {
+    for (auto it = b->nodes().begin(); it != b->nodes().end(); it++) {
+      auto n = *it;
+      for (auto sub_b : n->blocks()) {
+        lowerBlock(sub_b);
+      }
+
+      bool per_tensor = n->kind() == c10::Symbol::fromQualString("aten::fake_quantize_per_tensor_affine");
+      bool per_channel = n->kind() == c10::Symbol::fromQualString("aten::fake_quantize_per_channel_affine");
+      if (!per_tensor && !per_channel) {
+        continue;
+      }
+
+      if (n->input(0)->node()->kind() == prim::Constant) {
+        if (foldWeights(n, per_channel)) {
+          it.destroyCurrent();
+        }
+      } else if (per_tensor) {
+        if (replaceWithDynamicRange(n)) {
+          it.destroyCurrent();
+        }
+      }
+      // Per channel fake quantization of activations has no TensorRT
+      // equivalent and is left to be reported as unsupported
+    }
+  }
+
+  /// Frozen modules compute the quantization parameters from the buffers of
+  /// the observers, Ex.
+  /// %scale.1 : Tensor = prim::Constant[value={0.0157}]()
+  /// %scale : float = aten::Float(%scale.1)
+  c10::optional<IValue> constantValue(Value* v) {
+    if (auto ivalue = toIValue(v)) {
+      return ivalue;
+    }
+    auto n = v->node();
+    if (n->inputs().size() != 1) {
+      return {};
+    }
+    bool to_float = n->kind() == aten::Float || n->kind() == c10::Symbol::fromQualString("aten::FloatImplicit");
+    bool to_int = n->kind() == aten::Int || n->kind() == c10::Symbol::fromQualString("aten::IntImplicit");
+    if (!to_float && !to_int) {
+      return {};
+    }
+    auto in = toIValue(n->input());
+    if (!in || !in->isTensor() || in->toTensor().numel() != 1) {
+      return {};
+    }
+    auto t = in->toTensor();
+    return to_float ? IValue(t.item<double>()) : IValue(t.item<int64_t>());
+  }
+
+  /// Weights are quantized by TensorRT itself (per output channel), so fake
+  /// quantized weights are folded into constants holding the fake quantized
+  /// values which already lie on the grid the model was trained with
+  bool foldWeights(Node* n, bool per_channel) {
+    std::vector<IValue> args;
+    for (auto i : n->inputs()) {
+      auto ivalue = constantValue(i);
+      if (!ivalue) {
+        return false;
+      }
+      args.push_back(*ivalue);
+    }
+
+    auto w = args[0].toTensor();
+    at::Tensor folded;
+    if (per_channel) {
+      folded = at::fake_quantize_per_channel_affine(
+          w, args[1].toTensor(), args[2].toTensor(), args[3].toInt(), args[4].toInt(), args[5].toInt());
+    } else {
+      folded = at::fake_quantize_per_tensor_affine(
+          w, args[1].toDouble(), args[2].toInt(), args[3].toInt(), args[4].toInt());
+    }
+
+    WithInsertPoint guard(n);
+    auto folded_value = graph_->insertConstant(folded);
+    folded_value->setType(n->output()->type());
+    LOG_GRAPH("Folding fake quantized weights " << *n << " (LowerFakeQuantize)");
+    n->output()->replaceAllUsesWith(folded_value);
+    num_weights_++;
+    return true;
+  }
+
+  /// Activations keep their values, quantizing them is left to TensorRT
+  /// with the range the model was trained with. Ex.
+  /// %y : Tensor = aten::fake_quantize_per_tensor_affine(%x, %scale, %zero_point, %quant_min, %quant_max)
+  /// becomes
+  /// %y : Tensor = trt::dynamic_range(%x, %min, %max)
+  /// where min = (quant_min - zero_point) * scale and max = (quant_max - zero_point) * scale
+  bool replaceWithDynamicRange(Node* n) {
+    auto scale = constantValue(n->input(1));
+    auto zero_point = constantValue(n->input(2));
+    auto quant_min = constantValue(n->input(3));
+    auto quant_max = constantValue(n->input(4));
+    if (!scale || !zero_point || !quant_min || !quant_max) {
+      // Left to the aten::fake_quantize_per_tensor_affine converter to resolve
+      // at conversion time
+      return false;
+    }
+
+    auto min = (quant_min->toInt() - zero_point->toInt()) * scale->toDouble();
+    auto max = (quant_max->toInt() - zero_point->toInt()) * scale->toDouble();
+
+    WithInsertPoint guard(n);
+    auto range = graph_->insertNode(graph_->create(
+        c10::Symbol::fromQualString("trt::dynamic_range"),
+        {n->input(0), graph_->insertConstant(min), graph_->insertConstant(max)}));
+    range->output()->setType(n->output()->type());
+    LOG_GRAPH("Replacing " << *n << " with " << *range << " (LowerFakeQuantize)");
+    n->output()->replaceAllUsesWith(range->output());
+    num_ranges_++;
+    return true;
+  }
+
+  std::shared_ptr<Graph> graph_;
+  uint64_t num_weights_ = 0;
+  uint64_t num_ranges_ = 0;
+};
+} // namespace
+
+void LowerFakeQuantize(std::shared_ptr<Graph>& graph) {
+  FakeQuantizeLowering fql(graph);
+  fql.run();
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace trtorch
@@ -0,0 +1,248 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/util/prelude.h"
+
+#include <limits>
+#include <unordered_set>
+#include <vector>
+
+namespace trtorch {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+struct Int64Narrowing {
+  Int64Narrowing(std::shared_ptr<Graph> graph) : graph_(std::move(graph)) {}
+
+  void run() {
+    narrowInputs();
+    narrowBlock(graph_->block());
+    castOutputs();
+    torch::jit::EliminateDeadCode(graph_);
+    LOG_DEBUG(
+        "NarrowInt64ToInt32 - Narrowed " << num_inputs_ << " inputs, " << num_constants_ << " constants and "
+                                         << num_casts_ << " casts from int64 to int32, casting " << num_outputs_
+                                         << " outputs back to int64");
+    LOG_GRAPH("Post int64 narrowing: " << *graph_);
+  }
+
+ private:
+  bool isIndexInput(Value* in) {
+    for (auto use : in->uses()) {
+      if (use.user->kind() == aten::embedding && use.offset == 1) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void narrowInputs() {
+    /// TensorRT has no int64 so integer inputs are built as int32 bindings and
+    /// the runtime narrows int64 tensors on device before enqueueing. Inputs are
+    /// recognized as integer by their type or by being used as indices. Ex.
+    /// %ids : Long(...) = ...
+    /// %emb : Tensor = aten::embedding(%weight, %ids, %pad, %false, %false)
+    for (auto in : graph_->inputs()) {
+      auto t = in->type()->cast<c10::TensorType>();
+      if (!t) {
+        continue;
+      }
+      auto scalar_type = t->scalarType();
+      if ((scalar_type && *scalar_type == at::kLong) || (!scalar_type && isIndexInput(in))) {
+        in->setType(t->withScalarType(at::kInt));
+        narrowed_.insert(in);
+        num_inputs_++;
+      }
+    }
+  }
+
+  bool fitsInInt32(const at::Tensor& t) {
+    if (t.numel() == 0) {
+      return true;
+    }
+    return t.min().item<int64_t>() >= std::numeric_limits<int32_t>::min() &&
+        t.max().item<int64_t>() <= std::numeric_limits<int32_t>::max();
+  }
+
+  bool narrowConstant(Node* n) {
+    auto ivalue = toIValue(n->output());
+    if (!ivalue || !ivalue->isTensor()) {
+      return false;
+    }
+    auto t = ivalue->toTensor();
+    if (!t.defined() || t.scalar_type() != at::kLong) {
+      return false;
+    }
+    if (!fitsInInt32(t)) {
+      LOG_DEBUG("NarrowInt64ToInt32 - Values of " << *n->output() << " do not fit in int32, leaving as int64");
+      return false;
+    }
+
+    WithInsertPoint guard(n);
+    auto narrowed = graph_->insertConstant(t.to(at::kInt));
+    n->output()->replaceAllUsesWith(narrowed);
+    narrowed_.insert(narrowed);
+    return true;
+  }
+
+  bool staysInEngine(Node* n) {
+    // Values returned from the graph get cast back to int64 by castOutputs, values
+    // leaving a block through a loop carry or a conditional keep the type the rest
+    // of the graph was typed against so they are left as int64
+    for (auto o : n->outputs()) {
+      for (auto use : o->uses()) {
+        auto user = use.user;
+        if (user->kind() == prim::Loop || user->kind() == prim::If) {
+          return false;
+        }
+        if (user->kind() == prim::Return && user->owningBlock() != graph_->block()) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Returns true if the node has a dtype argument, in which case its outputs
+  // have that type regardless of the type of its inputs
+  bool narrowDTypeArguments(Node* n) {
+    // Casts and factories which request int64 produce int32 instead
+    auto schema = n->maybeSchema();
+    if (!schema) {
+      return false;
+    }
+    bool has_dtype = false;
+    auto& args = schema->arguments();
+    for (size_t i = 0; i < args.size() && i < n->inputs().size(); i++) {
+      if (args[i].name() != "dtype") {
+        continue;
+      }
+      auto dtype = toIValue(n->input(i));
+      if (!dtype || dtype->isNone()) {
+        continue;
+      }
+      has_dtype = true;
+      if (dtype->isInt() && static_cast<at::ScalarType>(dtype->toInt()) == at::kLong && staysInEngine(n)) {
+        WithInsertPoint guard(n);
+        n->replaceInput(i, graph_->insertConstant(static_cast<int64_t>(at::kInt)));
+        markOutputsNarrowed(n);
+        num_casts_++;
+      }
+    }
+    return has_dtype;
+  }
+
+  bool preservesIntegerType(Node* n) {
+    /// Ops whose output has the type of their inputs, so an output computed
+    /// only from narrowed values is narrowed as well. Ex.
+    /// %ids : Int(...) = ...
+    /// %flat : Tensor = aten::flatten(%ids, %0, %1)
+    /// Anything else (comparisons, true division, mixing in floating point
+    /// tensors, etc.) is assumed to produce a different type
+    static const std::unordered_set<NodeKind> kinds = {
+        aten::add,       aten::sub,          aten::mul,       aten::neg,       aten::abs,
+        aten::remainder, aten::floor_divide, aten::clamp,     aten::max,       aten::min,
+        aten::reshape,   aten::view,         aten::flatten,   aten::permute,   aten::transpose,
+        aten::squeeze,   aten::unsqueeze,    aten::slice,     aten::select,    aten::index_select,
+        aten::gather,    aten::cat,          aten::stack,     aten::expand,    aten::repeat,
+        aten::contiguous, aten::clone};
+    if (kinds.find(n->kind()) == kinds.end()) {
+      return false;
+    }
+
+    bool narrowed_input = false;
+    for (auto in : n->inputs()) {
+      if (in->type()->isSubtypeOf(c10::TensorType::get())) {
+        if (narrowed_.find(in) == narrowed_.end()) {
+          return false;
+        }
+        narrowed_input = true;
+      } else if (auto list_type = in->type()->cast<c10::ListType>()) {
+        // aten::cat / aten::stack take their tensors as a list
+        if (!list_type->getElementType()->isSubtypeOf(c10::TensorType::get())) {
+          continue;
+        }
+        if (in->node()->kind() != prim::ListConstruct) {
+          return false;
+        }
+        for (auto elem : in->node()->inputs()) {
+          if (narrowed_.find(elem) == narrowed_.end()) {
+            return false;
+          }
+        }
+        narrowed_input = true;
+      }
+    }
+    return narrowed_input;
+  }
+
+  void markOutputsNarrowed(Node* n) {
+    for (auto o : n->outputs()) {
+      if (o->type()->isSubtypeOf(c10::TensorType::get())) {
+        narrowed_.insert(o);
+      }
+    }
+  }
+
+  void castOutputs() {
+    /// Outputs which were int64 before narrowing are cast back to int64 right
+    /// before they are returned, the cast is tagged so conversion marks its input
+    /// as the engine output and the runtime applies it, TensorRT only ever sees
+    /// int32. Ex.
+    /// %flat : Tensor = aten::flatten(%ids, %0, %1)
+    /// %flat_long : Tensor = aten::to(%flat, %4, %false, %false, %none)
+    /// return (%flat_long)
+    auto outputs = graph_->outputs();
+    for (size_t i = 0; i < outputs.size(); i++) {
+      auto out = outputs[i];
+      if (narrowed_.find(out) == narrowed_.end()) {
+        continue;
+      }
+      WithInsertPoint guard(graph_->return_node());
+      auto long_dtype = graph_->insertConstant(static_cast<int64_t>(at::kLong));
+      auto cast = graph_->insert(aten::to, {out, long_dtype});
+      util::markInt64OutputCast(cast->node());
+      graph_->return_node()->replaceInput(i, cast);
+      num_outputs_++;
+    }
+  }
+
+  void narrowBlock(Block* b) {
+    for (auto it = b->nodes().begin(); it != b->nodes().end(); it++) {
+      auto n = *it;
+      for (auto sub_b : n->blocks()) {
+        narrowBlock(sub_b);
+      }
+
+      if (n->kind() == prim::Constant) {
+        if (narrowConstant(n)) {
+          it.destroyCurrent();
+          num_constants_++;
+        }
+      } else if (!narrowDTypeArguments(n) && preservesIntegerType(n)) {
+        markOutputsNarrowed(n);
+      }
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  // Values which were int64 and are now int32
+  std::unordered_set<Value*> narrowed_;
+  uint64_t num_inputs_ = 0;
+  uint64_t num_constants_ = 0;
+  uint64_t num_casts_ = 0;
+  uint64_t num_outputs_ = 0;
+};
+} // namespace
+
+void NarrowInt64ToInt32(std::shared_ptr<Graph>& graph) {
+  Int64Narrowing in(graph);
+  in.run();
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace trtorch
@@ -7,14 +7,30 @@ namespace core {
 namespace lowering {
 namespace passes {
 
+// Bounds on the shape of a graph input, dimensions where min and max agree
+// are treated as static
+struct InputShapeRange {
+  std::vector<int64_t> min;
+  std::vector<int64_t> max;
+};
+
 void Conv2DToConvolution(std::shared_ptr<torch::jit::Graph>& graph);
 void Conv3DToConvolution(std::shared_ptr<torch::jit::Graph>& graph);
+void FoldBatchNorm(std::shared_ptr<torch::jit::Graph>& graph);
+void FoldConstantSubgraphs(std::shared_ptr<torch::jit::Graph>& graph);
 void FuseAddMMBranches(std::shared_ptr<torch::jit::Graph> graph);
 void FuseFlattenLinear(std::shared_ptr<torch::jit::Graph>& graph);
+void FuseSiblingBranches(std::shared_ptr<torch::jit::Graph>& graph);
+void LowerFakeQuantize(std::shared_ptr<torch::jit::Graph>& graph);
 void EliminateExceptionOrPassPattern(std::shared_ptr<torch::jit::Graph> graph);
+void EliminateRedundantShuffles(std::shared_ptr<torch::jit::Graph>& graph);
+void NarrowInt64ToInt32(std::shared_ptr<torch::jit::Graph>& graph);
 void RemoveContiguous(std::shared_ptr<torch::jit::Graph>& graph);
 void RemoveDropout(std::shared_ptr<torch::jit::Graph>& graph);
 void RemoveTo(std::shared_ptr<torch::jit::Graph> graph);
+void SpecializeInputShapes(
+    std::shared_ptr<torch::jit::Graph>& graph,
+    const std::vector<InputShapeRange>& input_shapes);
 void UnpackAddMM(std::shared_ptr<torch::jit::Graph>& graph);
 void UnpackBatchNorm(std::shared_ptr<torch::jit::Graph>& graph);
 void UnpackLogSoftmax(std::shared_ptr<torch::jit::Graph>& graph);
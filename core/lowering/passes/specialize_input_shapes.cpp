@@ -0,0 +1,188 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/constant_propagation.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+#include "torch/csrc/jit/passes/shape_analysis.h"
+
+#include "core/lowering/passes/passes.h"
+#include "core/util/prelude.h"
+
+#include <vector>
+
+namespace trtorch {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+struct InputShapeSpecialization {
+  InputShapeSpecialization(std::shared_ptr<Graph> graph, const std::vector<InputShapeRange>& input_shapes)
+      : graph_(std::move(graph)), input_shapes_(input_shapes) {}
+
+  void run() {
+    if (!annotateInputs()) {
+      return;
+    }
+
+    try {
+      torch::jit::PropagateInputShapes(graph_);
+    } catch (std::exception& e) {
+      // Shape analysis does not know about every op, whatever was annotated
+      // before the failure is still valid
+      LOG_DEBUG("SpecializeInputShapes - Shape propagation stopped early: " << e.what());
+    }
+
+    foldShapeQueries(graph_->block());
+    auto num_branches_before = countIfNodes(graph_->block());
+    torch::jit::ConstantPropagation(graph_);
+    torch::jit::EliminateDeadCode(graph_);
+    auto num_branches_after = countIfNodes(graph_->block());
+
+    LOG_DEBUG(
+        "SpecializeInputShapes - Folded " << num_folded_ << " shape queries and removed "
+                                          << num_branches_before - num_branches_after
+                                          << " shape dependent branches");
+    LOG_GRAPH("Post input shape specialization: " << *graph_);
+  }
+
+ private:
+  bool annotateInputs() {
+    // Like conversion::AddInputs, input shapes only describe the tensor inputs
+    // of the graph, in order, so inputs of other types are skipped
+    std::vector<Value*> tensor_inputs;
+    for (auto in : graph_->inputs()) {
+      if (in->type()->isSubtypeOf(c10::TensorType::get())) {
+        tensor_inputs.push_back(in);
+      }
+    }
+
+    if (input_shapes_.size() > tensor_inputs.size()) {
+      LOG_WARNING(
+          "SpecializeInputShapes - More input shapes (" << input_shapes_.size()
+                                                        << ") were provided than the graph has tensor inputs ("
+                                                        << tensor_inputs.size() << "), skipping shape specialization");
+      return false;
+    }
+
+    for (size_t i = 0; i < input_shapes_.size(); i++) {
+      auto& range = input_shapes_[i];
+      auto in = tensor_inputs[i];
+      auto in_type = in->type()->expect<c10::TensorType>();
+      if (range.min.size() != range.max.size()) {
+        continue;
+      }
+
+      // Dimensions which may vary between the min and max shape are left
+      // symbolic so that queries against them are still resolved at runtime
+      std::vector<c10::optional<int64_t>> sizes;
+      for (size_t d = 0; d < range.min.size(); d++) {
+        if (range.min[d] == range.max[d]) {
+          sizes.push_back(range.min[d]);
+        } else {
+          sizes.push_back(c10::nullopt);
+        }
+      }
+
+      auto specialized_type = c10::TensorType::create(
+          in_type->scalarType(),
+          in_type->device(),
+          c10::VaryingShape<int64_t>(sizes),
+          c10::VaryingShape<int64_t>(sizes.size()),
+          in_type->requiresGrad());
+      in->setType(specialized_type);
+      LOG_GRAPH("Specialized input " << in->debugName() << " to " << *specialized_type);
+    }
+    return true;
+  }
+
+  c10::optional<IValue> staticShapeQuery(Node* n) {
+    auto t = n->input(0)->type()->cast<c10::TensorType>();
+    if (!t) {
+      return {};
+    }
+
+    auto rank = t->dim();
+    if (n->kind() == aten::dim) {
+      if (!rank) {
+        return {};
+      }
+      return IValue(static_cast<int64_t>(*rank));
+    }
+
+    if (n->kind() == aten::size && n->inputs().size() == 2) {
+      auto dim_ivalue = toIValue(n->input(1));
+      if (!rank || !dim_ivalue || !dim_ivalue->isInt()) {
+        return {};
+      }
+      auto dim = dim_ivalue->toInt();
+      dim = dim < 0 ? dim + *rank : dim;
+      if (dim < 0 || dim >= static_cast<int64_t>(*rank)) {
+        return {};
+      }
+      auto size = t->sizes()[dim];
+      if (!size) {
+        return {};
+      }
+      return IValue(*size);
+    }
+
+    // aten::size(Tensor) and prim::shape need every dimension to be static
+    auto sizes = t->sizes().concrete_sizes();
+    if (!sizes) {
+      return {};
+    }
+    return IValue(*sizes);
+  }
+
+  void foldShapeQueries(Block* b) {
+    for (auto it = b->nodes().begin(); it != b->nodes().end(); it++) {
+      auto n = *it;
+      for (auto sub_b : n->blocks()) {
+        foldShapeQueries(sub_b);
+      }
+
+      if (n->kind() != aten::size && n->kind() != aten::dim && n->kind() != prim::shape) {
+        continue;
+      }
+
+      auto value = staticShapeQuery(n);
+      if (!value) {
+        continue;
+      }
+
+      LOG_GRAPH("Found that node " << *n << " is static for the provided input shapes (SpecializeInputShapes)");
+      WithInsertPoint guard(n);
+      auto new_const = graph_->insertConstant(*value);
+      n->output()->replaceAllUsesWith(new_const);
+      it.destroyCurrent();
+      num_folded_++;
+    }
+  }
+
+  int64_t countIfNodes(Block* b) {
+    int64_t count = 0;
+    for (auto n : b->nodes()) {
+      if (n->kind() == prim::If) {
+        count++;
+      }
+      for (auto sub_b : n->blocks()) {
+        count += countIfNodes(sub_b);
+      }
+    }
+    return count;
+  }
+
+  std::shared_ptr<Graph> graph_;
+  const std::vector<InputShapeRange>& input_shapes_;
+  uint64_t num_folded_ = 0;
+};
+} // namespace
+
+void SpecializeInputShapes(std::shared_ptr<Graph>& graph, const std::vector<InputShapeRange>& input_shapes) {
+  InputShapeSpecialization iss(graph, input_shapes);
+  iss.run();
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace trtorch
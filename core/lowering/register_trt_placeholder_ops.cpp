@@ -11,6 +11,13 @@ RegisterOperators trt_placeholder_ops_reg({
     /// Op marks a Tensor to be conveted from an Torch Tensor
     /// to a TRT constant Tensor
     Operator("trt::const(Tensor val) -> Tensor", [](Stack* stack) {}, aliasAnalysisFromSchema()),
+    /// Op marks the range a Tensor was fake quantized to during quantization
+    /// aware training, to be set as the dynamic range of the TRT Tensor.
+    /// Passes the Tensor through unchanged when run
+    Operator(
+        "trt::dynamic_range(Tensor self, float min, float max) -> Tensor",
+        [](Stack* stack) { drop(*stack, 2); },
+        aliasAnalysisFromSchema()),
 });
 
 } // namespace jit
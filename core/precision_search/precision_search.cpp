@@ -0,0 +1,379 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include "ATen/core/grad_mode.h"
+#include "c10/cuda/CUDAStream.h"
+#include "torch/csrc/jit/runtime/graph_executor.h"
+
+#include "core/calibration/calibration.h"
+#include "core/precision_search/precision_search.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace trtorch {
+namespace core {
+namespace precision_search {
+
+namespace {
+using Batches = std::vector<std::vector<at::Tensor>>;
+
+struct Evaluation {
+  double error;
+  double latency_ms;
+};
+
+std::string EscapeRegex(const std::string& s) {
+  static const std::string special = "\\^$.|?*+()[]{}";
+  std::string escaped;
+  for (auto c : s) {
+    if (special.find(c) != std::string::npos) {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+void FlattenTensors(const torch::jit::IValue& v, std::vector<at::Tensor>& tensors) {
+  if (v.isTensor()) {
+    tensors.push_back(v.toTensor());
+  } else if (v.isTuple()) {
+    for (auto& e : v.toTuple()->elements()) {
+      FlattenTensors(e, tensors);
+    }
+  } else if (v.isList()) {
+    for (auto e : v.toList()) {
+      FlattenTensors(e, tensors);
+    }
+  }
+}
+
+double RelativeError(const at::Tensor& out, const at::Tensor& ref) {
+  auto r = ref.to(at::kFloat);
+  auto o = out.to(r.device(), at::kFloat).reshape(r.sizes());
+  auto scale = r.abs().max().item<double>();
+  auto diff = (o - r).abs().max().item<double>();
+  return scale > 0 ? diff / scale : diff;
+}
+
+// Runs a batch in TorchScript, returning the tensors on the stack afterwards
+// (the outputs of the graph)
+std::vector<at::Tensor> RunReference(
+    torch::jit::GraphExecutor& executor,
+    const std::vector<torch::jit::IValue>& params,
+    const std::vector<at::Tensor>& batch) {
+  torch::jit::Stack stack(batch.begin(), batch.end());
+  stack.insert(stack.end(), params.begin(), params.end());
+  executor.run(stack);
+  std::vector<at::Tensor> tensors;
+  for (auto& v : stack) {
+    FlattenTensors(v, tensors);
+  }
+  return tensors;
+}
+
+class EngineEvaluator {
+ public:
+  EngineEvaluator(
+      lowering::LoweringCache& lowering_cache,
+      std::string method_name,
+      const std::vector<lowering::passes::InputShapeRange>& input_shapes,
+      conversion::ConversionInfo convert_info,
+      const Batches& batches)
+      : method_name_(std::move(method_name)), convert_info_(std::move(convert_info)), batches_(batches) {
+    auto graph_and_parameters = lowering_cache.Lower(method_name_, input_shapes);
+    g_ = graph_and_parameters.first;
+    params_ = graph_and_parameters.second;
+    num_method_inputs_ = g_->inputs().size() - params_.size();
+
+    // Engines take their floating point inputs in the operating precision
+    for (auto& batch : batches_) {
+      TRTORCH_CHECK(
+          batch.size() == num_method_inputs_,
+          "Expected validation batches with " << num_method_inputs_ << " tensors (one for each input of "
+                                              << method_name_ << ") but found " << batch.size());
+      std::vector<at::Tensor> inputs;
+      for (auto& t : batch) {
+        auto in = t.to(at::kCUDA);
+        if (in.is_floating_point() && convert_info_.engine_settings.op_precision == nvinfer1::DataType::kHALF) {
+          in = in.to(at::kHalf);
+        }
+        inputs.push_back(in);
+      }
+      engine_inputs_.push_back(std::move(inputs));
+    }
+    torch::jit::GraphExecutor executor(g_->copy(), method_name_);
+    for (auto& batch : batches_) {
+      references_.push_back(RunReference(executor, params_, batch));
+    }
+  }
+
+  const std::shared_ptr<torch::jit::Graph>& graph() const {
+    return g_;
+  }
+
+  // Builds an engine with extra layer precision rules (applied before the
+  // rules of the compile spec, which take precedence) and compares its outputs
+  // against TorchScript
+  Evaluation Evaluate(const std::vector<conversion::LayerPrecisionRule>& promotions) {
+    TRTORCH_TRACE_SCOPE("EvaluatePromotions", "precision_search");
+    auto info = convert_info_;
+    auto& rules = info.engine_settings.layer_precisions;
+    rules.insert(rules.begin(), promotions.begin(), promotions.end());
+    auto engine = Build(info, nullptr);
+
+    Evaluation eval{0, 0};
+    for (size_t i = 0; i < batches_.size(); i++) {
+      auto outputs = runtime::execute_engine(engine_inputs_[i], engine);
+      auto& refs = references_[i];
+      TRTORCH_CHECK(
+          outputs.size() == refs.size(),
+          "Engine for " << method_name_ << " has " << outputs.size() << " outputs but TorchScript returned "
+                        << refs.size() << " tensors");
+      for (size_t j = 0; j < outputs.size(); j++) {
+        eval.error = std::max(eval.error, RelativeError(outputs[j], refs[j]));
+      }
+    }
+    eval.latency_ms = MeasureLatency(engine);
+    return eval;
+  }
+
+  // Builds an engine with every activation marked as an output and returns the
+  // largest relative error of each activation (by value) across the batches
+  std::unordered_map<const torch::jit::Value*, double> MeasureActivationErrors() {
+    TRTORCH_TRACE_SCOPE("MeasureActivationErrors", "precision_search");
+    auto info = convert_info_;
+    info.mark_activations = true;
+    std::vector<const torch::jit::Value*> marked;
+    auto engine = Build(info, &marked);
+
+    auto observed = g_->copy();
+    auto num_outputs = observed->outputs().size();
+    auto names = calibration::ObserveActivations(observed, num_method_inputs_);
+    std::unordered_map<std::string, size_t> observed_index;
+    for (size_t i = 0; i < names.size(); i++) {
+      observed_index[names[i]] = num_outputs + i;
+    }
+
+    torch::jit::GraphExecutor executor(observed, method_name_);
+    std::unordered_map<const torch::jit::Value*, double> errors;
+    for (size_t i = 0; i < batches_.size(); i++) {
+      // Only the activations of one batch are alive at a time
+      auto refs = RunReference(executor, params_, batches_[i]);
+      auto outputs = runtime::execute_engine(engine_inputs_[i], engine);
+      auto first_marked = outputs.size() - marked.size();
+      for (size_t j = 0; j < marked.size(); j++) {
+        auto ref = observed_index.find(marked[j]->debugName());
+        if (ref == observed_index.end() || ref->second >= refs.size()) {
+          continue;
+        }
+        auto& error = errors[marked[j]];
+        error = std::max(error, RelativeError(outputs[first_marked + j], refs[ref->second]));
+      }
+    }
+    return errors;
+  }
+
+ private:
+  c10::intrusive_ptr<runtime::TRTEngine> Build(
+      conversion::ConversionInfo info,
+      std::vector<const torch::jit::Value*>* marked) {
+    auto named_params = conversion::get_named_params(g_->inputs(), params_);
+    conversion::ConversionCtx ctx(info.engine_settings);
+    conversion::ConvertBlockToNetDef(&ctx, g_->block(), info, named_params);
+    if (marked) {
+      *marked = ctx.marked_activations;
+    }
+    return c10::make_intrusive<runtime::TRTEngine>(method_name_ + "_search", ctx.SerializeEngine());
+  }
+
+  // Mean time to run a validation batch, after one warm up run
+  double MeasureLatency(c10::intrusive_ptr<runtime::TRTEngine>& engine) {
+    auto stream = c10::cuda::getCurrentCUDAStream();
+    runtime::execute_engine(engine_inputs_[0], engine);
+    stream.synchronize();
+    auto start = std::chrono::steady_clock::now();
+    for (auto& inputs : engine_inputs_) {
+      runtime::execute_engine(inputs, engine);
+    }
+    stream.synchronize();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / engine_inputs_.size();
+  }
+
+  std::string method_name_;
+  conversion::ConversionInfo convert_info_;
+  const Batches& batches_;
+  std::shared_ptr<torch::jit::Graph> g_;
+  std::vector<torch::jit::IValue> params_;
+  size_t num_method_inputs_;
+  Batches engine_inputs_;
+  Batches references_;
+};
+
+} // namespace
+
+std::vector<RankedLayer> RankLayers(
+    const torch::jit::Block* b,
+    const std::unordered_map<const torch::jit::Value*, double>& measured) {
+  std::unordered_map<const torch::jit::Value*, double> errors;
+  std::vector<RankedLayer> candidates;
+  for (auto n : b->nodes()) {
+    double in_error = 0;
+    for (auto in : n->inputs()) {
+      auto e = errors.find(in);
+      if (e != errors.end()) {
+        in_error = std::max(in_error, e->second);
+      }
+    }
+
+    c10::optional<RankedLayer> candidate;
+    for (auto out : n->outputs()) {
+      auto m = measured.find(out);
+      if (m == measured.end()) {
+        errors[out] = in_error;
+        continue;
+      }
+      errors[out] = m->second;
+      if (!candidate || m->second - in_error > candidate->error) {
+        candidate = RankedLayer{n, out, m->second - in_error};
+      }
+    }
+    if (candidate && candidate->error > 0) {
+      candidates.push_back(*candidate);
+    }
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(), [](const RankedLayer& a, const RankedLayer& b) {
+    return a.error > b.error;
+  });
+  return candidates;
+}
+
+c10::optional<size_t> FindPromotionCount(size_t num_ranked, const std::function<bool(size_t)>& passes) {
+  if (num_ranked == 0) {
+    return {};
+  }
+  // Smallest passing count lies in (failing, passing]
+  size_t failing = 0;
+  size_t passing = 1;
+  while (!passes(passing)) {
+    failing = passing;
+    if (passing == num_ranked) {
+      return {};
+    }
+    passing = std::min(passing * 2, num_ranked);
+  }
+  while (passing - failing > 1) {
+    auto mid = failing + (passing - failing) / 2;
+    if (passes(mid)) {
+      passing = mid;
+    } else {
+      failing = mid;
+    }
+  }
+  return passing;
+}
+
+std::ostream& operator<<(std::ostream& os, const SearchSettings& s) {
+  os << "Layer precision search settings:"
+     << "\n    Threshold: " << s.threshold << "\n    Promoted Precision: " << s.promoted_precision;
+  return os;
+}
+
+SearchResult SearchLayerPrecisions(
+    lowering::LoweringCache& lowering_cache,
+    std::string method_name,
+    const std::vector<lowering::passes::InputShapeRange>& input_shapes,
+    conversion::ConversionInfo convert_info,
+    const std::vector<std::vector<at::Tensor>>& validation_batches,
+    SearchSettings settings) {
+  TRTORCH_TRACE_SCOPE("SearchLayerPrecisions", "precision_search");
+  LOG_DEBUG(settings);
+  auto base_precision = convert_info.engine_settings.op_precision;
+  TRTORCH_CHECK(
+      base_precision == nvinfer1::DataType::kHALF || base_precision == nvinfer1::DataType::kINT8,
+      "Searching for layer precisions starts from an FP16 or INT8 operating precision, found " << base_precision);
+  TRTORCH_CHECK(
+      settings.promoted_precision == nvinfer1::DataType::kFLOAT ||
+          (settings.promoted_precision == nvinfer1::DataType::kHALF && base_precision == nvinfer1::DataType::kINT8),
+      "Layers can only be promoted to a precision higher than the operating precision " << base_precision);
+  TRTORCH_CHECK(!validation_batches.empty(), "No validation batches provided to search for layer precisions with");
+
+  at::NoGradGuard no_grad;
+  EngineEvaluator evaluator(lowering_cache, method_name, input_shapes, std::move(convert_info), validation_batches);
+
+  SearchResult result;
+  auto base = evaluator.Evaluate({});
+  result.base_error = result.error = base.error;
+  result.base_latency_ms = result.latency_ms = base.latency_ms;
+  LOG_INFO(
+      "Every layer in " << base_precision << ": error " << base.error << " (threshold " << settings.threshold
+                        << "), latency " << base.latency_ms << " ms");
+  if (base.error <= settings.threshold) {
+    LOG_INFO("No layers of " << method_name << " need to be promoted");
+    return result;
+  }
+
+  auto ranked = RankLayers(evaluator.graph()->block(), evaluator.MeasureActivationErrors());
+  LOG_INFO("Ranked " << ranked.size() << " layers adding error in " << base_precision);
+  if (ranked.empty()) {
+    LOG_WARNING("Could not attribute the error of " << method_name << " to any layer, no layers promoted");
+    return result;
+  }
+
+  std::vector<conversion::LayerPrecisionRule> rules;
+  for (auto& c : ranked) {
+    conversion::LayerPrecisionRule rule;
+    rule.kind = EscapeRegex(c.node->kind().toQualString());
+    rule.name = EscapeRegex(c.value->debugName());
+    rule.precision = settings.promoted_precision;
+    rules.push_back(std::move(rule));
+  }
+
+  std::map<size_t, Evaluation> evaluations;
+  auto evaluate = [&](size_t num_promoted) {
+    std::vector<conversion::LayerPrecisionRule> promotions(rules.begin(), rules.begin() + num_promoted);
+    auto eval = evaluator.Evaluate(promotions);
+    LOG_INFO(
+        "Promoting " << num_promoted << " layers: error " << eval.error << ", latency " << eval.latency_ms << " ms");
+    evaluations[num_promoted] = eval;
+    return eval.error <= settings.threshold;
+  };
+
+  auto promotion_count = FindPromotionCount(rules.size(), evaluate);
+  if (!promotion_count) {
+    LOG_WARNING(
+        "Promoting every ranked layer of " << method_name << " to " << settings.promoted_precision
+                                           << " does not meet the threshold of " << settings.threshold);
+  }
+  auto passing = promotion_count ? *promotion_count : rules.size();
+
+  result.promotions.assign(rules.begin(), rules.begin() + passing);
+  result.error = evaluations[passing].error;
+  result.latency_ms = evaluations[passing].latency_ms;
+
+  std::stringstream assignment;
+  for (size_t i = 0; i < passing; i++) {
+    auto& c = ranked[i];
+    assignment << "\n    " << c.value->debugName() << " (" << c.node->kind().toQualString();
+    if (c.node->scope() && !c.node->scope()->isBlank()) {
+      assignment << ", " << c.node->scope()->namesFromRoot();
+    }
+    assignment << "): " << settings.promoted_precision << ", error added " << c.error;
+  }
+  LOG_INFO(
+      "Promoted " << passing << " of " << ranked.size() << " ranked layers of " << method_name << ", the rest stay in "
+                  << base_precision << assignment.str() << "\n  Error: " << result.base_error << " -> "
+                  << result.error << " (threshold " << settings.threshold << ")\n  Latency: " << result.base_latency_ms
+                  << " ms -> " << result.latency_ms << " ms");
+  return result;
+}
+
+} // namespace precision_search
+} // namespace core
+} // namespace trtorch
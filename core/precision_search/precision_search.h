@@ -0,0 +1,87 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ATen/ATen.h"
+#include "core/conversion/conversion.h"
+#include "core/lowering/lowering.h"
+
+namespace trtorch {
+namespace core {
+namespace precision_search {
+
+struct SearchSettings {
+  // Largest acceptable deviation of the outputs of the engine from TorchScript,
+  // relative to the largest magnitude of the TorchScript outputs
+  double threshold = 1e-2;
+  // Precision the most error sensitive layers are promoted to
+  nvinfer1::DataType promoted_precision = nvinfer1::DataType::kFLOAT;
+
+  SearchSettings() = default;
+  friend std::ostream& operator<<(std::ostream& os, const SearchSettings& s);
+};
+
+struct SearchResult {
+  // Rules promoting the selected layers, most sensitive first (a precision
+  // profile, see conversion::WritePrecisionProfile)
+  std::vector<conversion::LayerPrecisionRule> promotions;
+  // Relative error of the outputs and mean latency of a validation batch with
+  // every layer in the operating precision
+  double base_error = 0;
+  double base_latency_ms = 0;
+  // Relative error of the outputs and mean latency of a validation batch with
+  // the promotions applied
+  double error = 0;
+  double latency_ms = 0;
+};
+
+// A node whose outputs are less accurate than its inputs in the operating
+// precision
+struct RankedLayer {
+  const torch::jit::Node* node;
+  // Output of the node with the most error added
+  const torch::jit::Value* value;
+  // Error of the outputs of the node less the error of its inputs
+  double error;
+};
+
+// Attributes to each node of the block the error of its outputs beyond the
+// largest error of its inputs, given the measured relative error of each
+// activation, and returns the nodes adding error, most first. Values without a
+// measured error (aliases, values evaluated during conversion) carry the error
+// of the inputs of the node producing them
+std::vector<RankedLayer> RankLayers(
+    const torch::jit::Block* b,
+    const std::unordered_map<const torch::jit::Value*, double>& measured);
+
+// Finds the smallest number of the top ranked layers for which passes returns
+// true, doubling the count then bisecting (so passes has to be monotonic).
+// Returns nothing if promoting every ranked layer still does not pass
+c10::optional<size_t> FindPromotionCount(size_t num_ranked, const std::function<bool(size_t)>& passes);
+
+// Starting from the operating precision of convert_info (FP16 or INT8), finds
+// the layers to run in a higher precision so that the outputs of the engine
+// stay within settings.threshold of TorchScript on the validation batches.
+//
+// Layers are ranked by the error they add on top of the error of their inputs,
+// measured once by building an engine with every activation marked as an
+// output and comparing each one against the same activation in TorchScript.
+// The smallest number of the top ranked layers meeting the threshold is then
+// found by building engines with more and more of them promoted (doubling, then
+// bisecting, assuming promoting more layers does not increase the error).
+// Batches hold a tensor for each input of the method and need to be on the
+// device of the module
+SearchResult SearchLayerPrecisions(
+    lowering::LoweringCache& lowering_cache,
+    std::string method_name,
+    const std::vector<lowering::passes::InputShapeRange>& input_shapes,
+    conversion::ConversionInfo convert_info,
+    const std::vector<std::vector<at::Tensor>>& validation_batches,
+    SearchSettings settings);
+
+} // namespace precision_search
+} // namespace core
+} // namespace trtorch
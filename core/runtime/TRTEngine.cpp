@@ -54,9 +54,14 @@ TRTEngine::TRTEngine(std::string mod_name, std::string serialized_engine)
     } else {
       outputs++;
       out_binding_map[x] = idx;
+      auto& suffix = util::kInt64OutputSuffix;
+      if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        int64_outputs.insert(idx);
+      }
     }
   }
   num_io = std::make_pair(inputs, outputs);
+  metrics::register_engine(id, name);
 }
 
 TRTEngine& TRTEngine::operator=(const TRTEngine& other) {
@@ -65,6 +70,7 @@ TRTEngine& TRTEngine::operator=(const TRTEngine& other) {
   cuda_engine = other.cuda_engine;
   exec_ctx = other.exec_ctx;
   num_io = other.num_io;
+  int64_outputs = other.int64_outputs;
   return (*this);
 }
 
@@ -88,6 +94,18 @@ static auto TRTORCH_UNUSED TRTEngineTSRegistrtion =
         .def(torch::init<std::string>())
         // TODO: .def("__call__", &TRTEngine::Run)
         // TODO: .def("run", &TRTEngine::Run)
+        .def(
+            "get_metrics",
+            [](const c10::intrusive_ptr<TRTEngine>& self) -> std::string {
+              // Prometheus text of just this engine
+              std::vector<metrics::EngineMetrics> engine_metrics;
+              for (auto& m : metrics::collect_engine_metrics()) {
+                if (m.id == self->id) {
+                  engine_metrics.push_back(std::move(m));
+                }
+              }
+              return metrics::to_prometheus_text(engine_metrics);
+            })
         .def_pickle(
             [](const c10::intrusive_ptr<TRTEngine>& self) -> std::string {
               auto serialized_engine = self->cuda_engine->serialize();
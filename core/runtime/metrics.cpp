@@ -0,0 +1,387 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include "core/runtime/metrics.h"
+#include "core/util/prelude.h"
+
+namespace trtorch {
+namespace core {
+namespace runtime {
+namespace metrics {
+
+const std::vector<double>& latency_bucket_bounds() {
+  static const std::vector<double> bounds = {
+      0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0};
+  return bounds;
+}
+
+namespace {
+constexpr size_t kNumLatencyBuckets = 14;
+// Bounds the number of distinct shape series an engine can produce
+constexpr size_t kMaxInputShapesPerEngine = 64;
+
+struct ShapeKeyHash {
+  size_t operator()(const std::vector<int64_t>& key) const {
+    size_t h = key.size();
+    for (auto d : key) {
+      h ^= std::hash<int64_t>()(d) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    return h;
+  }
+};
+
+// Counters are only ever written by the thread which owns them, so a relaxed
+// load and store is enough and avoids a locked read-modify-write
+inline void bump(std::atomic<uint64_t>& counter, uint64_t value = 1) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline uint64_t read(const std::atomic<uint64_t>& counter) {
+  return counter.load(std::memory_order_relaxed);
+}
+} // namespace
+
+struct EngineCounters {
+  std::atomic<uint64_t> num_calls{0};
+  std::atomic<uint64_t> num_errors{0};
+  std::atomic<uint64_t> input_bytes{0};
+  std::atomic<uint64_t> output_bytes{0};
+  std::atomic<uint64_t> latency_sum_ns{0};
+  std::array<std::atomic<uint64_t>, kNumLatencyBuckets> latency_buckets{};
+  std::atomic<uint64_t> other_input_shapes{0};
+  // Inserted into by the owning thread with the shard mutex held, read by the
+  // collector with the same mutex held
+  std::mutex* shard_mutex;
+  std::unordered_map<std::vector<int64_t>, std::unique_ptr<std::atomic<uint64_t>>, ShapeKeyHash> input_shapes;
+};
+
+namespace {
+struct ThreadShard {
+  std::mutex mutex;
+  std::unordered_map<EngineID, std::unique_ptr<EngineCounters>> engines;
+};
+
+std::string format_shape_key(const std::vector<int64_t>& key) {
+  std::stringstream ss;
+  bool new_dim = false;
+  for (auto d : key) {
+    if (d == -1) {
+      ss << ';';
+      new_dim = false;
+    } else {
+      if (new_dim) {
+        ss << 'x';
+      }
+      ss << d;
+      new_dim = true;
+    }
+  }
+  auto s = ss.str();
+  if (!s.empty() && s.back() == ';') {
+    s.pop_back();
+  }
+  return s;
+}
+
+void accumulate(EngineMetrics& m, const EngineCounters& c) {
+  m.num_calls += read(c.num_calls);
+  m.num_errors += read(c.num_errors);
+  m.input_bytes += read(c.input_bytes);
+  m.output_bytes += read(c.output_bytes);
+  m.latency_sum += read(c.latency_sum_ns) / 1e9;
+  m.latency_buckets.resize(kNumLatencyBuckets, 0);
+  for (size_t i = 0; i < kNumLatencyBuckets; i++) {
+    m.latency_buckets[i] += read(c.latency_buckets[i]);
+  }
+  for (auto& s : c.input_shapes) {
+    m.input_shapes[format_shape_key(s.first)] += read(*s.second);
+  }
+  if (read(c.other_input_shapes) > 0) {
+    m.input_shapes["other"] += read(c.other_input_shapes);
+  }
+}
+
+class MetricsRegistry {
+ public:
+  void RegisterEngine(EngineID id, std::string name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    engine_names_[id] = std::move(name);
+  }
+
+  std::shared_ptr<ThreadShard> AddShard() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto shard = std::make_shared<ThreadShard>();
+    shards_.push_back(shard);
+    return shard;
+  }
+
+  // Called on thread exit so counts recorded by short lived threads survive
+  void RetireShard(const std::shared_ptr<ThreadShard>& shard) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    {
+      std::lock_guard<std::mutex> shard_lock(shard->mutex);
+      for (auto& e : shard->engines) {
+        accumulate(retired_[e.first], *e.second);
+      }
+    }
+    shards_.erase(std::remove(shards_.begin(), shards_.end(), shard), shards_.end());
+  }
+
+  std::vector<EngineMetrics> Collect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto totals = retired_;
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> shard_lock(shard->mutex);
+      for (auto& e : shard->engines) {
+        accumulate(totals[e.first], *e.second);
+      }
+    }
+
+    std::vector<EngineMetrics> engine_metrics;
+    engine_metrics.reserve(totals.size());
+    for (auto& t : totals) {
+      t.second.id = t.first;
+      auto name = engine_names_.find(t.first);
+      t.second.name = name != engine_names_.end() ? name->second : "unknown_engine";
+      engine_metrics.push_back(std::move(t.second));
+    }
+    std::sort(engine_metrics.begin(), engine_metrics.end(), [](const EngineMetrics& a, const EngineMetrics& b) {
+      return a.name != b.name ? a.name < b.name : a.id < b.id;
+    });
+    return engine_metrics;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<EngineID, std::string> engine_names_;
+  std::vector<std::shared_ptr<ThreadShard>> shards_;
+  std::unordered_map<EngineID, EngineMetrics> retired_;
+};
+
+MetricsRegistry& get_metrics_registry() {
+  // Intentionally leaked so threads exiting during static destruction can
+  // still retire their shards
+  static MetricsRegistry* registry = new MetricsRegistry();
+  return *registry;
+}
+
+struct ThreadShardHandle {
+  ThreadShardHandle() : shard(get_metrics_registry().AddShard()) {}
+  ~ThreadShardHandle() {
+    get_metrics_registry().RetireShard(shard);
+  }
+  std::shared_ptr<ThreadShard> shard;
+};
+
+EngineCounters& get_thread_engine_counters(EngineID id) {
+  static thread_local ThreadShardHandle handle;
+  auto& shard = *handle.shard;
+  // Only this thread inserts into the shard so the lookup does not need the lock
+  auto it = shard.engines.find(id);
+  if (it != shard.engines.end()) {
+    return *it->second;
+  }
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto& counters = shard.engines[id];
+  counters = std::make_unique<EngineCounters>();
+  counters->shard_mutex = &shard.mutex;
+  return *counters;
+}
+
+std::string escape_label(const std::string& value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (auto c : value) {
+    if (c == '\\' || c == '"') {
+      escaped += '\\';
+      escaped += c;
+    } else if (c == '\n') {
+      escaped += "\\n";
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+} // namespace
+
+ExecutionRecord::ExecutionRecord(EngineID id)
+    : counters_(&get_thread_engine_counters(id)), start_(std::chrono::steady_clock::now()) {
+  shape_key_.reserve(16);
+}
+
+ExecutionRecord::~ExecutionRecord() {
+  if (!completed_) {
+    bump(counters_->num_calls);
+    bump(counters_->num_errors);
+  }
+}
+
+void ExecutionRecord::add_input(const nvinfer1::Dims& dims, uint64_t nbytes) {
+  for (int i = 0; i < dims.nbDims; i++) {
+    shape_key_.push_back(dims.d[i]);
+  }
+  shape_key_.push_back(-1);
+  input_bytes_ += nbytes;
+}
+
+void ExecutionRecord::add_output(uint64_t nbytes) {
+  output_bytes_ += nbytes;
+}
+
+void ExecutionRecord::complete() {
+  auto latency_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+  completed_ = true;
+
+  bump(counters_->num_calls);
+  bump(counters_->input_bytes, input_bytes_);
+  bump(counters_->output_bytes, output_bytes_);
+  bump(counters_->latency_sum_ns, latency_ns);
+
+  auto& bounds = latency_bucket_bounds();
+  size_t bucket = 0;
+  while (bucket < bounds.size() && latency_ns > bounds[bucket] * 1e9) {
+    bucket++;
+  }
+  bump(counters_->latency_buckets[bucket]);
+
+  auto shape = counters_->input_shapes.find(shape_key_);
+  if (shape != counters_->input_shapes.end()) {
+    bump(*shape->second);
+  } else if (counters_->input_shapes.size() < kMaxInputShapesPerEngine) {
+    std::lock_guard<std::mutex> lock(*counters_->shard_mutex);
+    counters_->input_shapes.emplace(shape_key_, std::make_unique<std::atomic<uint64_t>>(1));
+  } else {
+    bump(counters_->other_input_shapes);
+  }
+}
+
+void register_engine(EngineID id, std::string name) {
+  get_metrics_registry().RegisterEngine(id, std::move(name));
+}
+
+std::vector<EngineMetrics> collect_engine_metrics() {
+  return get_metrics_registry().Collect();
+}
+
+std::string to_prometheus_text(const std::vector<EngineMetrics>& engine_metrics) {
+  std::stringstream ss;
+  ss << std::setprecision(9);
+  auto labels = [](const EngineMetrics& m) {
+    return std::string("engine=\"") + escape_label(m.name) + "\",id=\"" + std::to_string(m.id) + '"';
+  };
+  auto header = [&](const char* name, const char* type, const char* help) {
+    ss << "# HELP " << name << ' ' << help << '\n' << "# TYPE " << name << ' ' << type << '\n';
+  };
+
+  header("trtorch_engine_calls_total", "counter", "Number of times the engine was executed");
+  for (auto& m : engine_metrics) {
+    ss << "trtorch_engine_calls_total{" << labels(m) << "} " << m.num_calls << '\n';
+  }
+
+  header("trtorch_engine_errors_total", "counter", "Number of executions of the engine which failed");
+  for (auto& m : engine_metrics) {
+    ss << "trtorch_engine_errors_total{" << labels(m) << "} " << m.num_errors << '\n';
+  }
+
+  header("trtorch_engine_transferred_bytes_total", "counter", "Bytes of input and output tensors bound to the engine");
+  for (auto& m : engine_metrics) {
+    ss << "trtorch_engine_transferred_bytes_total{" << labels(m) << ",direction=\"input\"} " << m.input_bytes << '\n';
+    ss << "trtorch_engine_transferred_bytes_total{" << labels(m) << ",direction=\"output\"} " << m.output_bytes
+       << '\n';
+  }
+
+  header(
+      "trtorch_engine_latency_seconds",
+      "histogram",
+      "Host side latency of successful executions of the engine, from entry to enqueue");
+  auto& bounds = latency_bucket_bounds();
+  for (auto& m : engine_metrics) {
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < m.latency_buckets.size(); i++) {
+      cumulative += m.latency_buckets[i];
+      ss << "trtorch_engine_latency_seconds_bucket{" << labels(m) << ",le=\"";
+      if (i < bounds.size()) {
+        ss << bounds[i];
+      } else {
+        ss << "+Inf";
+      }
+      ss << "\"} " << cumulative << '\n';
+    }
+    ss << "trtorch_engine_latency_seconds_sum{" << labels(m) << "} " << m.latency_sum << '\n';
+    ss << "trtorch_engine_latency_seconds_count{" << labels(m) << "} " << cumulative << '\n';
+  }
+
+  header(
+      "trtorch_engine_input_shape_calls_total", "counter", "Number of successful executions per set of input shapes");
+  for (auto& m : engine_metrics) {
+    for (auto& s : m.input_shapes) {
+      ss << "trtorch_engine_input_shape_calls_total{" << labels(m) << ",shape=\"" << s.first << "\"} " << s.second
+         << '\n';
+    }
+  }
+
+  return ss.str();
+}
+
+void write_prometheus_text(std::string path) {
+  auto text = to_prometheus_text(collect_engine_metrics());
+
+  const std::string socket_prefix = "unix:";
+  if (path.compare(0, socket_prefix.size(), socket_prefix) == 0) {
+    auto socket_path = path.substr(socket_prefix.size());
+    sockaddr_un addr{};
+    TRTORCH_CHECK(
+        socket_path.size() < sizeof(addr.sun_path), "Metrics socket path " << socket_path << " is too long");
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    TRTORCH_CHECK(fd >= 0, "Unable to create socket to write metrics to " << socket_path);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+      close(fd);
+      TRTORCH_THROW_ERROR("Unable to connect to metrics socket " << socket_path << ": " << std::strerror(errno));
+    }
+    size_t written = 0;
+    while (written < text.size()) {
+      auto n = ::write(fd, text.data() + written, text.size() - written);
+      if (n <= 0) {
+        close(fd);
+        TRTORCH_THROW_ERROR("Failed writing metrics to socket " << socket_path << ": " << std::strerror(errno));
+      }
+      written += static_cast<size_t>(n);
+    }
+    close(fd);
+    LOG_DEBUG("Wrote runtime metrics to socket " << socket_path);
+    return;
+  }
+
+  auto tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::trunc);
+    TRTORCH_CHECK(out.good(), "Unable to open " << tmp_path << " to write metrics");
+    out << text;
+    TRTORCH_CHECK(out.good(), "Failed writing metrics to " << tmp_path);
+  }
+  TRTORCH_CHECK(std::rename(tmp_path.c_str(), path.c_str()) == 0, "Unable to move metrics file into place at " << path);
+  LOG_DEBUG("Wrote runtime metrics to " << path);
+}
+
+} // namespace metrics
+} // namespace runtime
+} // namespace core
+} // namespace trtorch
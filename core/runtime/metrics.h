@@ -0,0 +1,74 @@
+#pragma once
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "NvInfer.h"
+
+namespace trtorch {
+namespace core {
+namespace runtime {
+namespace metrics {
+
+using EngineID = int64_t;
+
+// Upper bounds (in seconds) of the execution latency histogram buckets, the
+// last bucket is +Inf
+const std::vector<double>& latency_bucket_bounds();
+
+// Snapshot of everything recorded for an engine, summed across threads
+struct EngineMetrics {
+  EngineID id;
+  std::string name;
+  uint64_t num_calls = 0;
+  uint64_t num_errors = 0;
+  uint64_t input_bytes = 0;
+  uint64_t output_bytes = 0;
+  // Non cumulative counts, one more than latency_bucket_bounds() for +Inf
+  std::vector<uint64_t> latency_buckets;
+  double latency_sum = 0;
+  // Keyed by the input shapes of a call ex. "1x3x224x224;1x10", calls with
+  // shapes beyond the per engine limit are counted under "other"
+  std::map<std::string, uint64_t> input_shapes;
+};
+
+struct EngineCounters;
+
+// Records a single call to execute_engine. Counters are owned by the calling
+// thread so recording never takes a lock or contends with other threads,
+// they are only aggregated when metrics are collected. A call which is never
+// completed (i.e. execute_engine threw) is counted as an error
+class ExecutionRecord {
+ public:
+  ExecutionRecord(EngineID id);
+  ~ExecutionRecord();
+  void add_input(const nvinfer1::Dims& dims, uint64_t nbytes);
+  void add_output(uint64_t nbytes);
+  void complete();
+
+ private:
+  EngineCounters* counters_;
+  std::chrono::steady_clock::time_point start_;
+  std::vector<int64_t> shape_key_;
+  uint64_t input_bytes_ = 0;
+  uint64_t output_bytes_ = 0;
+  bool completed_ = false;
+};
+
+void register_engine(EngineID id, std::string name);
+
+std::vector<EngineMetrics> collect_engine_metrics();
+
+// Prometheus text exposition format of the collected metrics
+std::string to_prometheus_text(const std::vector<EngineMetrics>& engine_metrics);
+
+// Writes to_prometheus_text(collect_engine_metrics()) to a file (atomically
+// replacing it so a textfile collector never sees a partial scrape) or, for
+// paths of the form "unix:/path/to/socket", to a local unix domain socket
+void write_prometheus_text(std::string path);
+
+} // namespace metrics
+} // namespace runtime
+} // namespace core
+} // namespace trtorch
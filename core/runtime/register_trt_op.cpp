@@ -1,3 +1,7 @@
+#include <cstdlib>
+#include <limits>
+#include <string>
+
 #include "c10/cuda/CUDAStream.h"
 
 #include "torch/csrc/jit/runtime/custom_operator.h"
@@ -9,9 +13,23 @@
 namespace trtorch {
 namespace core {
 namespace runtime {
+namespace {
+// Checking that int64 inputs fit in int32 synchronizes the stream, so it is
+// only done when TRTORCH_CHECK_INT64_INPUTS is set
+bool check_int64_inputs() {
+  static const bool enabled = []() {
+    auto env = std::getenv("TRTORCH_CHECK_INT64_INPUTS");
+    return env != nullptr && std::string(env) != "" && std::string(env) != "0";
+  }();
+  return enabled;
+}
+} // namespace
 
 std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intrusive_ptr<TRTEngine> compiled_engine) {
+  TRTORCH_TRACE_SCOPE("execute_engine", "runtime");
   LOG_DEBUG("Attempting to run engine (ID: " << compiled_engine->name << ")");
+  // Counts this call as an error unless it reaches complete()
+  metrics::ExecutionRecord record(compiled_engine->id);
   std::vector<void*> gpu_handles;
 
   std::vector<at::Tensor> contig_inputs{};
@@ -23,13 +41,30 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
         inputs[pyt_idx].is_cuda(),
         "Expected input tensors to have device cuda, found device " << inputs[pyt_idx].device());
     auto expected_type = util::toATenDType(compiled_engine->exec_ctx->getEngine().getBindingDataType(i));
+    auto in = inputs[pyt_idx];
+    if (expected_type == at::kInt && in.scalar_type() == at::kLong) {
+      // Integer inputs were narrowed to int32 at compile time, narrow on device.
+      // Values are assumed to fit, values which do not would silently wrap
+      if (check_int64_inputs() && in.numel() > 0) {
+        auto out_of_range =
+            in.lt(std::numeric_limits<int32_t>::min()).logical_or(in.gt(std::numeric_limits<int32_t>::max()));
+        TRTORCH_CHECK(
+            !out_of_range.any().item<bool>(),
+            "Input " << pyt_idx << " has int64 values which do not fit in int32, the engine was built for int32");
+      }
+      in = in.to(at::kInt);
+    }
     TRTORCH_CHECK(
-        inputs[pyt_idx].dtype() == expected_type,
-        "Expected input tensors to have type " << expected_type << ", found type " << inputs[pyt_idx].dtype());
-    auto dims = core::util::toDimsPad(inputs[pyt_idx].sizes(), 1);
+        in.dtype() == expected_type,
+        "Expected input tensors to have type " << expected_type << ", found type " << in.dtype());
+    auto dims = core::util::toDimsPad(in.sizes(), 1);
     auto shape = core::util::toVec(dims);
-    contig_inputs.push_back(inputs[pyt_idx].view(shape).contiguous());
+    {
+      TRTORCH_TRACE_SCOPE("make_input_contiguous", "runtime");
+      contig_inputs.push_back(in.view(shape).contiguous());
+    }
     LOG_DEBUG("Input shape: " << dims);
+    record.add_input(dims, contig_inputs.back().nbytes());
     compiled_engine->exec_ctx->setBindingDimensions(i, dims);
     gpu_handles.push_back(contig_inputs.back().data_ptr());
   }
@@ -40,16 +75,27 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
   std::vector<at::Tensor> outputs(compiled_engine->num_io.second);
   for (size_t o = inputs.size(); o < (compiled_engine->num_io.first + compiled_engine->num_io.second); o++) {
     uint64_t pyt_idx = compiled_engine->out_binding_map[o];
+    TRTORCH_TRACE_SCOPE("allocate_output", "runtime");
     auto out_shape = compiled_engine->exec_ctx->getBindingDimensions(o);
     LOG_DEBUG("Output shape: " << out_shape);
     auto dims = core::util::toVec(out_shape);
     auto type = util::toATenDType(compiled_engine->exec_ctx->getEngine().getBindingDataType(o));
     outputs[pyt_idx] = std::move(at::empty(dims, {at::kCUDA}).to(type).contiguous());
+    record.add_output(outputs[pyt_idx].nbytes());
     gpu_handles.push_back(outputs[pyt_idx].data_ptr());
   }
 
   c10::cuda::CUDAStream stream = c10::cuda::getCurrentCUDAStream(inputs[0].device().index());
-  compiled_engine->exec_ctx->enqueueV2(gpu_handles.data(), stream, nullptr);
+  {
+    TRTORCH_TRACE_SCOPE("enqueue", "runtime");
+    TRTORCH_CHECK(
+        compiled_engine->exec_ctx->enqueueV2(gpu_handles.data(), stream, nullptr),
+        "Failed to enqueue engine " << compiled_engine->name);
+  }
+  for (auto idx : compiled_engine->int64_outputs) {
+    outputs[idx] = outputs[idx].to(at::kLong);
+  }
+  record.complete();
 
   return outputs;
 }
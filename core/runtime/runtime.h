@@ -1,7 +1,9 @@
 #pragma once
+#include <unordered_set>
 #include <utility>
 #include "ATen/core/function_schema.h"
 #include "NvInfer.h"
+#include "core/runtime/metrics.h"
 #include "core/util/prelude.h"
 #include "torch/custom_class.h"
 
@@ -23,6 +25,8 @@ struct TRTEngine : torch::CustomClassHolder {
 
   std::unordered_map<uint64_t, uint64_t> in_binding_map;
   std::unordered_map<uint64_t, uint64_t> out_binding_map;
+  // Outputs produced as int32 which are returned as int64
+  std::unordered_set<uint64_t> int64_outputs;
 
   ~TRTEngine();
   TRTEngine(std::string serialized_engine);
@@ -3,6 +3,7 @@
 #include <sstream>
 #include <string>
 
+#include "torch/csrc/jit/ir/constants.h"
 #include "torch/csrc/jit/ir/ir.h"
 
 namespace trtorch {
@@ -25,6 +26,24 @@ inline std::string schema_info(const torch::jit::FunctionSchema* s) {
   return schema_info;
 }
 
+// TensorRT has no int64, so lowering narrows int64 tensors to int32 and casts
+// the values which were int64 at the outputs of the graph back with an aten::to
+// right before they are returned. Those casts are tagged with this attribute so
+// they can be told apart from casts to int64 which were in the source graph
+inline torch::jit::Symbol int64OutputCastAttr() {
+  static const auto attr = c10::Symbol::attr("trtorch_int64_output");
+  return attr;
+}
+
+inline void markInt64OutputCast(torch::jit::Node* n) {
+  n->i_(int64OutputCastAttr(), 1);
+}
+
+// The engine produces the int32 value, the cast is applied by the runtime
+inline bool isInt64OutputCast(const torch::jit::Node* n) {
+  return n->kind() == torch::jit::aten::to && n->hasAttribute(int64OutputCastAttr());
+}
+
 inline std::vector<int64_t> toVec(c10::IntArrayRef a) {
   std::vector<int64_t> arr;
   for (auto i : a) {
@@ -1,7 +1,15 @@
 #include "core/util/logging/TRTorchLogger.h"
 
+#include <pthread.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #define TERM_NORMAL "\033[0m";
 #define TERM_RED "\033[0;31m";
@@ -16,6 +24,131 @@ namespace trt = nvinfer1;
 namespace util {
 namespace logging {
 
+namespace {
+
+// Set in the child after a fork, the child has no writer thread and the mutex
+// may have been held by a thread which does not exist in it
+std::atomic<bool> in_forked_child(false);
+
+// Formatted lines are handed off to a background thread which does the actual
+// write to stderr, so logging threads (ex. the one running execute_engine) do
+// not block on terminal I/O. Pending lines are held in a fixed size ring and
+// new info, debug and graph lines are dropped (and counted) rather than blocking
+// when it fills up. Warnings and errors are never dropped, they are written
+// directly once everything logged before them has been written
+class AsyncLogSink {
+ public:
+  AsyncLogSink(size_t capacity) : ring_(capacity) {
+    pthread_atfork(nullptr, nullptr, []() { in_forked_child = true; });
+    writer_ = std::thread([this]() { drain(); });
+  }
+
+  void write(std::string line, LogLevel lvl) {
+    if (in_forked_child) {
+      std::cerr << line << std::flush;
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopped_) {
+      // Process is shutting down, write synchronously
+      std::cerr << line << std::flush;
+      return;
+    }
+
+    if (lvl <= LogLevel::kWARNING) {
+      // Errors are usually followed by an exception or abort, so they (and
+      // everything before them) have to reach the terminal. Holding the lock
+      // keeps the writer from starting on lines logged after this one
+      drained_.wait(lock, [this]() { return size_ == 0 && !writing_; });
+      std::cerr << line << std::flush;
+      return;
+    }
+
+    if (size_ == ring_.size()) {
+      num_dropped_++;
+    } else {
+      ring_[(head_ + size_) % ring_.size()] = std::move(line);
+      size_++;
+      pending_.notify_one();
+    }
+  }
+
+  void shutdown() {
+    if (in_forked_child) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopped_) {
+        return;
+      }
+      stopped_ = true;
+    }
+    pending_.notify_one();
+    writer_.join();
+  }
+
+ private:
+  void drain() {
+    std::vector<std::string> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      pending_.wait(lock, [this]() { return size_ != 0 || stopped_; });
+      if (size_ == 0 && stopped_) {
+        break;
+      }
+
+      batch.clear();
+      for (; size_ > 0; size_--) {
+        batch.push_back(std::move(ring_[head_]));
+        head_ = (head_ + 1) % ring_.size();
+      }
+      auto num_dropped = num_dropped_;
+      num_dropped_ = 0;
+      writing_ = true;
+      lock.unlock();
+
+      for (auto& l : batch) {
+        std::cerr << l;
+      }
+      if (num_dropped > 0) {
+        std::cerr << "WARNING: [TRTorch] - Log buffer full, dropped " << num_dropped
+                  << " info / debug / graph messages\n";
+      }
+      std::cerr << std::flush;
+
+      lock.lock();
+      writing_ = false;
+      drained_.notify_all();
+    }
+  }
+
+  std::vector<std::string> ring_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+  uint64_t num_dropped_ = 0;
+  bool writing_ = false;
+  bool stopped_ = false;
+  std::mutex mutex_;
+  std::condition_variable pending_;
+  std::condition_variable drained_;
+  std::thread writer_;
+};
+
+AsyncLogSink& get_log_sink() {
+  // Intentionally leaked so loggers used during static destruction still have
+  // somewhere to write, pending lines are flushed at exit instead
+  static AsyncLogSink* sink = []() {
+    auto s = new AsyncLogSink(4096);
+    std::atexit([]() { get_log_sink().shutdown(); });
+    return s;
+  }();
+  return *sink;
+}
+
+} // namespace
+
 TRTorchLogger::TRTorchLogger(std::string prefix, Severity severity, bool color)
     : prefix_(prefix), reportable_severity_((LogLevel)severity), color_(color) {}
 
@@ -28,25 +161,26 @@ void TRTorchLogger::log(LogLevel lvl, std::string msg) {
     return;
   }
 
+  std::stringstream ss;
   if (color_) {
     switch (lvl) {
       case LogLevel::kINTERNAL_ERROR:
-        std::cerr << TERM_RED;
+        ss << TERM_RED;
         break;
       case LogLevel::kERROR:
-        std::cerr << TERM_RED;
+        ss << TERM_RED;
         break;
       case LogLevel::kWARNING:
-        std::cerr << TERM_YELLOW;
+        ss << TERM_YELLOW;
         break;
       case LogLevel::kINFO:
-        std::cerr << TERM_GREEN;
+        ss << TERM_GREEN;
         break;
       case LogLevel::kDEBUG:
-        std::cerr << TERM_MAGENTA;
+        ss << TERM_MAGENTA;
         break;
       case LogLevel::kGRAPH:
-        std::cerr << TERM_NORMAL;
+        ss << TERM_NORMAL;
         break;
       default:
         break;
@@ -55,33 +189,35 @@ void TRTorchLogger::log(LogLevel lvl, std::string msg) {
 
   switch (lvl) {
     case LogLevel::kINTERNAL_ERROR:
-      std::cerr << "INTERNAL_ERROR: ";
+      ss << "INTERNAL_ERROR: ";
       break;
     case LogLevel::kERROR:
-      std::cerr << "ERROR: ";
+      ss << "ERROR: ";
       break;
     case LogLevel::kWARNING:
-      std::cerr << "WARNING: ";
+      ss << "WARNING: ";
       break;
     case LogLevel::kINFO:
-      std::cerr << "INFO: ";
+      ss << "INFO: ";
       break;
     case LogLevel::kDEBUG:
-      std::cerr << "DEBUG: ";
+      ss << "DEBUG: ";
       break;
     case LogLevel::kGRAPH:
-      std::cerr << "GRAPH: ";
+      ss << "GRAPH: ";
       break;
     default:
-      std::cerr << "UNKNOWN: ";
+      ss << "UNKNOWN: ";
       break;
   }
 
   if (color_) {
-    std::cerr << TERM_NORMAL;
+    ss << TERM_NORMAL;
   }
 
-  std::cerr << prefix_ << msg << std::endl;
+  ss << prefix_ << msg << '\n';
+
+  get_log_sink().write(ss.str(), lvl);
 }
 
 void TRTorchLogger::log(Severity severity, const char* msg) {
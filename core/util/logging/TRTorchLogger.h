@@ -33,6 +33,11 @@ class TRTorchLogger : public nvinfer1::ILogger {
   LogLevel get_reportable_log_level();
   bool get_is_colored_output_on();
 
+  // Checked by the logging macros before a message is formatted so keep inline
+  inline bool is_reportable_log_level(LogLevel lvl) {
+    return lvl <= reportable_severity_;
+  }
+
  private:
   std::string prefix_;
   LogLevel reportable_severity_;
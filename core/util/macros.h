@@ -4,11 +4,21 @@
 
 #define GET_MACRO(_1, _2, NAME, ...) NAME
 
-#define TRTORCH_LOG(l, sev, msg) \
-  do {                           \
-    std::stringstream ss{};      \
-    ss << msg;                   \
-    l.log(sev, ss.str());        \
+// Most verbose level which is compiled in, messages above it are stripped from
+// the binary entirely. Defaults to keeping every level, build with
+// --define strip_debug_logs=true to drop kDEBUG and kGRAPH messages
+#ifndef TRTORCH_COMPILED_LOG_LEVEL
+#define TRTORCH_COMPILED_LOG_LEVEL 5 // LogLevel::kGRAPH
+#endif
+
+// The message is only formatted if the logger would report it
+#define TRTORCH_LOG(l, sev, msg)                                                                   \
+  do {                                                                                             \
+    if (static_cast<int>(sev) <= TRTORCH_COMPILED_LOG_LEVEL && (l).is_reportable_log_level(sev)) { \
+      std::stringstream ss{};                                                                      \
+      ss << msg;                                                                                   \
+      (l).log(sev, ss.str());                                                                      \
+    }                                                                                              \
   } while (0)
 
 #define LOG_GRAPH_GLOBAL(s) TRTORCH_LOG(core::util::logging::get_logger(), core::util::logging::LogLevel::kGRAPH, s)
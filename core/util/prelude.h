@@ -7,4 +7,5 @@
 #include "core/util/jit_util.h"
 #include "core/util/logging/TRTorchLogger.h"
 #include "core/util/macros.h"
+#include "core/util/trace.h"
 #include "core/util/trt_util.h"
@@ -0,0 +1,244 @@
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#ifdef TRTORCH_USE_NVTX
+#include "nvToolsExt.h"
+#endif
+
+#include "core/util/macros.h"
+#include "core/util/trace.h"
+
+namespace trtorch {
+namespace core {
+namespace util {
+namespace trace {
+
+namespace detail {
+std::atomic<bool> tracing_enabled(false);
+} // namespace detail
+
+namespace {
+struct Event {
+  std::string name;
+  const char* category;
+  uint64_t start_ns;
+  uint64_t dur_ns;
+};
+
+struct ThreadBuffer {
+  uint64_t tid;
+  // Only contended while the trace is being dumped or cleared
+  std::mutex mutex;
+  std::vector<Event> events;
+};
+
+uint64_t now_ns() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+class TraceRegistry {
+ public:
+  std::shared_ptr<ThreadBuffer> AddBuffer() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto buffer = std::make_shared<ThreadBuffer>();
+    buffer->tid = next_tid_++;
+    buffers_.push_back(buffer);
+    return buffer;
+  }
+
+  // Buffers of exited threads are kept until the next clear so their spans
+  // still show up in the dump
+  void RetireBuffer(const std::shared_ptr<ThreadBuffer>& buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.erase(std::remove(buffers_.begin(), buffers_.end(), buffer), buffers_.end());
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    if (!buffer->events.empty()) {
+      retired_.push_back(buffer);
+    }
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& b : buffers_) {
+      std::lock_guard<std::mutex> buffer_lock(b->mutex);
+      b->events.clear();
+    }
+    retired_.clear();
+  }
+
+  std::map<std::string, SpanSummary> Summarize() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, SpanSummary> summaries;
+    auto summarize_buffer = [&](const std::shared_ptr<ThreadBuffer>& b) {
+      std::lock_guard<std::mutex> buffer_lock(b->mutex);
+      for (auto& e : b->events) {
+        auto& s = summaries[e.name];
+        s.category = e.category;
+        s.count++;
+        s.total_ns += e.dur_ns;
+      }
+    };
+    for (auto& b : retired_) {
+      summarize_buffer(b);
+    }
+    for (auto& b : buffers_) {
+      summarize_buffer(b);
+    }
+    return summaries;
+  }
+
+  std::string ToJSON() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto pid = getpid();
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto write_buffer = [&](const std::shared_ptr<ThreadBuffer>& b) {
+      std::lock_guard<std::mutex> buffer_lock(b->mutex);
+      for (auto& e : b->events) {
+        ss << (first ? "\n" : ",\n");
+        first = false;
+        ss << "{\"name\":\"" << escape(e.name) << "\",\"cat\":\"" << e.category << "\",\"ph\":\"X\",\"ts\":"
+           << e.start_ns / 1e3 << ",\"dur\":" << e.dur_ns / 1e3 << ",\"pid\":" << pid << ",\"tid\":" << b->tid << '}';
+      }
+    };
+    for (auto& b : retired_) {
+      write_buffer(b);
+    }
+    for (auto& b : buffers_) {
+      write_buffer(b);
+    }
+    ss << "\n]}\n";
+    return ss.str();
+  }
+
+ private:
+  static std::string escape(const std::string& s) {
+    std::string escaped;
+    escaped.reserve(s.size());
+    for (auto c : s) {
+      if (c == '"' || c == '\\') {
+        escaped += '\\';
+        escaped += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        escaped += ' ';
+      } else {
+        escaped += c;
+      }
+    }
+    return escaped;
+  }
+
+  std::mutex mutex_;
+  uint64_t next_tid_ = 0;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+  std::vector<std::shared_ptr<ThreadBuffer>> retired_;
+};
+
+TraceRegistry& get_trace_registry() {
+  // Intentionally leaked so threads exiting during static destruction can
+  // still retire their buffers
+  static TraceRegistry* registry = new TraceRegistry();
+  return *registry;
+}
+
+struct ThreadBufferHandle {
+  ThreadBufferHandle() : buffer(get_trace_registry().AddBuffer()) {}
+  ~ThreadBufferHandle() {
+    get_trace_registry().RetireBuffer(buffer);
+  }
+  std::shared_ptr<ThreadBuffer> buffer;
+};
+
+ThreadBuffer& get_thread_buffer() {
+  static thread_local ThreadBufferHandle handle;
+  return *handle.buffer;
+}
+
+std::string& env_trace_path() {
+  static std::string path;
+  return path;
+}
+
+// Tracing requested through the environment is started on load and dumped
+// when the process exits
+bool enable_from_env() {
+  auto path = std::getenv("TRTORCH_TRACE");
+  if (path == nullptr || std::string(path).empty()) {
+    return false;
+  }
+  env_trace_path() = path;
+  enable();
+  std::atexit([]() {
+    try {
+      dump(env_trace_path());
+    } catch (std::exception& e) {
+      LOG_ERROR(e.what());
+    }
+  });
+  return true;
+}
+
+static bool TRTORCH_UNUSED enabled_from_env = enable_from_env();
+} // namespace
+
+void Span::begin(const char* name, const char* category) {
+  active_ = true;
+  name_ = name;
+  category_ = category;
+#ifdef TRTORCH_USE_NVTX
+  nvtxRangePushA(name);
+#endif
+  start_ns_ = now_ns();
+}
+
+void Span::end() {
+  auto end_ns = now_ns();
+#ifdef TRTORCH_USE_NVTX
+  nvtxRangePop();
+#endif
+  auto& buffer = get_thread_buffer();
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  buffer.events.push_back({std::move(name_), category_, start_ns_, end_ns - start_ns_});
+}
+
+void enable() {
+  // Pin the trace epoch before the first span
+  now_ns();
+  detail::tracing_enabled.store(true, std::memory_order_relaxed);
+}
+
+void disable() {
+  detail::tracing_enabled.store(false, std::memory_order_relaxed);
+}
+
+void clear() {
+  get_trace_registry().Clear();
+}
+
+void dump(std::string path) {
+  std::ofstream out(path, std::ios::trunc);
+  TRTORCH_CHECK(out.good(), "Unable to open " << path << " to write trace");
+  out << get_trace_registry().ToJSON();
+  TRTORCH_CHECK(out.good(), "Failed writing trace to " << path);
+}
+
+std::map<std::string, SpanSummary> summarize() {
+  return get_trace_registry().Summarize();
+}
+
+} // namespace trace
+} // namespace util
+} // namespace core
+} // namespace trtorch
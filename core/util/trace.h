@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <string>
+
+namespace trtorch {
+namespace core {
+namespace util {
+namespace trace {
+
+namespace detail {
+extern std::atomic<bool> tracing_enabled;
+} // namespace detail
+
+// Checked by every span before doing any work so tracing costs a relaxed load
+// when it is off
+inline bool is_enabled() {
+  return detail::tracing_enabled.load(std::memory_order_relaxed);
+}
+
+// Starts recording spans. Setting the environment variable TRTORCH_TRACE to a
+// path enables tracing on load and dumps the trace there on exit
+void enable();
+void disable();
+
+// Drops all spans recorded so far
+void clear();
+
+// Writes all recorded spans as Chrome trace event JSON, viewable in
+// chrome://tracing or Perfetto
+void dump(std::string path);
+
+// Number of spans recorded under a name and their total duration, summed
+// across threads
+struct SpanSummary {
+  std::string category;
+  uint64_t count = 0;
+  uint64_t total_ns = 0;
+};
+
+std::map<std::string, SpanSummary> summarize();
+
+// Records the time between construction and destruction as a complete event
+// on the timeline of the current thread (and as an NVTX range if TRTorch was
+// built with NVTX). Spans started while tracing is off are never recorded
+class Span {
+ public:
+  Span(const char* name, const char* category) {
+    if (is_enabled()) {
+      begin(name, category);
+    }
+  }
+  ~Span() {
+    if (active_) {
+      end();
+    }
+  }
+  Span(const Span&) = delete;
+  Span& operator=(const Span&) = delete;
+
+ private:
+  void begin(const char* name, const char* category);
+  void end();
+
+  bool active_ = false;
+  const char* category_;
+  std::string name_;
+  uint64_t start_ns_;
+};
+
+} // namespace trace
+} // namespace util
+} // namespace core
+} // namespace trtorch
+
+#define TRTORCH_TRACE_CONCAT_IMPL(a, b) a##b
+#define TRTORCH_TRACE_CONCAT(a, b) TRTORCH_TRACE_CONCAT_IMPL(a, b)
+#define TRTORCH_TRACE_SCOPE(name, category) \
+  trtorch::core::util::trace::Span TRTORCH_TRACE_CONCAT(trace_span_, __LINE__)(name, category)
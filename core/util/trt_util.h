@@ -107,6 +107,10 @@ c10::optional<nvinfer1::DataType> toTRTDataType(caffe2::TypeMeta dtype);
 
 const std::unordered_map<at::ScalarType, nvinfer1::DataType>& get_aten_trt_type_map();
 
+// Engine outputs which were int64 in the source graph are produced as int32,
+// their bindings are named with this suffix so the runtime casts them back
+const std::string kInt64OutputSuffix = "_int64";
+
 } // namespace util
 } // namespace core
 } // namespace trtorch
@@ -7,17 +7,22 @@
  */
 #pragma once
 
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "NvInfer.h"
 #include "torch/torch.h"
 #include "trtorch/logging.h"
+#include "trtorch/trtorch.h"
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace nvinfer1 {
@@ -27,8 +32,78 @@ class IInt8EntropyCalibrator2;
 
 namespace trtorch {
 namespace ptq {
-bool get_batch_impl(void* bindings[], const char* names[], int nbBindings, torch::Tensor& data);
+bool get_batch_impl(void* bindings[], const char* names[], int nbBindings, std::vector<torch::Tensor>& data);
+
+namespace detail {
+// Checks each tensor of a batch has the shape TensorRT calibrates its binding
+// with, returns false for a batch which is only short in the batch dimension
+// (i.e. the last batch of a dataset which does not divide evenly)
+bool is_full_batch(
+    nvinfer1::IInt8Calibrator* calibrator,
+    const char* names[],
+    int nbBindings,
+    const std::vector<torch::Tensor>& batch);
+
+// Exceptions cannot be thrown through TensorRT, so errors while loading a batch
+// are recorded and rethrown once TensorRT is done building the engine
+void record_calibration_error(nvinfer1::IInt8Calibrator* calibrator, std::exception_ptr error);
+
+// The data of a batch is either a single tensor or, for modules with multiple
+// inputs, a vector or tuple of tensors in the order of the module's inputs
+inline std::vector<torch::Tensor> flatten_batch(torch::Tensor data) {
+  return {data};
+}
+
+inline std::vector<torch::Tensor> flatten_batch(std::vector<torch::Tensor> data) {
+  return data;
+}
+
+template <typename... Tensors, size_t... I>
+std::vector<torch::Tensor> flatten_batch(const std::tuple<Tensors...>& data, std::index_sequence<I...>) {
+  return {std::get<I>(data)...};
+}
+
+template <typename... Tensors>
+std::vector<torch::Tensor> flatten_batch(const std::tuple<Tensors...>& data) {
+  return flatten_batch(data, std::index_sequence_for<Tensors...>{});
+}
+
+// Makes a producer for a single pass over a DataLoader
+template <typename DataLoader>
+std::function<bool(std::vector<torch::Tensor>&)> make_dataloader_producer(DataLoader* dataloader) {
+  using Iterator = torch::data::Iterator<typename DataLoader::super::BatchType>;
+  std::shared_ptr<Iterator> it;
+  return [dataloader, it](std::vector<torch::Tensor>& data) mutable {
+    if (!it) {
+      it = std::make_shared<Iterator>(dataloader->begin());
+    }
+    if (*it == dataloader->end()) {
+      return false;
+    }
+    data = flatten_batch((**it).data);
+    ++(*it);
+    return true;
+  };
 }
+
+// Pulls batches from produce on a background thread and copies them to the
+// GPU from pinned host memory on a side stream, keeping up to depth batches
+// staged ahead of the calibrator
+class TRTORCH_API BatchPrefetcher {
+ public:
+  using Producer = std::function<bool(std::vector<torch::Tensor>&)>;
+  BatchPrefetcher(Producer produce, size_t depth);
+  ~BatchPrefetcher();
+  // Blocks until the next batch is on the GPU, returns false once produce is
+  // exhausted (rethrowing anything produce threw)
+  bool next(std::vector<torch::Tensor>& batch);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+} // namespace detail
+} // namespace ptq
 } // namespace trtorch
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -46,15 +121,15 @@ namespace ptq {
  */
 template <typename Algorithm, typename DataLoaderUniquePtr>
 class Int8Calibrator : Algorithm {
-  using DataLoader = typename DataLoaderUniquePtr::element_type;
-  using Batch = typename DataLoader::super::BatchType;
-
  public:
   /**
    * @brief Construct a new Int8Calibrator object
    *
    * Using the provided DataLoader, construct a calibrator that can be used for
-   * PTQ with TRTorch
+   * PTQ with TRTorch. Batches are pulled from the DataLoader lazily on a
+   * background thread during calibration and copied to the GPU ahead of time,
+   * so the dataset is never held in memory as a whole and is not read at all
+   * if the calibration cache is used
    *
    * @param dataloader: std::unqiue_ptr<torch::data::DataLoader> - A unique
    * pointer to the DataLoader, should be what is returned from the
@@ -64,30 +139,32 @@ class Int8Calibrator : Algorithm {
    * @param use_cache : bool - Whether to use the cache (if it exists)
    */
   Int8Calibrator(DataLoaderUniquePtr dataloader, const std::string& cache_file_path, bool use_cache)
-      : dataloader_(dataloader.get()), cache_file_path_(cache_file_path), use_cache_(use_cache) {
-    for (auto batch : *dataloader_) {
-      batched_data_.push_back(batch.data);
-    }
-    it_ = batched_data_.begin();
-  }
+      : dataloader_(std::move(dataloader)), cache_file_path_(cache_file_path), use_cache_(use_cache) {}
 
   /**
-   * @brief Get the Batch Size for the next batch (always 1 due to issues with
-   * TRT and explicit batch)
+   * @brief Get the Batch Size for the next batch (always 1 since TRTorch
+   * builds explicit batch engines)
+   *
+   * Engines built by TRTorch have the batch dimension as part of the shape of
+   * each input, so the batch size used for calibration is the batch dimension
+   * of the calibration profile (the optimal input shapes in the CompileSpec)
+   * and every batch from the DataLoader is fed to TensorRT whole. Batches
+   * should have the shapes TensorRT reports for the calibration profile,
+   * batches which are only smaller in the batch dimension (i.e. the last batch
+   * of a dataset which does not divide evenly) are skipped and any other
+   * mismatch fails the build
    *
    * @return int
    */
   int getBatchSize() const override {
-    // HACK: TRTorch only uses explict batch sizing, INT8 Calibrator does not
-    // work when reporting the batch size here and having explicity batching.
-    // So we just report batch size 1 (warnings will still be printed out).
     return 1;
-    // return static_cast<int>(dataloader_->options().batch_size);
   }
 
   /**
    * @brief Get the next Batch
    *
+   * Each tensor of the batch is bound to the engine input of the same index
+   *
    * @param bindings: void*[] - An array of binding pointers (fed in from
    * TensorRT calibrator), these buffers should be filed with batch data for
    * each input
@@ -97,15 +174,26 @@ class Int8Calibrator : Algorithm {
    * @return false - There is not a new batch for the calibrator to consume
    */
   bool getBatch(void* bindings[], const char* names[], int nbBindings) override {
-    if (it_ != batched_data_.end()) {
-      auto status = get_batch_impl(bindings, names, nbBindings, *it_);
-      it_ = ++it_;
-      return status;
-    } else {
-      // Reset iterator if incase calibrator is going to be used again
-      it_ = batched_data_.begin();
-      return false;
+    if (!prefetcher_) {
+      prefetcher_ = std::unique_ptr<detail::BatchPrefetcher>(new detail::BatchPrefetcher(make_producer(), 2));
     }
+    try {
+      // The current batch has to stay alive until TensorRT asks for the next
+      while (prefetcher_->next(current_batch_)) {
+        if (detail::is_full_batch(*this, names, nbBindings, current_batch_)) {
+          return get_batch_impl(bindings, names, nbBindings, current_batch_);
+        }
+      }
+    } catch (...) {
+      // Ends calibration, the error is rethrown once TensorRT returns so the
+      // build fails instead of using a partial calibration
+      detail::record_calibration_error(*this, std::current_exception());
+    }
+    // Start a new pass over the DataLoader in case the calibrator is going to
+    // be used again
+    prefetcher_.reset();
+    current_batch_.clear();
+    return false;
   }
 
   /**
@@ -164,20 +252,26 @@ class Int8Calibrator : Algorithm {
   }
 
  private:
-  /// Pointer to the dataloader
-  DataLoader* dataloader_;
+  /// Makes a producer for a single pass over the DataLoader, run on the
+  /// prefetching thread
+  detail::BatchPrefetcher::Producer make_producer() {
+    return detail::make_dataloader_producer(dataloader_.get());
+  }
+
+  /// The dataloader
+  DataLoaderUniquePtr dataloader_;
   /// Path to cache file
-  const std::string& cache_file_path_;
+  std::string cache_file_path_;
   /// Size of cache
   size_t cache_size_ = 0;
   /// Whether to use the cache or not
   bool use_cache_;
   /// Cache data
   std::vector<char> cache_;
-  /// Batched Data
-  std::vector<torch::Tensor> batched_data_;
-  /// Iterator to move through dataset
-  std::vector<torch::Tensor>::iterator it_;
+  /// Stages batches of the current pass over the dataloader on the GPU
+  std::unique_ptr<detail::BatchPrefetcher> prefetcher_;
+  /// Batch being used for calibration, one tensor per input
+  std::vector<torch::Tensor> current_batch_;
 };
 
 /**
@@ -198,15 +292,12 @@ class Int8CacheCalibrator : Algorithm {
   Int8CacheCalibrator(const std::string& cache_file_path) : cache_file_path_(cache_file_path) {}
 
   /**
-   * @brief Get the Batch Size for the next batch (always 1 due to issues with
-   * TRT and explicit batch)
+   * @brief Get the Batch Size for the next batch (always 1 since TRTorch
+   * builds explicit batch engines)
    *
    * @return int
    */
   int getBatchSize() const override {
-    // HACK: TRTorch only uses explict batch sizing, INT8 Calibrator does not
-    // work when reporting the batch size here and having explicity batching.
-    // So we just report batch size 1 (warnings will still be printed out).
     return 1;
   }
 
@@ -280,7 +371,7 @@ class Int8CacheCalibrator : Algorithm {
 
  private:
   /// Path to cache file
-  const std::string& cache_file_path_;
+  std::string cache_file_path_;
   /// Size of cache
   size_t cache_size_ = 0;
   /// Cache data
@@ -352,5 +443,90 @@ TRTORCH_API inline Int8CacheCalibrator<Algorithm> make_int8_cache_calibrator(con
   return Int8CacheCalibrator<Algorithm>(cache_file_path);
 }
 
+/**
+ * @brief Method used to pick the dynamic range of an activation from the
+ * histogram of its values
+ */
+enum class RangeMethod : int8_t {
+  /// Largest absolute value seen
+  kMAX,
+  /// Smallest range covering a percentage of the values seen
+  kPERCENTILE,
+  /// Range minimizing the mean squared error of the quantized values
+  kMSE,
+  /// Range minimizing the KL divergence between the values and their quantized
+  /// distribution (same as nvinfer1::IInt8EntropyCalibrator2)
+  kENTROPY,
+};
+
+/**
+ * @brief Settings for collecting activation ranges with
+ * collect_activation_ranges
+ */
+struct TRTORCH_API ActivationRangeSettings {
+  /// How ranges are picked from the histograms
+  RangeMethod method = RangeMethod::kENTROPY;
+  /// Percentage of the values covered by the range with RangeMethod::kPERCENTILE
+  double percentile = 99.99;
+  /// Resolution of the histogram kept for each activation
+  int64_t num_bins = 2048;
+  /// Device the module is on, batches are moved there before running it
+  torch::Device device = torch::kCUDA;
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace detail {
+TRTORCH_API void collect_activation_ranges(
+    const torch::jit::Module& module,
+    std::string method_name,
+    CompileSpec info,
+    std::function<bool(std::vector<torch::Tensor>&)> next_batch,
+    const std::string& calibration_file,
+    ActivationRangeSettings settings);
+} // namespace detail
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Collects the dynamic ranges of the activations of a module by
+ * running it in TorchScript over a dataloader and saves them to a
+ * calibration file
+ *
+ * The method is lowered exactly as it would be for compilation with info and
+ * run once over the dataloader while a histogram of every activation is
+ * gathered, ranges are then picked from the histograms with the requested
+ * method. Setting the calibration_file field of a CompileSpec requesting INT8
+ * to the file uses the ranges directly as the dynamic ranges of the engine
+ * tensors, no calibration is done by TensorRT. The file is only valid for the
+ * same module and input ranges it was collected with
+ *
+ * e.g.
+ * ``trtorch::ptq::collect_activation_ranges(mod, "forward", compile_spec,
+ * calibration_dataloader, "ranges.txt");``
+ * @tparam DataLoaderUniquePtr: std::unique_ptr<torch::data::DataLoader> -
+ * DataLoader type
+ * @param module: const torch::jit::Module& - Module to calibrate
+ * @param method_name: std::string - Method to calibrate
+ * @param info: CompileSpec - Settings the module will be compiled with
+ * @param dataloader: DataLoaderUniquePtr& - DataLoader containing data
+ * @param calibration_file: const std::string& - Path to write the ranges to
+ * @param settings: ActivationRangeSettings - How to collect the ranges
+ */
+template <typename DataLoaderUniquePtr>
+TRTORCH_API inline void collect_activation_ranges(
+    const torch::jit::Module& module,
+    std::string method_name,
+    CompileSpec info,
+    DataLoaderUniquePtr& dataloader,
+    const std::string& calibration_file,
+    ActivationRangeSettings settings = ActivationRangeSettings()) {
+  detail::collect_activation_ranges(
+      module,
+      method_name,
+      std::move(info),
+      detail::make_dataloader_producer(dataloader.get()),
+      calibration_file,
+      std::move(settings));
+}
+
 } // namespace ptq
 } // namespace trtorch
\ No newline at end of file
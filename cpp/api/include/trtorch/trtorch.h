@@ -22,6 +22,10 @@ struct Module;
 } // namespace jit
 } // namespace torch
 
+namespace at {
+class Tensor;
+} // namespace at
+
 namespace c10 {
 enum class DeviceType : int16_t;
 enum class ScalarType : int8_t;
@@ -239,6 +243,39 @@ struct TRTORCH_API CompileSpec {
    */
   DataType op_precision = DataType::kFloat;
 
+  /**
+   * @brief Pins the layers converted from matching TorchScript nodes, and
+   * their output tensors, to a precision
+   *
+   * Patterns are regular expressions which have to match in full, a node
+   * matches the rule if it matches every pattern that is set (at least one has
+   * to be). When several rules match a node the last one wins. Rules running
+   * layers in FP16 in an FP32 engine pin every layer they do not match to FP32
+   */
+  struct TRTORCH_API LayerPrecision {
+    /// Pattern for the kind of the node, e.g. "aten::linear"
+    std::string kind = "";
+    /// Pattern for the scope of the node (the module hierarchy recorded by
+    /// tracing), e.g. ".*__module.classifier.*"
+    std::string scope = "";
+    /// Pattern for the name of any output of the node in the lowered graph
+    std::string name = "";
+    /// Precision to run the matching layers in
+    DataType precision = DataType::kFloat;
+  };
+
+  /**
+   * Overrides of the operating precision for specific layers, setting any
+   * implies strict types for the pinned layers
+   */
+  std::vector<LayerPrecision> layer_precisions;
+
+  /**
+   * Path to a precision profile saved by trtorch::SearchLayerPrecisions, its
+   * rules are applied before layer_precisions
+   */
+  std::string precision_profile = "";
+
   /**
    * Build a refitable engine
    */
@@ -400,6 +437,12 @@ struct TRTORCH_API CompileSpec {
    * Calibration dataloaders for each input for post training quantizatiom
    */
   nvinfer1::IInt8Calibrator* ptq_calibrator = nullptr;
+
+  /**
+   * Activation ranges from trtorch::ptq::collect_activation_ranges used as
+   * the dynamic ranges for INT8 instead of calibrating with TensorRT
+   */
+  std::string calibration_file = "";
 };
 
 /**
@@ -466,6 +509,50 @@ TRTORCH_API std::string ConvertGraphToTRTEngine(
     const torch::jit::Module& module,
     std::string method_name,
     CompileSpec info);
+
+/**
+ * @brief Settings for trtorch::SearchLayerPrecisions
+ */
+struct TRTORCH_API PrecisionSearchSettings {
+  /// Largest acceptable deviation of the outputs from TorchScript, relative to
+  /// the largest magnitude of the TorchScript outputs
+  double threshold = 1e-2;
+  /// Precision the most error sensitive layers are promoted to
+  CompileSpec::DataType promoted_precision = CompileSpec::DataType::kFloat;
+};
+
+/**
+ * @brief Find the layers of a method to run in a higher precision than the
+ * operating precision for its outputs to stay close to TorchScript
+ *
+ * @param module: torch::jit::Module - Existing TorchScript module
+ * @param method_name: std::string - Name of method to search
+ * @param info: trtorch::CompileSpec - Compilation settings, the operating
+ * precision (FP16 or INT8) is where the search starts from
+ * @param validation_batches: std::vector<std::vector<at::Tensor>> - Inputs
+ * to the method, a tensor for each input per batch, on the device of the module
+ * @param precision_profile: std::string - Path to save the precision profile
+ * to (not saved if empty), set CompileSpec::precision_profile to it to compile
+ * with the promotions
+ * @param settings: trtorch::PrecisionSearchSettings - Accuracy budget and
+ * promoted precision
+ *
+ * Compares every activation of an engine in the operating precision against
+ * TorchScript to rank layers by the error they add, then promotes the fewest
+ * of the top ranked layers meeting the threshold. The per layer assignment,
+ * error and latency before and after are logged at the info level
+ *
+ * @return std::vector<CompileSpec::LayerPrecision>: Rules promoting the
+ * selected layers, most error sensitive first
+ */
+TRTORCH_API std::vector<CompileSpec::LayerPrecision> SearchLayerPrecisions(
+    const torch::jit::Module& module,
+    std::string method_name,
+    CompileSpec info,
+    std::vector<std::vector<at::Tensor>> validation_batches,
+    std::string precision_profile = "",
+    PrecisionSearchSettings settings = PrecisionSearchSettings());
+
 /**
  * @brief Set gpu device id
  *
@@ -475,4 +562,45 @@ TRTORCH_API std::string ConvertGraphToTRTEngine(
  */
 TRTORCH_API void set_device(const int gpu_id);
 
+/**
+ * @brief Get runtime metrics for all TensorRT engines executed in this process
+ *
+ * Covers per engine call and error counts, latency histograms, input shape
+ * distributions and bytes bound to the engine, aggregated across all threads
+ *
+ * @return std::string: Metrics in the Prometheus text exposition format
+ */
+TRTORCH_API std::string get_runtime_metrics();
+
+/**
+ * @brief Write runtime metrics in the Prometheus text exposition format
+ *
+ * @param path: std::string - File to (atomically) replace with the metrics
+ * or "unix:<socket path>" to send them to a local unix domain socket
+ */
+TRTORCH_API void dump_runtime_metrics(std::string path);
+
+/**
+ * @brief Start recording a timeline of compilation phases (lowering passes,
+ * converters, engine build) and engine execution
+ *
+ * Spans are also emitted as NVTX ranges if TRTorch was built with NVTX.
+ * Tracing can also be enabled by setting the environment variable
+ * TRTORCH_TRACE to a path, in which case the trace is written there on exit
+ */
+TRTORCH_API void enable_tracing();
+
+/**
+ * @brief Stop recording spans, already recorded spans are kept
+ */
+TRTORCH_API void disable_tracing();
+
+/**
+ * @brief Write all recorded spans as Chrome trace event JSON
+ *
+ * @param path: std::string - File to write the trace to, can be opened in
+ * chrome://tracing or Perfetto
+ */
+TRTORCH_API void dump_trace(std::string path);
+
 } // namespace trtorch
@@ -74,20 +74,31 @@ std::vector<core::conversion::InputRange> to_vec_internal_input_ranges(std::vect
   return internal;
 }
 
-core::CompileSpec to_internal_compile_spec(CompileSpec external) {
-  core::CompileSpec internal(to_vec_internal_input_ranges(external.input_ranges));
-
-  switch (external.op_precision) {
+nvinfer1::DataType to_internal_data_type(CompileSpec::DataType external) {
+  switch (external) {
     case CompileSpec::DataType::kChar:
-      internal.convert_info.engine_settings.op_precision = nvinfer1::DataType::kINT8;
-      break;
+      return nvinfer1::DataType::kINT8;
     case CompileSpec::DataType::kHalf:
-      internal.convert_info.engine_settings.op_precision = nvinfer1::DataType::kHALF;
-      break;
+      return nvinfer1::DataType::kHALF;
     case CompileSpec::DataType::kFloat:
     default:
-      internal.convert_info.engine_settings.op_precision = nvinfer1::DataType::kFLOAT;
+      return nvinfer1::DataType::kFLOAT;
+  }
+}
+
+core::CompileSpec to_internal_compile_spec(CompileSpec external) {
+  core::CompileSpec internal(to_vec_internal_input_ranges(external.input_ranges));
+
+  internal.convert_info.engine_settings.op_precision = to_internal_data_type(external.op_precision);
+  for (auto& l : external.layer_precisions) {
+    core::conversion::LayerPrecisionRule rule;
+    rule.kind = l.kind;
+    rule.scope = l.scope;
+    rule.name = l.name;
+    rule.precision = to_internal_data_type(l.precision);
+    internal.convert_info.engine_settings.layer_precisions.push_back(rule);
   }
+  internal.convert_info.engine_settings.precision_profile = external.precision_profile;
 
   internal.convert_info.engine_settings.refit = external.refit;
   internal.convert_info.engine_settings.debug = external.debug;
@@ -124,6 +135,7 @@ core::CompileSpec to_internal_compile_spec(CompileSpec external) {
 
   if (internal.convert_info.engine_settings.op_precision == nvinfer1::DataType::kINT8) {
     internal.convert_info.engine_settings.calibrator = external.ptq_calibrator;
+    internal.convert_info.engine_settings.calibration_file = external.calibration_file;
   } else {
     internal.convert_info.engine_settings.calibrator = nullptr;
   }
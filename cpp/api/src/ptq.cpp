@@ -1,16 +1,259 @@
-#include "trtorch/ptq.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
+#include "core/calibration/calibration.h"
+#include "core/compiler.h"
+#include "core/util/prelude.h"
 #include "torch/torch.h"
+#include "trtorch/ptq.h"
 
 namespace trtorch {
+
+// Defined in compile_spec.cpp
+core::CompileSpec to_internal_compile_spec(CompileSpec external);
+
 namespace ptq {
 
-bool get_batch_impl(void* bindings[], const char* names[], int nbBindings, torch::Tensor& data) {
+namespace {
+// Inputs are named input_<index of the input> when added to the network
+size_t input_index(const std::string& name, size_t num_inputs) {
+  const std::string prefix = "input_";
+  auto digits = name.substr(std::min(prefix.size(), name.size()));
+  TRTORCH_CHECK(
+      name.compare(0, prefix.size(), prefix) == 0 && !digits.empty() && digits.size() <= 9 &&
+          std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; }),
+      "Unexpected binding " << name << " in calibration, expected bindings named " << prefix << "<input index>");
+  auto idx = static_cast<size_t>(std::stoi(digits));
+  TRTORCH_CHECK(idx < num_inputs, "No calibration data for binding " << name);
+  return idx;
+}
+
+void check_num_inputs(int nbBindings, const std::vector<torch::Tensor>& data) {
+  TRTORCH_CHECK(
+      data.size() == static_cast<size_t>(nbBindings),
+      "Expected calibration batches with " << nbBindings << " tensors (one for each input) but found " << data.size());
+}
+} // namespace
+
+bool get_batch_impl(void* bindings[], const char* names[], int nbBindings, std::vector<torch::Tensor>& data) {
+  check_num_inputs(nbBindings, data);
   for (int i = 0; i < nbBindings; i++) {
-    data = data.to(at::kCUDA).contiguous();
-    bindings[i] = data.data_ptr();
+    auto idx = input_index(names[i], data.size());
+    data[idx] = data[idx].to(at::kCUDA).contiguous();
+    bindings[i] = data[idx].data_ptr();
   }
   return true;
 }
 
+namespace detail {
+
+bool is_full_batch(
+    nvinfer1::IInt8Calibrator* calibrator,
+    const char* names[],
+    int nbBindings,
+    const std::vector<torch::Tensor>& batch) {
+  check_num_inputs(nbBindings, batch);
+  core::calibration::BindingDims dims;
+  if (!core::calibration::GetCalibrationBindings(calibrator, dims)) {
+    // Not calibrating an engine built by TRTorch, nothing to check against
+    return true;
+  }
+  for (int i = 0; i < nbBindings; i++) {
+    auto& t = batch[input_index(names[i], batch.size())];
+    auto it = dims.find(names[i]);
+    if (it == dims.end()) {
+      continue;
+    }
+    auto expected = it->second;
+    if (t.sizes().vec() == expected) {
+      continue;
+    }
+    bool short_batch = t.dim() > 0 && t.dim() == static_cast<int64_t>(expected.size()) && t.size(0) < expected[0] &&
+        std::equal(expected.begin() + 1, expected.end(), t.sizes().begin() + 1);
+    TRTORCH_CHECK(
+        short_batch,
+        "Calibration data for binding " << names[i] << " has shape " << t.sizes()
+                                        << " but TensorRT calibrates it with shape " << c10::IntArrayRef(expected)
+                                        << ", check the DataLoader against the input ranges");
+    LOG_WARNING(
+        "Skipping calibration batch with shape " << t.sizes() << " for binding " << names[i]
+                                                 << ", expected a batch size of " << expected[0]);
+    return false;
+  }
+  return true;
+}
+
+void record_calibration_error(nvinfer1::IInt8Calibrator* calibrator, std::exception_ptr error) {
+  core::calibration::RecordCalibrationError(calibrator, error);
+}
+
+struct StagedBatch {
+  std::vector<torch::Tensor> data;
+  // Keeps the pinned staging buffers alive until the copies out of them are
+  // done
+  std::vector<torch::Tensor> pinned;
+  at::cuda::CUDAEvent copied;
+};
+
+struct BatchPrefetcher::Impl {
+  Impl(Producer produce, size_t depth)
+      : produce(std::move(produce)),
+        depth(depth),
+        device(c10::cuda::current_device()),
+        stream(c10::cuda::getStreamFromPool(false, device)) {
+    worker = std::thread([this]() { run(); });
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    cv.notify_all();
+    worker.join();
+  }
+
+  void run() {
+    c10::cuda::CUDAGuard device_guard(device);
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return stop || staged.size() < depth; });
+        if (stop) {
+          return;
+        }
+      }
+
+      std::vector<torch::Tensor> host;
+      bool produced = false;
+      std::exception_ptr produce_error;
+      try {
+        produced = produce(host);
+      } catch (...) {
+        produce_error = std::current_exception();
+      }
+      if (!produced) {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = produce_error;
+        exhausted = true;
+        cv.notify_all();
+        return;
+      }
+
+      StagedBatch batch;
+      {
+        // Copies on the side stream overlap with calibration of the batches
+        // already handed to TensorRT
+        c10::cuda::CUDAStreamGuard stream_guard(stream);
+        for (auto& t : host) {
+          if (t.is_cuda()) {
+            batch.data.push_back(t.contiguous());
+          } else {
+            batch.pinned.push_back(t.is_pinned() ? t.contiguous() : t.contiguous().pin_memory());
+            batch.data.push_back(batch.pinned.back().to(at::kCUDA, /*non_blocking=*/true));
+          }
+        }
+        batch.copied.record(stream);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      staged.push_back(std::move(batch));
+      cv.notify_all();
+    }
+  }
+
+  bool next(std::vector<torch::Tensor>& batch) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this]() { return exhausted || !staged.empty(); });
+    if (staged.empty()) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+      return false;
+    }
+    auto staged_batch = std::move(staged.front());
+    staged.pop_front();
+    lock.unlock();
+    cv.notify_all();
+
+    staged_batch.copied.synchronize();
+    batch = staged_batch.data;
+    return true;
+  }
+
+  Producer produce;
+  size_t depth;
+  c10::DeviceIndex device;
+  c10::cuda::CUDAStream stream;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<StagedBatch> staged;
+  bool exhausted = false;
+  bool stop = false;
+  std::exception_ptr error;
+  std::thread worker;
+};
+
+BatchPrefetcher::BatchPrefetcher(Producer produce, size_t depth)
+    : impl_(new Impl(std::move(produce), depth > 0 ? depth : 1)) {}
+
+BatchPrefetcher::~BatchPrefetcher() = default;
+
+bool BatchPrefetcher::next(std::vector<torch::Tensor>& batch) {
+  return impl_->next(batch);
+}
+
+void collect_activation_ranges(
+    const torch::jit::Module& module,
+    std::string method_name,
+    CompileSpec info,
+    std::function<bool(std::vector<torch::Tensor>&)> next_batch,
+    const std::string& calibration_file,
+    ActivationRangeSettings settings) {
+  core::calibration::CalibrationSettings internal;
+  switch (settings.method) {
+    case RangeMethod::kMAX:
+      internal.method = core::calibration::RangeMethod::kMAX;
+      break;
+    case RangeMethod::kPERCENTILE:
+      internal.method = core::calibration::RangeMethod::kPERCENTILE;
+      break;
+    case RangeMethod::kMSE:
+      internal.method = core::calibration::RangeMethod::kMSE;
+      break;
+    case RangeMethod::kENTROPY:
+    default:
+      internal.method = core::calibration::RangeMethod::kENTROPY;
+  }
+  internal.percentile = settings.percentile;
+  internal.num_bins = settings.num_bins;
+
+  auto device = settings.device;
+  auto ranges = core::CollectActivationRanges(
+      module,
+      method_name,
+      to_internal_compile_spec(info),
+      [&next_batch, device](std::vector<torch::Tensor>& batch) {
+        if (!next_batch(batch)) {
+          return false;
+        }
+        for (auto& t : batch) {
+          t = t.to(device);
+        }
+        return true;
+      },
+      internal);
+  core::calibration::WriteCalibrationFile(calibration_file, ranges);
+}
+
+} // namespace detail
 } // namespace ptq
-} // namespace trtorch
\ No newline at end of file
+} // namespace trtorch
@@ -1,6 +1,7 @@
 #include "torch/csrc/jit/api/module.h"
 
 #include "core/compiler.h"
+#include "core/runtime/metrics.h"
 #include "core/util/prelude.h"
 
 #include "trtorch/trtorch.h"
@@ -9,6 +10,7 @@ namespace trtorch {
 
 // Defined in compile_spec.cpp
 core::CompileSpec to_internal_compile_spec(CompileSpec external);
+nvinfer1::DataType to_internal_data_type(CompileSpec::DataType external);
 
 bool CheckMethodOperatorSupport(const torch::jit::script::Module& module, std::string method_name) {
   return core::CheckMethodOperatorSupport(module, method_name);
@@ -31,6 +33,35 @@ torch::jit::script::Module CompileGraph(const torch::jit::script::Module& module
   return core::CompileGraph(module, to_internal_compile_spec(info));
 }
 
+std::vector<CompileSpec::LayerPrecision> SearchLayerPrecisions(
+    const torch::jit::script::Module& module,
+    std::string method_name,
+    CompileSpec info,
+    std::vector<std::vector<at::Tensor>> validation_batches,
+    std::string precision_profile,
+    PrecisionSearchSettings settings) {
+  LOG_DEBUG(get_build_info());
+  core::precision_search::SearchSettings internal_settings;
+  internal_settings.threshold = settings.threshold;
+  internal_settings.promoted_precision = to_internal_data_type(settings.promoted_precision);
+  auto result = core::SearchLayerPrecisions(
+      module, method_name, to_internal_compile_spec(info), validation_batches, internal_settings);
+  if (!precision_profile.empty()) {
+    core::conversion::WritePrecisionProfile(precision_profile, result.promotions);
+  }
+
+  std::vector<CompileSpec::LayerPrecision> promotions;
+  for (auto& r : result.promotions) {
+    CompileSpec::LayerPrecision l;
+    l.kind = r.kind;
+    l.scope = r.scope;
+    l.name = r.name;
+    l.precision = settings.promoted_precision;
+    promotions.push_back(l);
+  }
+  return promotions;
+}
+
 std::string get_build_info() {
   auto info = core::util::get_build_info();
   return std::string("TRTorch Version: ") + TRTORCH_VERSION + '\n' + info;
@@ -45,4 +76,24 @@ void set_device(const int gpu_id) {
   core::set_device(gpu_id);
 }
 
+std::string get_runtime_metrics() {
+  return core::runtime::metrics::to_prometheus_text(core::runtime::metrics::collect_engine_metrics());
+}
+
+void dump_runtime_metrics(std::string path) {
+  core::runtime::metrics::write_prometheus_text(path);
+}
+
+void enable_tracing() {
+  core::util::trace::enable();
+}
+
+void disable_tracing() {
+  core::util::trace::disable();
+}
+
+void dump_trace(std::string path) {
+  core::util::trace::dump(path);
+}
+
 } // namespace trtorch
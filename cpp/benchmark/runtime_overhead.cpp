@@ -0,0 +1,178 @@
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "cuda_runtime_api.h"
+#include "torch/cuda.h"
+#include "torch/script.h"
+
+#include "core/util/trace.h"
+#include "third_party/args/args.hpp"
+#include "trtorch/logging.h"
+#include "trtorch/trtorch.h"
+
+#include "timer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+namespace trace = trtorch::core::util::trace;
+
+// Host heap allocations are counted by replacing the global operator new,
+// only while a call is being measured
+static std::atomic<bool> count_allocations(false);
+static std::atomic<uint64_t> num_allocations(0);
+
+void* operator new(size_t size) {
+  if (count_allocations.load(std::memory_order_relaxed)) {
+    num_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  auto p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
+int64_t device_allocations() {
+  auto stats = c10::cuda::CUDACachingAllocator::getDeviceStats(0);
+  return stats.allocation[static_cast<size_t>(c10::cuda::CUDACachingAllocator::StatType::AGGREGATE)].allocated;
+}
+
+// A module with num_io inputs each passed through a relu to its own output, so
+// after compilation execute_engine handles num_io input and num_io output
+// bindings while the engine itself does next to no work
+torch::jit::Module MakeModule(int num_io) {
+  std::stringstream src;
+  src << "def forward(self";
+  for (int i = 0; i < num_io; i++) {
+    src << ", x" << i;
+  }
+  src << "):\n  return (";
+  for (int i = 0; i < num_io; i++) {
+    src << "x" << i << ".relu(), ";
+  }
+  src << ")\n";
+
+  torch::jit::Module mod("Bindings");
+  mod.define(src.str());
+  mod.eval();
+  return mod;
+}
+
+struct CallCosts {
+  double call_ns = 0;
+  double heap_allocations = 0;
+  double device_allocations = 0;
+  double execute_engine_ns = 0;
+  double enqueue_ns = 0;
+};
+
+CallCosts MeasureCalls(torch::jit::Module& trt_mod, std::vector<torch::jit::IValue>& inputs, int iterations) {
+  CallCosts costs;
+  timers::PreciseCPUTimer timer;
+
+  // The stream is drained after every call so measuring the host side of a
+  // call never includes waiting on a full launch queue
+  auto start_device_allocations = device_allocations();
+  num_allocations = 0;
+  for (int i = 0; i < iterations; i++) {
+    count_allocations = true;
+    timer.start();
+    auto out = trt_mod.forward(inputs);
+    timer.stop();
+    count_allocations = false;
+    cudaDeviceSynchronize();
+  }
+  costs.call_ns = timer.microseconds() * 1e3 / iterations;
+  costs.heap_allocations = static_cast<double>(num_allocations) / iterations;
+  costs.device_allocations = static_cast<double>(device_allocations() - start_device_allocations) / iterations;
+
+  // A separate traced run splits the time inside execute_engine between
+  // TRTorch and TensorRT, spans add some overhead of their own so the untraced
+  // call time above is the one to track
+  trace::clear();
+  trace::enable();
+  for (int i = 0; i < iterations; i++) {
+    auto out = trt_mod.forward(inputs);
+    cudaDeviceSynchronize();
+  }
+  trace::disable();
+  auto spans = trace::summarize();
+  costs.execute_engine_ns = static_cast<double>(spans["execute_engine"].total_ns) / iterations;
+  costs.enqueue_ns = static_cast<double>(spans["enqueue"].total_ns) / iterations;
+  trace::clear();
+  return costs;
+}
+
+int main(int argc, char** argv) {
+  args::ArgumentParser parser(
+      "Measures the host overhead of calling a TRTorch compiled module, from TorchScript dispatch through execute_engine, for increasing numbers of engine bindings",
+      "");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::ValueFlag<int> iterations(parser, "iterations", "Calls measured per engine (default 10000)", {"iterations"});
+  args::ValueFlag<int> warmup(parser, "warmup", "Calls made before measuring (default 100)", {"warmup"});
+  args::ValueFlag<int> max_bindings(
+      parser, "bindings", "Largest number of bindings to measure, doubled from 2 (default 64)", {"max-bindings"});
+
+  try {
+    parser.ParseCLI(argc, argv);
+  } catch (args::Help) {
+    std::cout << parser;
+    return 0;
+  } catch (args::ParseError e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  // Unlike conversion, which the scalability benchmark times against a recording
+  // network, the call path can't run without a device: execute_engine only takes
+  // CUDA tensors, allocates its outputs on the device and enqueues on the current
+  // CUDA stream. Stubbing the execution context would only remove the enqueue,
+  // which the traced run already separates out
+  if (!torch::cuda::is_available()) {
+    std::cerr << "The runtime overhead benchmark needs a GPU, execute_engine only runs on CUDA tensors" << std::endl;
+    return 1;
+  }
+
+  trtorch::logging::set_reportable_log_level(trtorch::logging::Level::kERROR);
+  int num_iterations = iterations ? args::get(iterations) : 10000;
+  int num_warmup = warmup ? args::get(warmup) : 100;
+  int bindings_limit = max_bindings ? args::get(max_bindings) : 64;
+
+  std::cout << std::setw(10) << "bindings" << std::setw(14) << "call ns" << std::setw(14) << "heap allocs"
+            << std::setw(14) << "dev allocs" << std::setw(18) << "execute_engine ns" << std::setw(14) << "enqueue ns"
+            << std::setw(14) << "trtorch ns" << std::endl;
+  for (int num_io = 1; num_io * 2 <= bindings_limit; num_io *= 2) {
+    auto mod = MakeModule(num_io);
+    std::vector<trtorch::CompileSpec::InputRange> ranges(
+        num_io, trtorch::CompileSpec::InputRange(std::vector<int64_t>{1, 16}));
+    auto trt_mod = trtorch::CompileGraph(mod, trtorch::CompileSpec(ranges));
+
+    std::vector<torch::jit::IValue> inputs;
+    for (int i = 0; i < num_io; i++) {
+      inputs.push_back(at::randn({1, 16}, {at::kCUDA}));
+    }
+    for (int i = 0; i < num_warmup; i++) {
+      trt_mod.forward(inputs);
+    }
+    cudaDeviceSynchronize();
+
+    auto costs = MeasureCalls(trt_mod, inputs, num_iterations);
+    std::cout << std::fixed << std::setprecision(1) << std::setw(10) << num_io * 2 << std::setw(14) << costs.call_ns
+              << std::setw(14) << costs.heap_allocations << std::setw(14) << costs.device_allocations << std::setw(18)
+              << costs.execute_engine_ns << std::setw(14) << costs.enqueue_ns << std::setw(14)
+              << costs.execute_engine_ns - costs.enqueue_ns << std::endl;
+  }
+  return 0;
+}
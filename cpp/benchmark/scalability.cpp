@@ -0,0 +1,376 @@
+#include "torch/csrc/jit/ir/ir.h"
+#include "torch/torch.h"
+
+#include "core/conversion/conversion.h"
+#include "core/conversion/evaluators/evaluators.h"
+#include "core/lowering/lowering.h"
+#include "core/util/prelude.h"
+#include "tests/util/recording_network.h"
+#include "third_party/args/args.hpp"
+
+#include "timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+namespace trace = trtorch::core::util::trace;
+namespace conversion = trtorch::core::conversion;
+
+// Stages which are not individual lowering passes
+#define LOWER_GRAPH_STAGE "LowerGraph"
+#define SUPPORT_CHECK_STAGE "VerifyConverterSupportForBlock"
+#define EVALUATOR_STAGE "Evaluators"
+#define CONVERSION_STAGE "ConvertBlockToNetDef"
+
+struct GraphShape {
+  int64_t depth;
+  int64_t width;
+  double control_flow_density;
+  int64_t features;
+};
+
+torch::jit::Value* AddConditional(torch::jit::Graph* g, torch::jit::Value* h) {
+  // The condition depends on the input so it survives lowering and has to be
+  // evaluated during conversion
+  auto batch = g->insert(torch::jit::aten::size, {h, g->insertConstant(0)});
+  auto cond = g->insert(torch::jit::aten::gt, {batch, g->insertConstant(0)});
+  auto if_node = g->insertNode(g->create(torch::jit::prim::If, {cond}, 1));
+  auto then_block = if_node->addBlock();
+  auto else_block = if_node->addBlock();
+  {
+    torch::jit::WithInsertPoint guard(then_block);
+    then_block->registerOutput(g->insert(torch::jit::aten::relu, {h}));
+  }
+  {
+    torch::jit::WithInsertPoint guard(else_block);
+    else_block->registerOutput(g->insert(torch::jit::aten::sigmoid, {h}));
+  }
+  return if_node->output()->setType(c10::TensorType::get());
+}
+
+torch::jit::Value* AddLoop(torch::jit::Graph* g, torch::jit::Value* h) {
+  auto trip_count = g->insertConstant(2);
+  auto cond = g->insertConstant(true);
+  auto loop = g->insertNode(g->create(torch::jit::prim::Loop, {trip_count, cond, h}, 1));
+  auto body = loop->addBlock();
+  body->addInput()->setType(c10::IntType::get());
+  auto carried = body->addInput()->setType(c10::TensorType::get());
+  {
+    torch::jit::WithInsertPoint guard(body);
+    auto r = g->insert(torch::jit::aten::relu, {carried});
+    body->registerOutput(cond);
+    body->registerOutput(r);
+  }
+  return loop->output()->setType(c10::TensorType::get());
+}
+
+// Builds a graph shaped like a frozen module: depth layers of width parallel
+// linear + relu branches summed back together, each followed by a reshape
+// whose shape is computed by the evaluators, with a fraction of the layers
+// wrapped in a conditional or a loop
+std::shared_ptr<torch::jit::Graph> MakeSyntheticGraph(const GraphShape& shape, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  torch::manual_seed(seed);
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  auto h = g->addInput("x")->setType(c10::TensorType::get());
+  for (int64_t d = 0; d < shape.depth; d++) {
+    std::vector<torch::jit::Value*> branches;
+    for (int64_t w = 0; w < shape.width; w++) {
+      auto weight = g->insertConstant(torch::randn({shape.features, shape.features}));
+      auto bias = g->insertConstant(torch::randn({shape.features}));
+      auto branch = g->insert(torch::jit::aten::linear, {h, weight, bias});
+      branches.push_back(g->insert(torch::jit::aten::relu, {branch}));
+    }
+    h = branches[0];
+    for (size_t i = 1; i < branches.size(); i++) {
+      h = g->insert(torch::jit::aten::add, {h, branches[i]});
+    }
+
+    auto features = g->insert(torch::jit::aten::mul, {g->insertConstant(shape.features), g->insertConstant(1)});
+    auto dims = g->insertNode(g->createList(c10::IntType::get(), {g->insertConstant(-1), features}))->output();
+    h = g->insert(torch::jit::aten::reshape, {h, dims});
+
+    if (uniform(rng) < shape.control_flow_density) {
+      h = d % 2 ? AddLoop(g.get(), h) : AddConditional(g.get(), h);
+    }
+  }
+  g->registerOutput(h);
+  return g;
+}
+
+size_t CountNodes(const torch::jit::Block* b) {
+  size_t count = 0;
+  for (auto n : b->nodes()) {
+    count++;
+    for (auto sub_block : n->blocks()) {
+      count += CountNodes(sub_block);
+    }
+  }
+  return count;
+}
+
+// Runs the evaluators over every node of the top level block that only
+// depends on values known ahead of time, the same work conversion does before
+// it reaches the converters
+size_t RunEvaluators(const torch::jit::Block* b) {
+  std::unordered_map<const torch::jit::Value*, torch::jit::IValue> evaluated;
+  size_t num_evaluated = 0;
+  for (auto n : b->nodes()) {
+    if (n->outputs().size() != 1 || !conversion::evaluators::shouldEvalAtConversionTime(n)) {
+      continue;
+    }
+    conversion::evaluators::kwargs args;
+    bool inputs_known = true;
+    for (auto in : n->inputs()) {
+      auto iter = evaluated.find(in);
+      if (iter == evaluated.end()) {
+        inputs_known = false;
+        break;
+      }
+      args[in] = &iter->second;
+    }
+    if (!inputs_known) {
+      continue;
+    }
+    auto result = conversion::evaluators::EvalNode(n, args);
+    if (result) {
+      evaluated[n->output()] = std::move(result.value());
+      num_evaluated++;
+    }
+  }
+  return num_evaluated;
+}
+
+// Joins the kinds of layers the recording network does not record, without
+// repeating them
+std::string JoinLayerKinds(const std::vector<std::string>& kinds) {
+  std::vector<std::string> unique;
+  for (auto& k : kinds) {
+    if (std::find(unique.begin(), unique.end(), k) == unique.end()) {
+      unique.push_back(k);
+    }
+  }
+  std::stringstream ss;
+  for (size_t i = 0; i < unique.size(); i++) {
+    ss << (i > 0 ? ", " : "") << unique[i];
+  }
+  return ss.str();
+}
+
+// Milliseconds spent in each stage and lowering pass for a single graph.
+// Conversion is only timed if convert is set, it is cleared if the graph needs
+// layers the recording network does not record
+std::map<std::string, double> TimeStages(
+    const std::shared_ptr<torch::jit::Graph>& graph,
+    const GraphShape& shape,
+    bool& convert) {
+  std::map<std::string, double> stages;
+  auto g = graph->copy();
+  timers::PreciseCPUTimer timer;
+
+  trace::clear();
+  trace::enable();
+  timer.start();
+  trtorch::core::lowering::LowerGraph(g);
+  timer.stop();
+  trace::disable();
+  stages[LOWER_GRAPH_STAGE] = timer.milliseconds();
+  for (auto& s : trace::summarize()) {
+    if (s.second.category == "lowering" && s.first != LOWER_GRAPH_STAGE) {
+      stages[s.first] = s.second.total_ns / 1e6;
+    }
+  }
+
+  timer.reset();
+  timer.start();
+  conversion::VerifyConverterSupportForBlock(g->block());
+  timer.stop();
+  stages[SUPPORT_CHECK_STAGE] = timer.milliseconds();
+
+  timer.reset();
+  timer.start();
+  RunEvaluators(g->block());
+  timer.stop();
+  stages[EVALUATOR_STAGE] = timer.milliseconds();
+
+  if (convert) {
+    conversion::ConversionInfo info({conversion::InputRange({1, shape.features})});
+    // Converted into a recording network so conversion is timed on CPU, without
+    // a builder
+    conversion::ConversionCtx ctx(info.engine_settings, trtorch::tests::util::CreateRecordingNetwork());
+    conversion::GraphParams params;
+    timer.reset();
+    timer.start();
+    try {
+      conversion::ConvertBlockToNetDef(&ctx, g->block(), info, params);
+    } catch (trtorch::Error& e) {
+      auto unsupported = trtorch::tests::util::UnsupportedLayers(ctx.net);
+      if (unsupported.empty()) {
+        throw;
+      }
+      std::cerr << "Conversion is not timed, the synthetic graph needs " << JoinLayerKinds(unsupported)
+                << " layers which the recording network does not record (run with --control-flow-density 0 to time "
+                   "conversion)"
+                << std::endl;
+      convert = false;
+      return stages;
+    }
+    timer.stop();
+    stages[CONVERSION_STAGE] = timer.milliseconds();
+  }
+  return stages;
+}
+
+// Least squares slope of log(time) against log(nodes), 1 is linear scaling
+double ScalingExponent(const std::vector<size_t>& nodes, const std::vector<double>& times) {
+  double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (times[i] <= 0) {
+      continue;
+    }
+    auto x = std::log(static_cast<double>(nodes[i]));
+    auto y = std::log(times[i]);
+    n++;
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+  }
+  auto denom = n * sxx - sx * sx;
+  return n < 2 || denom == 0 ? 0 : (n * sxy - sx * sy) / denom;
+}
+
+int main(int argc, char** argv) {
+  args::ArgumentParser parser(
+      "Times lowering, the converter support check, the evaluators and (optionally) conversion on synthetic graphs of increasing size and reports how each of them scales",
+      "");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::ValueFlag<int64_t> depth(parser, "depth", "Number of layers of the smallest graph (default 64)", {"depth"});
+  args::ValueFlag<int64_t> width(parser, "width", "Number of parallel branches per layer (default 4)", {"width"});
+  args::ValueFlag<double> control_flow_density(
+      parser,
+      "density",
+      "Fraction of layers wrapped in a conditional or loop (default 0.1)",
+      {"control-flow-density"});
+  args::ValueFlag<int64_t> features(parser, "features", "Size of the hidden features (default 16)", {"features"});
+  args::ValueFlag<int> steps(
+      parser, "steps", "Number of graph sizes, the depth doubles at each step (default 5)", {"steps"});
+  args::ValueFlag<int> iterations(
+      parser, "iterations", "Runs per graph size, the fastest is reported (default 3)", {"iterations"});
+  args::ValueFlag<double> max_exponent(
+      parser,
+      "exponent",
+      "Fail if a stage scales worse than nodes^exponent (default 1.25)",
+      {"max-exponent"});
+  args::ValueFlag<double> min_time(
+      parser,
+      "ms",
+      "Stages faster than this on the largest graph are too noisy to be checked (default 1 ms)",
+      {"min-time"});
+  args::Flag convert(
+      parser,
+      "convert",
+      "Also time conversion to a network definition, conversion runs on CPU against a recording network",
+      {"convert"});
+
+  try {
+    parser.ParseCLI(argc, argv);
+  } catch (args::Help) {
+    std::cout << parser;
+    return 0;
+  } catch (args::ParseError e) {
+    std::cerr << e.what() << std::endl;
+    std::cerr << parser;
+    return 1;
+  }
+
+  trtorch::core::util::logging::get_logger().set_reportable_log_level(
+      trtorch::core::util::logging::LogLevel::kWARNING);
+
+  GraphShape shape{depth ? args::get(depth) : 64,
+                   width ? args::get(width) : 4,
+                   control_flow_density ? args::get(control_flow_density) : 0.1,
+                   features ? args::get(features) : 16};
+  int num_steps = steps ? args::get(steps) : 5;
+  int num_iterations = iterations ? args::get(iterations) : 3;
+  bool time_conversion = convert;
+
+  std::vector<size_t> nodes;
+  std::map<std::string, std::vector<double>> stage_times;
+  for (int step = 0; step < num_steps; step++) {
+    auto step_shape = shape;
+    step_shape.depth = shape.depth << step;
+    auto g = MakeSyntheticGraph(step_shape, /*seed=*/step);
+    nodes.push_back(CountNodes(g->block()));
+
+    std::map<std::string, double> fastest;
+    for (int i = 0; i < num_iterations; i++) {
+      for (auto& s : TimeStages(g, step_shape, time_conversion)) {
+        auto iter = fastest.find(s.first);
+        if (iter == fastest.end() || s.second < iter->second) {
+          fastest[s.first] = s.second;
+        }
+      }
+    }
+    for (auto& s : fastest) {
+      auto& times = stage_times[s.first];
+      // Passes which were not run for earlier sizes still line up by size
+      times.resize(step, 0);
+      times.push_back(s.second);
+    }
+
+    std::cout << "depth " << std::setw(6) << step_shape.depth << ", " << std::setw(8) << nodes.back()
+              << " nodes: LowerGraph " << std::fixed << std::setprecision(2) << fastest[LOWER_GRAPH_STAGE]
+              << " ms, support check " << fastest[SUPPORT_CHECK_STAGE] << " ms, evaluators "
+              << fastest[EVALUATOR_STAGE] << " ms";
+    if (time_conversion) {
+      std::cout << ", conversion " << fastest[CONVERSION_STAGE] << " ms";
+    }
+    std::cout << std::endl;
+  }
+
+  if (convert && !time_conversion) {
+    // Conversion was only timed for some of the sizes, which can't be compared
+    stage_times.erase(CONVERSION_STAGE);
+  }
+
+  double exponent_limit = max_exponent ? args::get(max_exponent) : 1.25;
+  double noise_floor = min_time ? args::get(min_time) : 1.0;
+  bool regressed = false;
+
+  std::cout << std::endl << std::left << std::setw(64) << "Stage";
+  for (auto n : nodes) {
+    std::cout << std::right << std::setw(12) << n;
+  }
+  std::cout << std::right << std::setw(10) << "exponent" << std::endl;
+  for (auto& s : stage_times) {
+    auto& times = s.second;
+    times.resize(nodes.size(), 0);
+    auto exponent = ScalingExponent(nodes, times);
+    bool checked = times.back() >= noise_floor;
+    bool superlinear = checked && exponent > exponent_limit;
+    regressed |= superlinear;
+
+    std::cout << std::left << std::setw(64) << s.first << std::right << std::fixed << std::setprecision(2);
+    for (auto t : times) {
+      std::cout << std::setw(12) << t;
+    }
+    std::cout << std::setw(10) << exponent << (superlinear ? "  SUPERLINEAR" : (checked ? "" : "  (noise)"))
+              << std::endl;
+  }
+
+  if (regressed) {
+    std::cerr << std::endl
+              << "One or more stages scale worse than nodes^" << exponent_limit << " (see above)" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -99,6 +99,63 @@ trtorch::CompileSpec::InputRange parseDynamicDim(std::string shape_str) {
   return trtorch::CompileSpec::InputRange(shape[0], shape[1], shape[2]);
 }
 
+trtorch::CompileSpec::LayerPrecision parseLayerPrecision(std::string rule_str) {
+  auto usage =
+      "Layer precisions are a precision followed by comma delimited selectors, \"<precision>:<kind|scope|name>=<pattern>,...\"\n e.g \"float:kind=aten::softmax\"";
+  auto precision_end = rule_str.find(':');
+  if (precision_end == std::string::npos) {
+    trtorch::logging::log(trtorch::logging::Level::kERROR, usage);
+    exit(1);
+  }
+
+  trtorch::CompileSpec::LayerPrecision rule;
+  auto precision = rule_str.substr(0, precision_end);
+  std::transform(
+      precision.begin(), precision.end(), precision.begin(), [](unsigned char c) { return std::tolower(c); });
+  if (precision == "float" || precision == "float32" || precision == "f32") {
+    rule.precision = torch::kF32;
+  } else if (precision == "half" || precision == "float16" || precision == "f16") {
+    rule.precision = torch::kF16;
+  } else if (precision == "int8" || precision == "i8") {
+    rule.precision = torch::kI8;
+  } else {
+    trtorch::logging::log(
+        trtorch::logging::Level::kERROR,
+        "Invalid layer precision, options are [ float | float32 | f32 | half | float16 | f16 | int8 | i8 ]");
+    exit(1);
+  }
+
+  // Patterns are regular expressions so they can hold ':' but not ','
+  std::stringstream selectors(rule_str.substr(precision_end + 1));
+  std::string selector;
+  while (std::getline(selectors, selector, ',')) {
+    auto pattern_start = selector.find('=');
+    if (pattern_start == std::string::npos) {
+      trtorch::logging::log(trtorch::logging::Level::kERROR, usage);
+      exit(1);
+    }
+    auto key = selector.substr(0, pattern_start);
+    auto pattern = selector.substr(pattern_start + 1);
+    if (key == "kind") {
+      rule.kind = pattern;
+    } else if (key == "scope") {
+      rule.scope = pattern;
+    } else if (key == "name") {
+      rule.name = pattern;
+    } else {
+      trtorch::logging::log(
+          trtorch::logging::Level::kERROR, "Invalid layer selector " + key + ", options are [ kind | scope | name ]");
+      exit(1);
+    }
+  }
+
+  if (rule.kind.empty() && rule.scope.empty() && rule.name.empty()) {
+    trtorch::logging::log(trtorch::logging::Level::kERROR, usage);
+    exit(1);
+  }
+  return rule;
+}
+
 std::string get_cwd() {
   char buff[FILENAME_MAX]; // create string buffer to hold path
   if (getcwd(buff, FILENAME_MAX)) {
@@ -166,8 +223,18 @@ int main(int argc, char** argv) {
   args::ValueFlag<std::string> op_precision(
       parser,
       "precision",
-      "Default operating precision for the engine (Int8 requires a calibration-cache argument) [ float | float32 | f32 | half | float16 | f16 | int8 | i8 ] (default: float)",
+      "Default operating precision for the engine (Int8 requires a calibration-cache or calibration-file argument unless the module is quantization aware trained) [ float | float32 | f32 | half | float16 | f16 | int8 | i8 ] (default: float)",
       {'p', "default-op-precision"});
+  args::ValueFlagList<std::string> layer_precisions(
+      parser,
+      "rule",
+      "Run the layers of nodes matching the selectors in a precision other than the default operating precision, the last matching rule wins (can be repeated) \"<precision>:<kind|scope|name>=<pattern>,...\" e.g. \"float:kind=aten::softmax\"",
+      {"layer-precision"});
+  args::ValueFlag<std::string> precision_profile(
+      parser,
+      "file_path",
+      "Path to a precision profile saved by a layer precision search, its rules are applied before any layer-precision rules",
+      {"precision-profile"});
   args::ValueFlag<std::string> device_type(
       parser,
       "type",
@@ -188,6 +255,11 @@ int main(int argc, char** argv) {
       "file_path",
       "Path to calibration cache file to use for post training quantization",
       {"calibration-cache-file"});
+  args::ValueFlag<std::string> calibration_file(
+      parser,
+      "file_path",
+      "Path to activation ranges collected in TorchScript to use for post training quantization",
+      {"calibration-file"});
   args::ValueFlag<int> num_min_timing_iters(
       parser, "num_iters", "Number of minimization timing iterations used to select kernels", {"num-min-timing-iter"});
   args::ValueFlag<int> num_avg_timing_iters(
@@ -207,6 +279,11 @@ int main(int argc, char** argv) {
       "save_engine",
       "Instead of compiling a full a TorchScript program, save the created engine to the path specified as the output path",
       {"save-engine"});
+  args::ValueFlag<std::string> trace_path(
+      parser,
+      "file_path",
+      "Record a timeline of the compilation (and numerical check) and write it to this path as Chrome trace event JSON",
+      {"trace"});
   args::Positional<std::string> input_path(parser, "input_file_path", "Path to input TorchScript file");
   args::Positional<std::string> output_path(
       parser, "output_file_path", "Path for compiled TorchScript (or TensorRT engine) file");
@@ -234,6 +311,10 @@ int main(int argc, char** argv) {
     trtorch::logging::set_reportable_log_level(trtorch::logging::Level::kERROR);
   }
 
+  if (trace_path) {
+    trtorch::enable_tracing();
+  }
+
   std::vector<trtorch::CompileSpec::InputRange> ranges;
   for (const auto shapes : args::get(input_shapes)) {
     if (shapes.rfind("(", 0) == 0) {
@@ -280,14 +361,14 @@ int main(int argc, char** argv) {
       compile_settings.op_precision = torch::kF16;
     } else if (precision == "int8" || precision == "i8") {
       compile_settings.op_precision = torch::kI8;
+      // Quantization aware trained modules carry their own quantization
+      // ranges, anything else fails to compile without a calibration cache or
+      // calibration file
       if (calibration_cache_file) {
         compile_settings.ptq_calibrator = calibrator;
-      } else {
-        trtorch::logging::log(
-            trtorch::logging::Level::kERROR,
-            "If targeting INT8 default operating precision with trtorchc, a calibration cache file must be provided");
-        std::cerr << parser;
-        return 1;
+      }
+      if (calibration_file) {
+        compile_settings.calibration_file = resolve_path(args::get(calibration_file));
       }
     } else {
       trtorch::logging::log(
@@ -321,6 +402,14 @@ int main(int argc, char** argv) {
     }
   }
 
+  for (const auto rule : args::get(layer_precisions)) {
+    compile_settings.layer_precisions.push_back(parseLayerPrecision(rule));
+  }
+
+  if (precision_profile) {
+    compile_settings.precision_profile = resolve_path(args::get(precision_profile));
+  }
+
   if (engine_capability) {
     auto capability = args::get(engine_capability);
     std::transform(
@@ -437,5 +526,9 @@ int main(int argc, char** argv) {
     trt_mod.save(real_output_path);
   }
 
+  if (trace_path) {
+    trtorch::dump_trace(resolve_path(args::get(trace_path)));
+  }
+
   return 0;
 }
@@ -80,6 +80,30 @@ def _parse_op_precision(precision: Any) -> _types.dtype:
                         str(type(precision)))
 
 
+def _parse_layer_precisions(layer_precisions: List[Dict[str, Any]]) -> List[trtorch._C.LayerPrecision]:
+    if not isinstance(layer_precisions, list):
+        raise TypeError("Layer precisions need to be specified as a list of dicts, got: " + str(type(layer_precisions)))
+
+    parsed_layer_precisions = []
+    for l in layer_precisions:
+        if not isinstance(l, dict):
+            raise TypeError("Each layer precision needs to be specified as a dict, got: " + str(type(l)))
+        if "precision" not in l:
+            raise KeyError("Layer precisions require a precision")
+        if not any(k in l for k in ["kind", "scope", "name"]):
+            raise KeyError("Layer precisions require at least one of kind, scope or name to match nodes with")
+
+        layer_precision = trtorch._C.LayerPrecision()
+        for k in ["kind", "scope", "name"]:
+            if k in l:
+                assert isinstance(l[k], str)
+                setattr(layer_precision, k, l[k])
+        layer_precision.precision = _parse_op_precision(l["precision"])
+        parsed_layer_precisions.append(layer_precision)
+
+    return parsed_layer_precisions
+
+
 def _parse_device_type(device: Any) -> _types.DeviceType:
     if isinstance(device, torch.device):
         if device.type == 'cuda':
@@ -135,6 +159,13 @@ def _parse_compile_spec(compile_spec: Dict[str, Any]) -> trtorch._C.CompileSpec:
     if "op_precision" in compile_spec:
         info.op_precision = _parse_op_precision(compile_spec["op_precision"])
 
+    if "layer_precisions" in compile_spec:
+        info.layer_precisions = _parse_layer_precisions(compile_spec["layer_precisions"])
+
+    if "precision_profile" in compile_spec:
+        assert isinstance(compile_spec["precision_profile"], str)
+        info.precision_profile = compile_spec["precision_profile"]
+
     if "refit" in compile_spec:
         assert isinstance(compile_spec["refit"], bool)
         info.refit = compile_spec["refit"]
@@ -205,6 +236,15 @@ def TensorRTCompileSpec(compile_spec: Dict[str, Any]):
                         "allow_gpu_fallback": false, # (DLA only) Allow layers unsupported on DLA to run on GPU
                         },
                         "op_precision": torch.half, # Operating precision set to FP16
+                        "layer_precisions": [
+                            {
+                                "kind": "aten::softmax", # Pattern for the kind of node
+                                "scope": ".*classifier.*", # Pattern for the scope of the node (from tracing)
+                                "name": "", # Pattern for the name of an output of the node
+                                "precision": torch.float # Precision to pin the layers of matching nodes to
+                            }
+                        ], # Precision overrides for specific layers, the last matching rule wins
+                        "precision_profile": "", # Precision overrides saved by trtorch.search_layer_precisions
                         "refit": False, # enable refit
                         "debug": False, # enable debuggable engine
                         "strict_types": False, # kernels should strictly run in operating precision
@@ -243,7 +283,11 @@ def TensorRTCompileSpec(compile_spec: Dict[str, Any]):
         ir.set_allow_gpu_fallback(i.allow_gpu_fallback)
         backend_spec.set_device(ir)
 
+    for l in parsed_spec.layer_precisions:
+        backend_spec.append_layer_precision(l.kind, l.scope, l.name, int(l.precision))
+
     backend_spec.set_op_precision(int(parsed_spec.op_precision))
+    backend_spec.set_precision_profile(parsed_spec.precision_profile)
     backend_spec.set_refit(parsed_spec.refit)
     backend_spec.set_debug(parsed_spec.debug)
     backend_spec.set_refit(parsed_spec.refit)
@@ -3,7 +3,7 @@ import torch
 from torch import nn
 
 import trtorch._C
-from trtorch._compile_spec import _parse_compile_spec
+from trtorch._compile_spec import _parse_compile_spec, _parse_op_precision
 from trtorch._version import __version__
 from types import FunctionType
 
@@ -41,6 +41,10 @@ def compile(module: torch.jit.ScriptModule, compile_spec: Any) -> torch.jit.Scri
                         "allow_gpu_fallback": false, # (DLA only) Allow layers unsupported on DLA to run on GPU
                     },
                     "op_precision": torch.half, # Operating precision set to FP16
+                    "layer_precisions": [
+                        {"kind": "aten::softmax", "precision": torch.float}, # Pin layers of nodes matching kind / scope / name patterns to a precision
+                    ],
+                    "precision_profile": "model.profile", # Precision overrides saved by trtorch.search_layer_precisions
                     "refit": false, # enable refit
                     "debug": false, # enable debuggable engine
                     "strict_types": false, # kernels should strictly run in operating precision
@@ -99,6 +103,10 @@ def convert_method_to_trt_engine(module: torch.jit.ScriptModule, method_name: st
                         "allow_gpu_fallback": false, # (DLA only) Allow layers unsupported on DLA to run on GPU
                     },
                     "op_precision": torch.half, # Operating precision set to FP16
+                    "layer_precisions": [
+                        {"kind": "aten::softmax", "precision": torch.float}, # Pin layers of nodes matching kind / scope / name patterns to a precision
+                    ],
+                    "precision_profile": "model.profile", # Precision overrides saved by trtorch.search_layer_precisions
                     "refit": false, # enable refit
                     "debug": false, # enable debuggable engine
                     "strict_types": false, # kernels should strictly run in operating precision
@@ -123,6 +131,48 @@ def convert_method_to_trt_engine(module: torch.jit.ScriptModule, method_name: st
     return trtorch._C.convert_graph_to_trt_engine(module._c, method_name, _parse_compile_spec(compile_spec))
 
 
+def search_layer_precisions(module: torch.jit.ScriptModule,
+                            method_name: str,
+                            compile_spec: Any,
+                            validation_batches: List[List[torch.Tensor]],
+                            precision_profile: str = "",
+                            threshold: float = 1e-2,
+                            promoted_precision: Any = torch.float) -> List[Dict[str, Any]]:
+    """Find the layers of a method to run in a higher precision than the operating precision
+
+    Starting from the operating precision of the compile spec (FP16 or INT8), compares every activation of
+    the engine against TorchScript on the validation batches to rank layers by the error they add, then
+    promotes the fewest of the top ranked layers needed for the outputs to stay within the threshold. The
+    per layer assignment, error and latency before and after are logged at the info level
+
+    Args:
+        module (torch.jit.ScriptModule): Source module, a result of tracing or scripting a PyTorch
+            ``torch.nn.Module``
+        method_name (str): Name of method to search
+        compile_spec (dict): Compilation settings, same format as for ``trtorch.compile``
+        validation_batches (List[List[torch.Tensor]]): Inputs to the method, a tensor for each input
+            per batch, on the device of the module
+        precision_profile (str): Path to save the precision profile to (not saved if empty), set
+            ``"precision_profile"`` in the compile spec to it to compile with the promotions
+        threshold (float): Largest acceptable deviation of the outputs from TorchScript, relative to the
+            largest magnitude of the TorchScript outputs
+        promoted_precision (torch.dtype or trtorch.dtype): Precision the most error sensitive layers are
+            promoted to
+
+    Returns:
+        List[Dict]: Layer precisions promoting the selected layers (most error sensitive first), in the format
+        of ``"layer_precisions"`` in the compile spec
+    """
+    if isinstance(module, torch.jit.ScriptFunction):
+        raise TypeError(
+            "torch.jit.ScriptFunctions currently are not directly supported, wrap the function in a module to compile")
+
+    promotions = trtorch._C.search_layer_precisions(module._c, method_name, _parse_compile_spec(compile_spec),
+                                                    validation_batches, precision_profile, threshold,
+                                                    _parse_op_precision(promoted_precision))
+    return [{"kind": l.kind, "scope": l.scope, "name": l.name, "precision": l.precision} for l in promotions]
+
+
 def check_method_op_support(module: torch.jit.ScriptModule, method_name: str) -> bool:
     """Checks to see if a method is fully supported by TRTorch
 
@@ -14,24 +14,19 @@ c10::IValue TensorRTBackend::preprocess(c10::IValue mod, c10::impl::GenericDict
   auto mod_ = mod.toModule();
   LOG_DEBUG("Placing module in eval mode if not already");
   mod_.eval();
-  mod_ = core::lowering::LowerModule(mod_);
+  // Checking support lowers each method graph of the frozen module in place,
+  // which is the processed module handed to compile
+  core::lowering::LoweringCache lowering_cache(mod_);
 
   auto spec = c10::impl::toTypedDict<std::string, at::IValue>(method_compile_spec);
 
   for (auto it = spec.begin(), end = spec.end(); it != end; ++it) {
     TRTORCH_CHECK(
-        core::CheckMethodOperatorSupport(mod.toModule(), it->key()),
+        core::CheckMethodOperatorSupport(lowering_cache, it->key()),
         "Method " << it->key() << "cannot be compiled by TRTorch");
   }
 
-  for (auto it = spec.begin(), end = spec.end(); it != end; ++it) {
-    const auto& method_name = it->key();
-    auto method = mod_.get_method(method_name);
-    auto graph = method.graph();
-    core::lowering::LowerGraph(graph);
-  }
-
-  return mod_._ivalue();
+  return lowering_cache.FrozenModule()._ivalue();
 }
 
 c10::impl::GenericDict TensorRTBackend::compile(c10::IValue processed_mod, c10::impl::GenericDict method_compile_spec) {
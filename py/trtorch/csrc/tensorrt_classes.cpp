@@ -48,6 +48,17 @@ nvinfer1::DataType toTRTDataType(DataType value) {
   }
 }
 
+std::string to_str(LayerPrecision& value) {
+  std::stringstream ss;
+  ss << "        {" << std::endl;
+  ss << "            kind: \"" << value.kind << "\"," << std::endl;
+  ss << "            scope: \"" << value.scope << "\"," << std::endl;
+  ss << "            name: \"" << value.name << "\"," << std::endl;
+  ss << "            precision: " << to_str(value.precision) << ',' << std::endl;
+  ss << "        }" << std::endl;
+  return ss.str();
+}
+
 std::string to_str(DeviceType value) {
   switch (value) {
     case DeviceType::kDLA:
@@ -99,6 +110,10 @@ core::CompileSpec CompileSpec::toInternalCompileSpec() {
   }
   auto info = core::CompileSpec(internal_input_ranges);
   info.convert_info.engine_settings.op_precision = toTRTDataType(op_precision);
+  for (auto l : layer_precisions) {
+    info.convert_info.engine_settings.layer_precisions.push_back(l.toInternalLayerPrecisionRule());
+  }
+  info.convert_info.engine_settings.precision_profile = precision_profile;
   info.convert_info.engine_settings.refit = refit;
   info.convert_info.engine_settings.debug = debug;
   info.convert_info.engine_settings.strict_types = strict_types;
@@ -128,6 +143,12 @@ std::string CompileSpec::stringify() {
   }
   ss << "     ]" << std::endl;
   ss << "     \"Op Precision\": " << to_str(op_precision) << std::endl;
+  ss << "     \"Layer Precisions\": [" << std::endl;
+  for (auto l : layer_precisions) {
+    ss << to_str(l);
+  }
+  ss << "     ]" << std::endl;
+  ss << "     \"Precision Profile\": " << precision_profile << std::endl;
   ss << "     \"Refit\": " << refit << std::endl;
   ss << "     \"Debug\": " << debug << std::endl;
   ss << "     \"Strict Types\": " << strict_types << std::endl;
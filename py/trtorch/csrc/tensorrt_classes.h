@@ -42,6 +42,24 @@ enum class DataType : int8_t {
 std::string to_str(DataType value);
 nvinfer1::DataType toTRTDataType(DataType value);
 
+struct LayerPrecision {
+  std::string kind;
+  std::string scope;
+  std::string name;
+  DataType precision = DataType::kFloat;
+
+  core::conversion::LayerPrecisionRule toInternalLayerPrecisionRule() {
+    core::conversion::LayerPrecisionRule rule;
+    rule.kind = kind;
+    rule.scope = scope;
+    rule.name = name;
+    rule.precision = toTRTDataType(precision);
+    return rule;
+  }
+};
+
+std::string to_str(LayerPrecision& value);
+
 enum DeviceType : int8_t {
   kGPU,
   kDLA,
@@ -93,8 +111,18 @@ struct CompileSpec : torch::CustomClassHolder {
   void appendInputRange(const c10::intrusive_ptr<InputRange>& ir) {
     input_ranges.push_back(*ir);
   }
+  void appendLayerPrecision(std::string kind, std::string scope, std::string name, int64_t precision) {
+    TRTORCH_CHECK(precision < 3, "Invalid enum value for layer precision");
+    LayerPrecision l;
+    l.kind = kind;
+    l.scope = scope;
+    l.name = name;
+    l.precision = static_cast<DataType>(precision);
+    layer_precisions.push_back(l);
+  }
 
   ADD_ENUM_GET_SET(op_precision, DataType, 3);
+  ADD_FIELD_GET_SET(precision_profile, std::string);
   ADD_FIELD_GET_SET(refit, bool);
   ADD_FIELD_GET_SET(debug, bool);
   ADD_FIELD_GET_SET(strict_types, bool);
@@ -107,6 +135,8 @@ struct CompileSpec : torch::CustomClassHolder {
 
   std::vector<InputRange> input_ranges;
   DataType op_precision = DataType::kFloat;
+  std::vector<LayerPrecision> layer_precisions;
+  std::string precision_profile = "";
   bool refit = false;
   bool debug = false;
   bool strict_types = false;
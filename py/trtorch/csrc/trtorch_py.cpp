@@ -27,6 +27,36 @@ py::bytes ConvertGraphToTRTEngine(const torch::jit::Module& mod, const std::stri
   return py::bytes(trt_engine);
 }
 
+std::vector<LayerPrecision> SearchLayerPrecisions(
+    const torch::jit::Module& mod,
+    const std::string& method_name,
+    CompileSpec& info,
+    const std::vector<std::vector<at::Tensor>>& validation_batches,
+    const std::string& precision_profile,
+    double threshold,
+    DataType promoted_precision) {
+  py::gil_scoped_acquire gil;
+  core::precision_search::SearchSettings settings;
+  settings.threshold = threshold;
+  settings.promoted_precision = toTRTDataType(promoted_precision);
+  auto result =
+      core::SearchLayerPrecisions(mod, method_name, info.toInternalCompileSpec(), validation_batches, settings);
+  if (!precision_profile.empty()) {
+    core::conversion::WritePrecisionProfile(precision_profile, result.promotions);
+  }
+
+  std::vector<LayerPrecision> promotions;
+  for (auto& r : result.promotions) {
+    LayerPrecision l;
+    l.kind = r.kind;
+    l.scope = r.scope;
+    l.name = r.name;
+    l.precision = promoted_precision;
+    promotions.push_back(l);
+  }
+  return promotions;
+}
+
 bool CheckMethodOperatorSupport(const torch::jit::Module& module, const std::string& method_name) {
   return core::CheckMethodOperatorSupport(module, method_name);
 }
@@ -85,6 +115,13 @@ PYBIND11_MODULE(_C, m) {
       .value("int8", DataType::kChar, "8 bit integer number")
       .export_values();
 
+  py::class_<LayerPrecision>(m, "LayerPrecision")
+      .def(py::init<>())
+      .def_readwrite("kind", &LayerPrecision::kind)
+      .def_readwrite("scope", &LayerPrecision::scope)
+      .def_readwrite("name", &LayerPrecision::name)
+      .def_readwrite("precision", &LayerPrecision::precision);
+
   py::enum_<DeviceType>(m, "DeviceType", "Enum to specify device kinds to build TensorRT engines for")
       .value("GPU", DeviceType::kGPU, "Specify using GPU to execute TensorRT Engine")
       .value("DLA", DeviceType::kDLA, "Specify using DLA to execute TensorRT Engine (Jetson Only)")
@@ -102,6 +139,8 @@ PYBIND11_MODULE(_C, m) {
       .def(py::init<>())
       .def_readwrite("input_ranges", &CompileSpec::input_ranges)
       .def_readwrite("op_precision", &CompileSpec::op_precision)
+      .def_readwrite("layer_precisions", &CompileSpec::layer_precisions)
+      .def_readwrite("precision_profile", &CompileSpec::precision_profile)
       .def_readwrite("refit", &CompileSpec::refit)
       .def_readwrite("debug", &CompileSpec::debug)
       .def_readwrite("strict_types", &CompileSpec::strict_types)
@@ -129,6 +168,10 @@ PYBIND11_MODULE(_C, m) {
       "convert_graph_to_trt_engine",
       &trtorch::pyapi::ConvertGraphToTRTEngine,
       "Given a PyTorch JIT Module, convert forward into a TensorRT engine and return a serialized engine");
+  m.def(
+      "search_layer_precisions",
+      &trtorch::pyapi::SearchLayerPrecisions,
+      "Find the layers of a method to run in a higher precision than the operating precision for its outputs to stay within a threshold of TorchScript");
   m.def(
       "check_method_op_support",
       &trtorch::pyapi::CheckMethodOperatorSupport,
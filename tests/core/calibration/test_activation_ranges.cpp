@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include "core/calibration/calibration.h"
+#include "core/compiler.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+namespace calibration = trtorch::core::calibration;
+
+calibration::CalibrationSettings settings_for(calibration::RangeMethod method, double percentile = 99.99) {
+  calibration::CalibrationSettings settings;
+  settings.method = method;
+  settings.percentile = percentile;
+  return settings;
+}
+
+TEST(Calibration, RangesOfExponentialHistogram) {
+  // Counts falling off exponentially with a scale of 100 bins, bin 1450 is the
+  // last one that is not empty
+  std::vector<double> counts(2048, 0);
+  for (size_t i = 0; i < counts.size(); i++) {
+    counts[i] = std::round(1e6 * std::exp(-(i / 100.0)));
+  }
+  double bin_width = 0.01;
+
+  auto max = calibration::ComputeRange(counts, bin_width, settings_for(calibration::RangeMethod::kMAX));
+  auto percentile = calibration::ComputeRange(counts, bin_width, settings_for(calibration::RangeMethod::kPERCENTILE));
+  auto mse = calibration::ComputeRange(counts, bin_width, settings_for(calibration::RangeMethod::kMSE));
+  auto entropy = calibration::ComputeRange(counts, bin_width, settings_for(calibration::RangeMethod::kENTROPY));
+
+  ASSERT_NEAR(max, 14.51, 1e-4);
+  // -ln(1 - 0.9999) * 100 bins
+  ASSERT_NEAR(percentile, 9.21, 1e-4);
+  // Both trade clipping the tail for resolution below the range
+  ASSERT_GT(mse, percentile);
+  ASSERT_LT(mse, max);
+  ASSERT_GT(entropy, percentile);
+  ASSERT_LT(entropy, max);
+}
+
+TEST(Calibration, MSERangeBalancesRoundingAndClipping) {
+  // 100000 values spread evenly up to 10 and a single outlier at ~20.5. The
+  // squared error of rounding everything below the range grows with the range
+  // as 100000 * (r / 127)^2 / 12 and the one of clipping the outlier shrinks
+  // as (20.475 - r)^2, which balance at r = 13.5
+  std::vector<double> counts(2048, 0);
+  for (size_t i = 0; i < 1000; i++) {
+    counts[i] = 100;
+  }
+  counts[2047] = 1;
+  double bin_width = 0.01;
+
+  auto mse = calibration::ComputeRange(counts, bin_width, settings_for(calibration::RangeMethod::kMSE));
+  ASSERT_NEAR(mse, 13.5, 0.05);
+  auto percentile =
+      calibration::ComputeRange(counts, bin_width, settings_for(calibration::RangeMethod::kPERCENTILE, 99.9));
+  ASSERT_NEAR(percentile, 10.0, 1e-4);
+  ASSERT_FLOAT_EQ(calibration::ComputeRange(counts, bin_width, settings_for(calibration::RangeMethod::kMAX)), 20.48);
+}
+
+TEST(Calibration, HistogramMergesBinsWhenTheMaximumGrows) {
+  calibration::TensorHistogram histogram(100);
+  histogram.Collect(at::linspace(-1, 1, 2001));
+  ASSERT_FLOAT_EQ(histogram.Range(settings_for(calibration::RangeMethod::kMAX)), 1.0);
+
+  histogram.Collect(at::full({1}, 2.0));
+  ASSERT_FLOAT_EQ(histogram.Range(settings_for(calibration::RangeMethod::kMAX)), 2.0);
+  // Half of the values seen are under 0.5, up to the width of the merged bins
+  ASSERT_NEAR(histogram.Range(settings_for(calibration::RangeMethod::kPERCENTILE, 50)), 0.5, 0.03);
+}
+
+TEST(Calibration, CollectActivationRangesOfModule) {
+  torch::jit::Module mod("Calibrated");
+  mod.define(R"JIT(
+    def forward(self, x):
+        return (x * 2.0).relu()
+  )JIT");
+  mod.eval();
+
+  trtorch::core::CompileSpec cfg({trtorch::core::conversion::InputRange(std::vector<int64_t>{4, 8})});
+  std::vector<at::Tensor> batches = {at::linspace(-1, 1, 32).reshape({4, 8}), at::linspace(-3, 3, 32).reshape({4, 8})};
+  size_t next = 0;
+  auto ranges = trtorch::core::CollectActivationRanges(
+      mod,
+      "forward",
+      cfg,
+      [&](std::vector<at::Tensor>& batch) {
+        if (next == batches.size()) {
+          return false;
+        }
+        batch = {batches[next++]};
+        return true;
+      },
+      settings_for(calibration::RangeMethod::kMAX));
+
+  // The input, the product and the relu
+  ASSERT_EQ(ranges.size(), 3u);
+  std::vector<float> values;
+  for (auto& r : ranges) {
+    values.push_back(r.second);
+  }
+  std::sort(values.begin(), values.end());
+  ASSERT_NEAR(values[0], 3.0, 1e-5);
+  ASSERT_NEAR(values[1], 6.0, 1e-5);
+  ASSERT_NEAR(values[2], 6.0, 1e-5);
+
+  std::string path = testing::TempDir() + "activation_ranges.txt";
+  calibration::WriteCalibrationFile(path, ranges);
+  ASSERT_EQ(calibration::ReadCalibrationFile(path), ranges);
+}
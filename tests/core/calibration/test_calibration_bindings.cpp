@@ -0,0 +1,59 @@
+#include <string>
+#include "core/calibration/calibration.h"
+#include "core/util/prelude.h"
+#include "gtest/gtest.h"
+
+namespace calibration = trtorch::core::calibration;
+
+namespace {
+// Calibrators are only used as keys, so any distinct address will do
+const nvinfer1::IInt8Calibrator* fake_calibrator(const int& storage) {
+  return reinterpret_cast<const nvinfer1::IInt8Calibrator*>(&storage);
+}
+} // namespace
+
+TEST(Calibration, CalibrationBindingsOnlyExistWhileRegistered) {
+  int storage = 0;
+  auto calibrator = fake_calibrator(storage);
+  calibration::BindingDims dims;
+  ASSERT_FALSE(calibration::GetCalibrationBindings(calibrator, dims));
+
+  calibration::RegisterCalibrationBindings(calibrator, {{"input_0", {8, 3, 32, 32}}, {"input_1", {8, 16}}});
+  ASSERT_TRUE(calibration::GetCalibrationBindings(calibrator, dims));
+  ASSERT_EQ(dims.size(), 2);
+  ASSERT_EQ(dims["input_0"], std::vector<int64_t>({8, 3, 32, 32}));
+  ASSERT_EQ(dims["input_1"], std::vector<int64_t>({8, 16}));
+
+  ASSERT_NO_THROW(calibration::ReleaseCalibrationBindings(calibrator));
+  ASSERT_FALSE(calibration::GetCalibrationBindings(calibrator, dims));
+}
+
+TEST(Calibration, CalibrationErrorsAreRethrownOnRelease) {
+  int storage = 0;
+  auto calibrator = fake_calibrator(storage);
+  calibration::RegisterCalibrationBindings(calibrator, {});
+  try {
+    TRTORCH_THROW_ERROR("Unexpected binding in calibration");
+  } catch (...) {
+    calibration::RecordCalibrationError(calibrator, std::current_exception());
+  }
+  // Only the first error is kept
+  calibration::RecordCalibrationError(calibrator, std::make_exception_ptr(std::runtime_error("second")));
+
+  try {
+    calibration::ReleaseCalibrationBindings(calibrator);
+    FAIL() << "Expected the recorded error to be rethrown";
+  } catch (trtorch::Error& e) {
+    ASSERT_NE(std::string(e.what()).find("Unexpected binding in calibration"), std::string::npos);
+  }
+  // Released even though it threw
+  ASSERT_NO_THROW(calibration::ReleaseCalibrationBindings(calibrator));
+}
+
+TEST(Calibration, CalibrationErrorsWithoutRegistrationAreLogged) {
+  int storage = 0;
+  auto calibrator = fake_calibrator(storage);
+  ASSERT_NO_THROW(
+      calibration::RecordCalibrationError(calibrator, std::make_exception_ptr(std::runtime_error("no build"))));
+  ASSERT_NO_THROW(calibration::ReleaseCalibrationBindings(calibrator));
+}
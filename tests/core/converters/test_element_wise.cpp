@@ -143,3 +143,32 @@ TEST(Converters, ATenAddWithScalarConvertsCorrectly) {
         return (%3))IR";
   pointwise_test_helper(graph, true);
 }
+
+TEST(Converters, ATenElementWiseWithSharedAndEqualConstantsConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor, %w : Tensor, %w_copy : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : Tensor = aten::add(%0, %w, %1)
+        %3 : Tensor = aten::mul(%2, %w)
+        %4 : Tensor = aten::sub(%3, %w_copy, %1)
+        return (%4))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto in = at::randint(1, 5, {3, 4}, {at::kCUDA});
+  auto w = at::randint(1, 5, {3, 4}, {at::kCUDA});
+
+  auto params = trtorch::core::conversion::get_named_params(g->inputs(), {w, w.clone()});
+  auto jit_results = trtorch::tests::util::RunGraph(g, params, {in});
+
+  params = trtorch::core::conversion::get_named_params(g->inputs(), {w, w.clone()});
+  auto trt_results = trtorch::tests::util::RunGraphEngine(g, params, {in});
+
+  ASSERT_TRUE(trtorch::tests::util::almostEqual(jit_results[0], trt_results[0], 2e-6));
+
+  // %w is frozen once for its two uses and %w_copy reuses it by contents
+  params = trtorch::core::conversion::get_named_params(g->inputs(), {w, w.clone()});
+  auto summary = trtorch::tests::util::SummarizeNetwork(g, params, {in});
+  ASSERT_EQ(summary.layer_counts[nvinfer1::LayerType::kCONSTANT], 1);
+}
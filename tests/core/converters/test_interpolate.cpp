@@ -1,5 +1,8 @@
+#include <memory>
 #include <string>
+#include "c10/cuda/CUDAStream.h"
 #include "core/compiler.h"
+#include "core/conversion/converters/impl/plugins/interpolate_plugin.h"
 #include "gtest/gtest.h"
 #include "tests/util/util.h"
 #include "torch/csrc/jit/ir/irparser.h"
@@ -269,4 +272,100 @@ TEST(Converters, ATenUpsampleTrilinear3dConvertsCorrectly3dOutputSizeWithoutAlig
   auto trt = trt_results[0].reshape(jit_results[0].sizes());
 
   ASSERT_TRUE(trtorch::tests::util::almostEqual(jit_results[0], trt, 2e-6));
-}
\ No newline at end of file
+}
+
+// Runs the interpolation plugin directly on a CUDA stream (without building an
+// engine) so that the modes the converters only fall back to on some versions
+// of TensorRT are covered everywhere. With through_clone set the plugin run is
+// a clone which is never initialized
+at::Tensor run_interpolate_plugin(
+    at::Tensor in,
+    std::vector<int64_t> size,
+    std::string mode,
+    bool align_corners,
+    bool through_clone = false) {
+  using trtorch::core::conversion::converters::impl::plugins::InterpolatePlugin;
+  auto in_shape = in.sizes().vec();
+  auto out_shape = in_shape;
+  std::copy(size.begin(), size.end(), out_shape.begin() + (in_shape.size() - size.size()));
+  auto out = at::zeros(out_shape, in.options());
+
+  InterpolatePlugin original(in_shape, out_shape, size, mode, align_corners);
+  std::unique_ptr<InterpolatePlugin> clone;
+  if (through_clone) {
+    clone.reset(static_cast<InterpolatePlugin*>(original.clone()));
+  } else {
+    EXPECT_EQ(original.initialize(), 0);
+  }
+  auto& plugin = through_clone ? *clone : original;
+
+  nvinfer1::PluginTensorDesc in_desc = {trtorch::core::util::toDims(in_shape), nvinfer1::DataType::kFLOAT,
+                                        nvinfer1::TensorFormat::kLINEAR, 1.f};
+  nvinfer1::PluginTensorDesc out_desc = {trtorch::core::util::toDims(out_shape), nvinfer1::DataType::kFLOAT,
+                                         nvinfer1::TensorFormat::kLINEAR, 1.f};
+  const void* inputs[] = {in.data_ptr()};
+  void* outputs[] = {out.data_ptr()};
+
+  auto stream = c10::cuda::getStreamFromPool();
+  EXPECT_EQ(plugin.enqueue(&in_desc, &out_desc, inputs, outputs, nullptr, stream.stream()), 0);
+  stream.synchronize();
+  plugin.terminate();
+
+  return out;
+}
+
+TEST(Converters, InterpolatePluginMatchesCPUReference) {
+  auto in_1d = at::randint(1, 10, {2, 3, 5}, {at::kCUDA});
+  auto in_2d = at::randint(1, 10, {2, 3, 5, 7}, {at::kCUDA});
+  auto in_3d = at::randint(1, 10, {2, 3, 5, 7, 4}, {at::kCUDA});
+
+  for (bool align_corners : {false, true}) {
+    ASSERT_TRUE(trtorch::tests::util::almostEqual(
+        at::upsample_linear1d(in_1d.cpu(), {11}, align_corners),
+        run_interpolate_plugin(in_1d, {11}, "linear", align_corners).cpu(),
+        2e-6));
+    ASSERT_TRUE(trtorch::tests::util::almostEqual(
+        at::upsample_bilinear2d(in_2d.cpu(), {9, 4}, align_corners),
+        run_interpolate_plugin(in_2d, {9, 4}, "bilinear", align_corners).cpu(),
+        2e-6));
+    ASSERT_TRUE(trtorch::tests::util::almostEqual(
+        at::upsample_trilinear3d(in_3d.cpu(), {8, 3, 6}, align_corners),
+        run_interpolate_plugin(in_3d, {8, 3, 6}, "trilinear", align_corners).cpu(),
+        2e-6));
+  }
+
+  ASSERT_TRUE(trtorch::tests::util::almostEqual(
+      at::adaptive_avg_pool2d(in_2d.cpu(), {3, 4}),
+      run_interpolate_plugin(in_2d, {3, 4}, "adaptive_pool2d", false).cpu(),
+      2e-6));
+}
+
+TEST(Converters, ClonedInterpolatePluginMatchesCPUReference) {
+  auto in_2d = at::randint(1, 10, {2, 3, 5, 7}, {at::kCUDA});
+
+  ASSERT_TRUE(trtorch::tests::util::almostEqual(
+      at::upsample_bilinear2d(in_2d.cpu(), {9, 4}, false),
+      run_interpolate_plugin(in_2d, {9, 4}, "bilinear", false, true).cpu(),
+      2e-6));
+  ASSERT_TRUE(trtorch::tests::util::almostEqual(
+      at::adaptive_avg_pool2d(in_2d.cpu(), {3, 4}),
+      run_interpolate_plugin(in_2d, {3, 4}, "adaptive_pool2d", false, true).cpu(),
+      2e-6));
+}
+
+TEST(Converters, InterpolatePluginReportsUnsupportedModes) {
+  using trtorch::core::conversion::converters::impl::plugins::InterpolatePlugin;
+  auto in = at::randint(1, 10, {2, 3, 5, 7}, {at::kCUDA});
+  auto out = at::zeros({2, 3, 9, 4}, in.options());
+
+  InterpolatePlugin plugin(in.sizes().vec(), out.sizes().vec(), {9, 4}, "bicubic", false);
+  nvinfer1::PluginTensorDesc in_desc = {trtorch::core::util::toDims(in.sizes()), nvinfer1::DataType::kFLOAT,
+                                        nvinfer1::TensorFormat::kLINEAR, 1.f};
+  nvinfer1::PluginTensorDesc out_desc = {trtorch::core::util::toDims(out.sizes()), nvinfer1::DataType::kFLOAT,
+                                         nvinfer1::TensorFormat::kLINEAR, 1.f};
+  const void* inputs[] = {in.data_ptr()};
+  void* outputs[] = {out.data_ptr()};
+
+  auto stream = c10::cuda::getStreamFromPool();
+  ASSERT_NE(plugin.enqueue(&in_desc, &out_desc, inputs, outputs, nullptr, stream.stream()), 0);
+}
@@ -0,0 +1,135 @@
+#include <string>
+#include "core/compiler.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+// Golden layer counts of converted reference graphs. These only record the
+// network definition on the CPU, so they are cheap to run and need no GPU, and
+// fail if a converter starts emitting extra shuffle / constant layers. If a
+// change legitimately alters the layers of a graph, update the expected counts
+// here along with it
+
+void layer_count_test_helper(
+    std::string graph_ir,
+    std::vector<at::Tensor> inputs,
+    std::vector<at::Tensor> weights,
+    std::map<nvinfer1::LayerType, int32_t> expected_layers,
+    int64_t expected_constant_bytes) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph_ir, &*g);
+
+  std::vector<torch::jit::IValue> params(weights.begin(), weights.end());
+  auto named_params = trtorch::core::conversion::get_named_params(g->inputs(), params);
+  auto summary = trtorch::tests::util::SummarizeNetwork(g, named_params, inputs);
+
+  int32_t expected_num_layers = 0;
+  for (auto& l : expected_layers) {
+    expected_num_layers += l.second;
+    EXPECT_EQ(summary.layer_counts[l.first], l.second) << "Layer type " << static_cast<int32_t>(l.first);
+  }
+  ASSERT_EQ(summary.num_layers, expected_num_layers);
+  ASSERT_EQ(summary.constant_bytes, expected_constant_bytes);
+}
+
+TEST(Converters, ConvBatchNormReLUFlattenLinearLayerCounts) {
+  const auto graph = R"IR(
+      graph(%x : Tensor,
+            %conv_w : Float(4, 3, 3, 3),
+            %conv_b : Float(4),
+            %bn_g : Float(4),
+            %bn_b : Float(4),
+            %bn_m : Float(4),
+            %bn_v : Float(4),
+            %fc_w : Float(10, 256),
+            %fc_b : Float(10)):
+        %1 : int = prim::Constant[value=1]()
+        %0 : int = prim::Constant[value=0]()
+        %neg1 : int = prim::Constant[value=-1]()
+        %false : bool = prim::Constant[value=0]()
+        %true : bool = prim::Constant[value=1]()
+        %momentum : float = prim::Constant[value=0.1]()
+        %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+        %s : int[] = prim::ListConstruct(%1, %1)
+        %p : int[] = prim::ListConstruct(%1, %1)
+        %op : int[] = prim::ListConstruct(%0, %0)
+        %c : Tensor = aten::_convolution(%x, %conv_w, %conv_b, %s, %p, %s, %false, %op, %1, %false, %false, %false, %false)
+        %bn : Tensor = aten::batch_norm(%c, %bn_g, %bn_b, %bn_m, %bn_v, %false, %momentum, %eps, %true)
+        %r : Tensor = aten::relu(%bn)
+        %f : Tensor = aten::flatten(%r, %1, %neg1)
+        %out : Tensor = aten::linear(%f, %fc_w, %fc_b)
+        return (%out))IR";
+
+  auto in = at::randn({1, 3, 8, 8});
+  std::vector<at::Tensor> weights = {
+      at::randn({4, 3, 3, 3}),
+      at::randn({4}),
+      at::randn({4}),
+      at::randn({4}),
+      at::randn({4}),
+      at::rand({4}),
+      at::randn({10, 256}),
+      at::randn({10})};
+
+  // flatten and the 2D input of linear each add a shuffle
+  layer_count_test_helper(
+      graph,
+      {in},
+      weights,
+      {{nvinfer1::LayerType::kCONVOLUTION, 1},
+       {nvinfer1::LayerType::kSCALE, 1},
+       {nvinfer1::LayerType::kACTIVATION, 1},
+       {nvinfer1::LayerType::kSHUFFLE, 2},
+       {nvinfer1::LayerType::kFULLY_CONNECTED, 1}},
+      0);
+}
+
+TEST(Converters, BatchNorm1DLayerCounts) {
+  const auto graph = R"IR(
+      graph(%x : Tensor,
+            %bn_g : Float(5),
+            %bn_b : Float(5),
+            %bn_m : Float(5),
+            %bn_v : Float(5)):
+        %false : bool = prim::Constant[value=0]()
+        %true : bool = prim::Constant[value=1]()
+        %momentum : float = prim::Constant[value=0.1]()
+        %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+        %out : Tensor = aten::batch_norm(%x, %bn_g, %bn_b, %bn_m, %bn_v, %false, %momentum, %eps, %true)
+        return (%out))IR";
+
+  auto in = at::randn({4, 5});
+  std::vector<at::Tensor> weights = {
+      at::randn({5}),
+      at::randn({5}),
+      at::randn({5}),
+      at::rand({5})};
+
+  // Inputs under 4D are reshaped in and out of the scale layer
+  layer_count_test_helper(
+      graph, {in}, weights, {{nvinfer1::LayerType::kSHUFFLE, 2}, {nvinfer1::LayerType::kSCALE, 1}}, 0);
+}
+
+TEST(Converters, SharedConstantBroadcastLayerCounts) {
+  const auto graph = R"IR(
+      graph(%x : Tensor,
+            %bias : Float(3)):
+        %1 : int = prim::Constant[value=1]()
+        %a : Tensor = aten::add(%x, %bias, %1)
+        %out : Tensor = aten::mul(%a, %bias)
+        return (%out))IR";
+
+  auto in = at::randn({2, 3});
+  std::vector<at::Tensor> weights = {at::randn({3})};
+
+  // The bias is frozen into a single constant layer shared by both nodes, and
+  // broadcast by a shuffle for each of them
+  layer_count_test_helper(
+      graph,
+      {in},
+      weights,
+      {{nvinfer1::LayerType::kCONSTANT, 1},
+       {nvinfer1::LayerType::kSHUFFLE, 2},
+       {nvinfer1::LayerType::kELEMENTWISE, 2}},
+      12);
+}
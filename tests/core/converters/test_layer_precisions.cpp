@@ -0,0 +1,115 @@
+#include <string>
+#include "core/compiler.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace conversion = trtorch::core::conversion;
+
+namespace {
+// relu -> add -> relu, so rules can pick layers by kind and by output name
+const auto kReLUAddReLUGraph = R"IR(
+    graph(%x : Tensor):
+      %1 : int = prim::Constant[value=1]()
+      %r : Tensor = aten::relu(%x)
+      %s : Tensor = aten::add(%r, %x, %1)
+      %t : Tensor = aten::relu(%s)
+      return (%t))IR";
+
+trtorch::tests::util::NetworkSummary summarize_with_rules(
+    std::vector<conversion::LayerPrecisionRule> rules,
+    nvinfer1::DataType op_precision = nvinfer1::DataType::kFLOAT) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(kReLUAddReLUGraph, &*g);
+  auto named_params = conversion::get_named_params(g->inputs(), {});
+
+  conversion::BuilderSettings settings;
+  settings.op_precision = op_precision;
+  settings.layer_precisions = rules;
+  return trtorch::tests::util::SummarizeNetwork(g, named_params, {at::randn({1, 3, 4, 4})}, settings);
+}
+
+conversion::LayerPrecisionRule rule(std::string kind, std::string name, nvinfer1::DataType precision) {
+  conversion::LayerPrecisionRule r;
+  r.kind = kind;
+  r.name = name;
+  r.precision = precision;
+  return r;
+}
+
+// Precisions of the layers of a type in the order they were added
+std::vector<c10::optional<nvinfer1::DataType>> precisions_of(
+    const trtorch::tests::util::NetworkSummary& summary,
+    nvinfer1::LayerType type) {
+  std::vector<c10::optional<nvinfer1::DataType>> precisions;
+  for (auto& l : summary.layer_precisions) {
+    if (l.first == type) {
+      precisions.push_back(l.second);
+    }
+  }
+  return precisions;
+}
+} // namespace
+
+TEST(Converters, HalfLayerPrecisionRulePinsUnmatchedLayersToFloat) {
+  auto summary = summarize_with_rules({rule("", "r", nvinfer1::DataType::kHALF)});
+
+  auto activations = precisions_of(summary, nvinfer1::LayerType::kACTIVATION);
+  ASSERT_EQ(activations.size(), 2);
+  ASSERT_TRUE(activations[0] && *activations[0] == nvinfer1::DataType::kHALF);
+  // Only %r was requested in FP16, the rest of the engine stays in FP32
+  ASSERT_TRUE(activations[1] && *activations[1] == nvinfer1::DataType::kFLOAT);
+  auto adds = precisions_of(summary, nvinfer1::LayerType::kELEMENTWISE);
+  ASSERT_EQ(adds.size(), 1);
+  ASSERT_TRUE(adds[0] && *adds[0] == nvinfer1::DataType::kFLOAT);
+  ASSERT_TRUE(summary.unmatched_layer_precision_rules.empty());
+}
+
+TEST(Converters, FloatLayerPrecisionRulesLeaveUnmatchedLayersUnpinned) {
+  auto summary = summarize_with_rules({rule("aten::relu", "", nvinfer1::DataType::kFLOAT)});
+
+  for (auto p : precisions_of(summary, nvinfer1::LayerType::kACTIVATION)) {
+    ASSERT_TRUE(p && *p == nvinfer1::DataType::kFLOAT);
+  }
+  auto adds = precisions_of(summary, nvinfer1::LayerType::kELEMENTWISE);
+  ASSERT_EQ(adds.size(), 1);
+  ASSERT_FALSE(adds[0]);
+}
+
+TEST(Converters, HalfLayerPrecisionRulesInHalfEngineLeaveUnmatchedLayersUnpinned) {
+  auto summary = summarize_with_rules({rule("", "r", nvinfer1::DataType::kHALF)}, nvinfer1::DataType::kHALF);
+
+  auto adds = precisions_of(summary, nvinfer1::LayerType::kELEMENTWISE);
+  ASSERT_EQ(adds.size(), 1);
+  ASSERT_FALSE(adds[0]);
+}
+
+TEST(Converters, LastMatchingLayerPrecisionRuleWins) {
+  auto summary = summarize_with_rules(
+      {rule("aten::relu", "", nvinfer1::DataType::kHALF), rule("", "t", nvinfer1::DataType::kFLOAT)});
+  auto activations = precisions_of(summary, nvinfer1::LayerType::kACTIVATION);
+  ASSERT_EQ(activations.size(), 2);
+  ASSERT_TRUE(activations[0] && *activations[0] == nvinfer1::DataType::kHALF);
+  ASSERT_TRUE(activations[1] && *activations[1] == nvinfer1::DataType::kFLOAT);
+
+  summary = summarize_with_rules(
+      {rule("", "t", nvinfer1::DataType::kFLOAT), rule("aten::relu", "", nvinfer1::DataType::kHALF)});
+  activations = precisions_of(summary, nvinfer1::LayerType::kACTIVATION);
+  ASSERT_EQ(activations.size(), 2);
+  ASSERT_TRUE(activations[0] && *activations[0] == nvinfer1::DataType::kHALF);
+  ASSERT_TRUE(activations[1] && *activations[1] == nvinfer1::DataType::kHALF);
+  // Shadowed by the later rule for every node it would match
+  ASSERT_EQ(summary.unmatched_layer_precision_rules.size(), 1);
+  ASSERT_NE(summary.unmatched_layer_precision_rules[0].find("name: \"t\""), std::string::npos);
+}
+
+TEST(Converters, UnmatchedLayerPrecisionRulesAreReported) {
+  auto summary = summarize_with_rules(
+      {rule("aten::relu", "", nvinfer1::DataType::kFLOAT), rule("aten::conv.*", "", nvinfer1::DataType::kHALF)});
+  ASSERT_EQ(summary.unmatched_layer_precision_rules.size(), 1);
+  ASSERT_NE(summary.unmatched_layer_precision_rules[0].find("aten::conv.*"), std::string::npos);
+}
+
+TEST(Converters, LayerPrecisionRuleWithoutPatternsIsRejected) {
+  ASSERT_THROW(summarize_with_rules({rule("", "", nvinfer1::DataType::kHALF)}), trtorch::Error);
+}
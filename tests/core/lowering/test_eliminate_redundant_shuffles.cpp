@@ -0,0 +1,127 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/lowering.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+void CheckShuffleEliminationMatches(const std::string& graph, at::Tensor in) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+  auto ref_g = g->copy();
+
+  trtorch::core::lowering::passes::EliminateRedundantShuffles(g);
+
+  auto params = trtorch::core::conversion::get_named_params(ref_g->inputs(), {});
+  auto ref_results = trtorch::tests::util::RunGraph(ref_g, params, {in});
+  params = trtorch::core::conversion::get_named_params(g->inputs(), {});
+  auto results = trtorch::tests::util::RunGraph(g, params, {in});
+
+  ASSERT_TRUE(trtorch::tests::util::almostEqual(ref_results[0], results[0].reshape_as(ref_results[0]), 2e-6));
+}
+
+TEST(LoweringPasses, EliminateRedundantShufflesCancelsInversePermutes) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : int = prim::Constant[value=0]()
+        %2 : int = prim::Constant[value=1]()
+        %3 : int = prim::Constant[value=2]()
+        %4 : int = prim::Constant[value=3]()
+        %5 : int[] = prim::ListConstruct(%1, %3, %4, %2)
+        %6 : int[] = prim::ListConstruct(%1, %4, %2, %3)
+        %7 : Tensor = aten::permute(%0, %5)
+        %8 : Tensor = aten::permute(%7, %6)
+        %9 : Tensor = aten::relu(%8)
+        return (%9))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+  trtorch::core::lowering::passes::EliminateRedundantShuffles(g);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::permute), 0);
+
+  CheckShuffleEliminationMatches(graph, at::randn({2, 3, 4, 5}, {at::kCUDA}));
+}
+
+TEST(LoweringPasses, EliminateRedundantShufflesComposesPermuteChains) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : int = prim::Constant[value=0]()
+        %2 : int = prim::Constant[value=1]()
+        %3 : int = prim::Constant[value=2]()
+        %4 : int = prim::Constant[value=3]()
+        %5 : int[] = prim::ListConstruct(%1, %3, %4, %2)
+        %6 : int[] = prim::ListConstruct(%2, %1, %3, %4)
+        %7 : int[] = prim::ListConstruct(%4, %3, %2, %1)
+        %8 : Tensor = aten::permute(%0, %5)
+        %9 : Tensor = aten::permute(%8, %6)
+        %10 : Tensor = aten::permute(%9, %7)
+        return (%10))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+  trtorch::core::lowering::passes::EliminateRedundantShuffles(g);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::permute), 1);
+
+  CheckShuffleEliminationMatches(graph, at::randn({2, 3, 4, 5}, {at::kCUDA}));
+}
+
+TEST(LoweringPasses, EliminateRedundantShufflesFoldsTransposeOfKnownRank) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : int = prim::Constant[value=0]()
+        %2 : int = prim::Constant[value=1]()
+        %3 : int = prim::Constant[value=2]()
+        %4 : int[] = prim::ListConstruct(%3, %1, %2)
+        %5 : Tensor = aten::permute(%0, %4)
+        %6 : Tensor = aten::transpose(%5, %1, %3)
+        return (%6))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+  trtorch::core::lowering::passes::EliminateRedundantShuffles(g);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::transpose), 0);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::permute), 1);
+
+  CheckShuffleEliminationMatches(graph, at::randn({2, 3, 4}, {at::kCUDA}));
+}
+
+TEST(LoweringPasses, EliminateRedundantShufflesMergesReshapes) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : int = prim::Constant[value=-1]()
+        %3 : int = prim::Constant[value=6]()
+        %4 : int = prim::Constant[value=20]()
+        %5 : Tensor = aten::flatten(%0, %1, %2)
+        %6 : int[] = prim::ListConstruct(%3, %4)
+        %7 : Tensor = aten::view(%5, %6)
+        %8 : int[] = prim::ListConstruct(%2)
+        %9 : Tensor = aten::reshape(%7, %8)
+        return (%9))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+  trtorch::core::lowering::passes::EliminateRedundantShuffles(g);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::flatten), 0);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::view), 0);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::reshape), 1);
+
+  CheckShuffleEliminationMatches(graph, at::randn({2, 3, 4, 5}, {at::kCUDA}));
+}
+
+TEST(LoweringPasses, LoweringEliminatesIdentityReshapeOfSpecializedInput) {
+  torch::jit::Module mod("IdentityReshape");
+  mod.define(R"JIT(
+    def forward(self, x):
+        return x.reshape([2, 4]).relu()
+  )JIT");
+  mod.eval();
+
+  // The size of x is only known once the graph is specialized on the input shape
+  auto lowered = trtorch::core::lowering::Lower(mod, "forward", {{{2, 4}, {2, 4}}});
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(lowered.first, torch::jit::aten::reshape), 0);
+
+  lowered = trtorch::core::lowering::Lower(mod, "forward", {{{1, 4}, {2, 8}}});
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(lowered.first, torch::jit::aten::reshape), 1);
+}
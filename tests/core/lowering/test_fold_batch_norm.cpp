@@ -0,0 +1,136 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+void fold_batch_norm_test_helper(
+    std::string graph_ir,
+    at::Tensor in,
+    std::vector<at::Tensor> weights,
+    int64_t num_bn_channels) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph_ir, &*g);
+
+  auto gamma = at::rand({num_bn_channels}, {at::kCUDA}) + 0.5;
+  auto beta = at::randn({num_bn_channels}, {at::kCUDA});
+  auto mean = at::randn({num_bn_channels}, {at::kCUDA});
+  auto var = at::rand({num_bn_channels}, {at::kCUDA}) + 0.5;
+  weights.insert(weights.end(), {gamma, beta, mean, var});
+  trtorch::tests::util::FreezeGraphInputs(g, weights);
+
+  auto params = trtorch::core::conversion::get_named_params(g->inputs(), {});
+  auto ref_results = trtorch::tests::util::RunGraph(g, params, {in});
+
+  trtorch::core::lowering::passes::FoldBatchNorm(g);
+  for (auto n : g->nodes()) {
+    ASSERT_NE(n->kind(), torch::jit::aten::batch_norm);
+  }
+
+  params = trtorch::core::conversion::get_named_params(g->inputs(), {});
+  auto folded_results = trtorch::tests::util::RunGraph(g, params, {in});
+
+  ASSERT_TRUE(trtorch::tests::util::almostEqual(ref_results[0], folded_results[0], 2e-5));
+}
+
+TEST(LoweringPasses, FoldBatchNormIntoConvolutionCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Tensor,
+            %2 : Tensor,
+            %gamma : Tensor,
+            %beta : Tensor,
+            %mean : Tensor,
+            %var : Tensor):
+        %3 : int = prim::Constant[value=1]()
+        %4 : int = prim::Constant[value=0]()
+        %7 : bool = prim::Constant[value=0]()
+        %8 : int[] = prim::ListConstruct(%3, %3)
+        %9 : int[] = prim::ListConstruct(%4, %4)
+        %12 : Tensor = aten::_convolution(%0, %1, %2, %8, %9, %8, %7, %9, %3, %7, %7, %7, %7)
+        %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+        %momentum : float = prim::Constant[value=0.10000000000000001]()
+        %13 : Tensor = aten::batch_norm(%12, %gamma, %beta, %mean, %var, %7, %momentum, %eps, %7)
+        return (%13))IR";
+
+  auto in = at::randn({1, 3, 10, 10}, {at::kCUDA});
+  auto w = at::randn({8, 3, 5, 5}, {at::kCUDA});
+  auto b = at::randn({8}, {at::kCUDA});
+  fold_batch_norm_test_helper(graph, in, {w, b}, 8);
+}
+
+TEST(LoweringPasses, FoldBatchNormIntoGroupedTransposedConvolutionCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Tensor,
+            %2 : Tensor,
+            %gamma : Tensor,
+            %beta : Tensor,
+            %mean : Tensor,
+            %var : Tensor):
+        %3 : int = prim::Constant[value=1]()
+        %4 : int = prim::Constant[value=0]()
+        %groups : int = prim::Constant[value=2]()
+        %7 : bool = prim::Constant[value=0]()
+        %transposed : bool = prim::Constant[value=1]()
+        %8 : int[] = prim::ListConstruct(%3, %3)
+        %9 : int[] = prim::ListConstruct(%4, %4)
+        %12 : Tensor = aten::_convolution(%0, %1, %2, %8, %9, %8, %transposed, %9, %groups, %7, %7, %7, %7)
+        %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+        %momentum : float = prim::Constant[value=0.10000000000000001]()
+        %13 : Tensor = aten::batch_norm(%12, %gamma, %beta, %mean, %var, %7, %momentum, %eps, %7)
+        return (%13))IR";
+
+  auto in = at::randn({1, 4, 10, 10}, {at::kCUDA});
+  auto w = at::randn({4, 3, 3, 3}, {at::kCUDA});
+  auto b = at::randn({6}, {at::kCUDA});
+  fold_batch_norm_test_helper(graph, in, {w, b}, 6);
+}
+
+TEST(LoweringPasses, FoldBatchNormIntoLinearCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Tensor,
+            %2 : Tensor,
+            %gamma : Tensor,
+            %beta : Tensor,
+            %mean : Tensor,
+            %var : Tensor):
+        %7 : bool = prim::Constant[value=0]()
+        %12 : Tensor = aten::linear(%0, %1, %2)
+        %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+        %momentum : float = prim::Constant[value=0.10000000000000001]()
+        %13 : Tensor = aten::batch_norm(%12, %gamma, %beta, %mean, %var, %7, %momentum, %eps, %7)
+        return (%13))IR";
+
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto w = at::randn({10, 16}, {at::kCUDA});
+  auto b = at::randn({10}, {at::kCUDA});
+  fold_batch_norm_test_helper(graph, in, {w, b}, 10);
+}
+
+TEST(LoweringPasses, FoldBatchNormIntoConv1dWithoutBiasCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Tensor,
+            %gamma : Tensor,
+            %beta : Tensor,
+            %mean : Tensor,
+            %var : Tensor):
+        %2 : None = prim::Constant()
+        %3 : int = prim::Constant[value=1]()
+        %4 : int = prim::Constant[value=0]()
+        %7 : bool = prim::Constant[value=0]()
+        %8 : int[] = prim::ListConstruct(%3)
+        %9 : int[] = prim::ListConstruct(%4)
+        %12 : Tensor = aten::conv1d(%0, %1, %2, %8, %9, %8, %3)
+        %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+        %momentum : float = prim::Constant[value=0.10000000000000001]()
+        %13 : Tensor = aten::batch_norm(%12, %gamma, %beta, %mean, %var, %7, %momentum, %eps, %7)
+        return (%13))IR";
+
+  auto in = at::randn({1, 3, 16}, {at::kCUDA});
+  auto w = at::randn({8, 3, 5}, {at::kCUDA});
+  fold_batch_norm_test_helper(graph, in, {w}, 8);
+}
@@ -0,0 +1,63 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+TEST(LoweringPasses, FoldConstantSubgraphsFoldsWeightTranspose) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  auto x = g->addInput("x");
+  auto w = g->insertConstant(at::randn({3, 4}, {at::kCUDA}));
+  auto w_t = g->insert(torch::jit::aten::t, {w});
+  auto scale = g->insertConstant(at::randn({1}, {at::kCUDA}));
+  auto w_scaled = g->insert(torch::jit::aten::mul, {w_t, scale});
+  auto out = g->insert(torch::jit::aten::matmul, {x, w_scaled});
+  g->registerOutput(out);
+
+  auto ref_g = g->copy();
+  trtorch::core::lowering::passes::FoldConstantSubgraphs(g);
+
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::t), 0);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::mul), 0);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::matmul), 1);
+
+  auto in = at::randn({2, 4}, {at::kCUDA});
+  auto params = trtorch::core::conversion::get_named_params(ref_g->inputs(), {});
+  auto ref_results = trtorch::tests::util::RunGraph(ref_g, params, {in});
+  params = trtorch::core::conversion::get_named_params(g->inputs(), {});
+  auto folded_results = trtorch::tests::util::RunGraph(g, params, {in});
+
+  ASSERT_TRUE(folded_results[0].device() == ref_results[0].device());
+  ASSERT_TRUE(trtorch::tests::util::almostEqual(ref_results[0], folded_results[0], 2e-6));
+}
+
+TEST(LoweringPasses, FoldConstantSubgraphsLeavesRuntimeOpsAlone) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::t(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  trtorch::core::lowering::passes::FoldConstantSubgraphs(g);
+
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::t), 1);
+}
+
+TEST(LoweringPasses, FoldConstantSubgraphsKeepsFactoryOpDevice) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  auto size = g->insertConstant(std::vector<int64_t>{2, 3});
+  auto none = g->insertConstant(c10::IValue());
+  auto device = g->insertConstant(c10::Device(at::kCUDA, 0));
+  auto zeros = g->insert(torch::jit::aten::zeros, {size, none, none, device, none});
+  g->registerOutput(zeros);
+
+  trtorch::core::lowering::passes::FoldConstantSubgraphs(g);
+
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::zeros), 0);
+  auto folded = torch::jit::toIValue(g->outputs()[0]);
+  ASSERT_TRUE(folded.has_value());
+  ASSERT_TRUE(folded->toTensor().device() == c10::Device(at::kCUDA, 0));
+}
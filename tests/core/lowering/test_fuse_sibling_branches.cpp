@@ -0,0 +1,88 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+void fuse_sibling_branches_test_helper(
+    std::string graph_ir,
+    at::Tensor in,
+    std::vector<at::Tensor> weights,
+    torch::jit::NodeKind kind,
+    size_t expected_nodes) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph_ir, &*g);
+  trtorch::tests::util::FreezeGraphInputs(g, weights);
+
+  auto params = trtorch::core::conversion::get_named_params(g->inputs(), {});
+  auto ref_results = trtorch::tests::util::RunGraph(g, params, {in});
+
+  trtorch::core::lowering::passes::FuseSiblingBranches(g);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, kind), expected_nodes);
+
+  params = trtorch::core::conversion::get_named_params(g->inputs(), {});
+  auto fused_results = trtorch::tests::util::RunGraph(g, params, {in});
+
+  ASSERT_EQ(ref_results.size(), fused_results.size());
+  for (size_t i = 0; i < ref_results.size(); i++) {
+    ASSERT_TRUE(trtorch::tests::util::almostEqual(ref_results[i], fused_results[i], 2e-5));
+  }
+}
+
+TEST(LoweringPasses, FuseSiblingLinearProjectionsCorrectly) {
+  const auto graph = R"IR(
+      graph(%x : Tensor,
+            %w_q : Tensor,
+            %b_q : Tensor,
+            %w_k : Tensor,
+            %b_k : Tensor,
+            %w_v : Tensor):
+        %none : None = prim::Constant()
+        %q : Tensor = aten::linear(%x, %w_q, %b_q)
+        %k : Tensor = aten::linear(%x, %w_k, %b_k)
+        %v : Tensor = aten::linear(%x, %w_v, %none)
+        return (%q, %k, %v))IR";
+
+  auto in = at::randn({2, 7, 16}, {at::kCUDA});
+  auto w_q = at::randn({16, 16}, {at::kCUDA});
+  auto b_q = at::randn({16}, {at::kCUDA});
+  auto w_k = at::randn({8, 16}, {at::kCUDA});
+  auto b_k = at::randn({8}, {at::kCUDA});
+  auto w_v = at::randn({24, 16}, {at::kCUDA});
+  fuse_sibling_branches_test_helper(graph, in, {w_q, b_q, w_k, b_k, w_v}, torch::jit::aten::linear, 1);
+}
+
+TEST(LoweringPasses, FuseSiblingConvolutionsCorrectly) {
+  const auto graph = R"IR(
+      graph(%x : Tensor,
+            %w_a : Tensor,
+            %b_a : Tensor,
+            %w_b : Tensor,
+            %b_b : Tensor,
+            %w_c : Tensor,
+            %b_c : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %0 : int = prim::Constant[value=0]()
+        %2 : int = prim::Constant[value=2]()
+        %false : bool = prim::Constant[value=0]()
+        %s1 : int[] = prim::ListConstruct(%1, %1)
+        %p1 : int[] = prim::ListConstruct(%1, %1)
+        %s2 : int[] = prim::ListConstruct(%2, %2)
+        %p0 : int[] = prim::ListConstruct(%0, %0)
+        %a : Tensor = aten::_convolution(%x, %w_a, %b_a, %s1, %p1, %s1, %false, %p0, %1, %false, %false, %false, %false)
+        %b : Tensor = aten::_convolution(%x, %w_b, %b_b, %s1, %p1, %s1, %false, %p0, %1, %false, %false, %false, %false)
+        %c : Tensor = aten::_convolution(%x, %w_c, %b_c, %s2, %p1, %s1, %false, %p0, %1, %false, %false, %false, %false)
+        return (%a, %b, %c))IR";
+
+  auto in = at::randn({1, 3, 10, 10}, {at::kCUDA});
+  auto w_a = at::randn({4, 3, 3, 3}, {at::kCUDA});
+  auto b_a = at::randn({4}, {at::kCUDA});
+  auto w_b = at::randn({6, 3, 3, 3}, {at::kCUDA});
+  auto b_b = at::randn({6}, {at::kCUDA});
+  auto w_c = at::randn({5, 3, 3, 3}, {at::kCUDA});
+  auto b_c = at::randn({5}, {at::kCUDA});
+  // The strided convolution cannot be merged with the other two
+  fuse_sibling_branches_test_helper(
+      graph, in, {w_a, b_a, w_b, b_b, w_c, b_c}, torch::jit::aten::_convolution, 2);
+}
@@ -0,0 +1,77 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+TEST(LoweringPasses, LowerFakeQuantizeReplacesActivationsWithDynamicRange) {
+  const auto graph = R"IR(
+      graph(%x : Tensor):
+        %scale : float = prim::Constant[value=0.5]()
+        %zero_point : int = prim::Constant[value=0]()
+        %quant_min : int = prim::Constant[value=-128]()
+        %quant_max : int = prim::Constant[value=127]()
+        %y : Tensor = aten::fake_quantize_per_tensor_affine(%x, %scale, %zero_point, %quant_min, %quant_max)
+        %z : Tensor = aten::relu(%y)
+        return (%z))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  trtorch::core::lowering::passes::LowerFakeQuantize(g);
+
+  auto range = g->outputs()[0]->node()->input(0)->node();
+  ASSERT_EQ(range->kind(), c10::Symbol::fromQualString("trt::dynamic_range"));
+  ASSERT_EQ(range->input(0), g->inputs()[0]);
+  ASSERT_DOUBLE_EQ(torch::jit::toIValue(range->input(1))->toDouble(), -64.0);
+  ASSERT_DOUBLE_EQ(torch::jit::toIValue(range->input(2))->toDouble(), 63.5);
+}
+
+TEST(LoweringPasses, LowerFakeQuantizeFoldsPerChannelWeights) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  auto x = g->addInput("x");
+  auto w = at::randn({4, 8}, {at::kCUDA});
+  auto scale = at::rand({4}, {at::kCUDA}) / 64 + 1e-3;
+  auto zero_point = at::zeros({4}, at::TensorOptions().dtype(at::kLong).device(at::kCUDA));
+  auto w_q = g->insertNode(g->create(
+                               c10::Symbol::fromQualString("aten::fake_quantize_per_channel_affine"),
+                               {g->insertConstant(w),
+                                g->insertConstant(scale),
+                                g->insertConstant(zero_point),
+                                g->insertConstant(0),
+                                g->insertConstant(-128),
+                                g->insertConstant(127)}))
+                 ->output();
+  g->registerOutput(g->insert(torch::jit::aten::matmul, {x, g->insert(torch::jit::aten::t, {w_q})}));
+
+  trtorch::core::lowering::passes::LowerFakeQuantize(g);
+
+  for (auto n : g->nodes()) {
+    ASSERT_NE(n->kind(), c10::Symbol::fromQualString("aten::fake_quantize_per_channel_affine"));
+  }
+  auto folded = torch::jit::toIValue(g->outputs()[0]->node()->input(1)->node()->input(0));
+  ASSERT_TRUE(folded && folded->isTensor());
+  auto expected = at::fake_quantize_per_channel_affine(w, scale, zero_point, 0, -128, 127);
+  ASSERT_TRUE(trtorch::tests::util::almostEqual(folded->toTensor(), expected, 2e-6));
+}
+
+TEST(LoweringPasses, LowerFakeQuantizeLeavesPerChannelActivationsAlone) {
+  const auto graph = R"IR(
+      graph(%x : Tensor,
+            %scale : Tensor,
+            %zero_point : Tensor):
+        %axis : int = prim::Constant[value=1]()
+        %quant_min : int = prim::Constant[value=-128]()
+        %quant_max : int = prim::Constant[value=127]()
+        %y : Tensor = aten::fake_quantize_per_channel_affine(%x, %scale, %zero_point, %axis, %quant_min, %quant_max)
+        return (%y))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  trtorch::core::lowering::passes::LowerFakeQuantize(g);
+
+  ASSERT_EQ(
+      g->outputs()[0]->node()->kind(), c10::Symbol::fromQualString("aten::fake_quantize_per_channel_affine"));
+}
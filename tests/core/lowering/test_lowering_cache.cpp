@@ -0,0 +1,54 @@
+#include <string>
+#include "core/lowering/lowering.h"
+#include "torch/csrc/jit/ir/constants.h"
+#include "core/util/prelude.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(LoweringCache, ReleaseDropsTheFrozenWeightsOfAMethod) {
+  torch::jit::Module mod("Weighted");
+  mod.register_parameter("weight", at::randn({2, 4}), false);
+  mod.define(R"JIT(
+    def forward(self, x):
+        return x + self.weight
+  )JIT");
+  mod.eval();
+
+  trtorch::core::lowering::LoweringCache lowering_cache(mod);
+  auto lowered = lowering_cache.Lower("forward");
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(lowered.first, torch::jit::aten::add), 1);
+  // The weight is frozen into a constant shared by the lowered graph and the
+  // frozen method
+  c10::optional<c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>> frozen_weight;
+  for (auto n : lowered.first->nodes()) {
+    auto ivalue = torch::jit::toIValue(n->output());
+    if (n->kind() == torch::jit::prim::Constant && ivalue && ivalue->isTensor()) {
+      frozen_weight = c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>(
+          ivalue->toTensor().getIntrusivePtr());
+    }
+  }
+  ASSERT_TRUE(frozen_weight);
+  ASSERT_FALSE(frozen_weight->expired());
+  lowered = {};
+
+  lowering_cache.Release("forward");
+  ASSERT_TRUE(frozen_weight->expired());
+  ASSERT_THROW(lowering_cache.Lower("forward"), trtorch::Error);
+}
+
+TEST(LoweringCache, FrozenModuleIsNotAvailableOnceAMethodIsReleased) {
+  torch::jit::Module mod("Weighted");
+  mod.register_parameter("weight", at::randn({2, 4}), false);
+  mod.define(R"JIT(
+    def forward(self, x):
+        return x + self.weight
+  )JIT");
+  mod.eval();
+
+  trtorch::core::lowering::LoweringCache lowering_cache(mod);
+  lowering_cache.Lower("forward");
+  ASSERT_NO_THROW(lowering_cache.FrozenModule().get_method("forward"));
+
+  lowering_cache.Release("forward");
+  ASSERT_THROW(lowering_cache.FrozenModule(), trtorch::Error);
+}
@@ -0,0 +1,101 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "core/util/prelude.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+TEST(LoweringPasses, NarrowInt64ToInt32NarrowsIndexInputs) {
+  const auto graph = R"IR(
+      graph(%weight : Tensor,
+            %ids : Tensor):
+        %pad : int = prim::Constant[value=-1]()
+        %false : bool = prim::Constant[value=0]()
+        %emb : Tensor = aten::embedding(%weight, %ids, %pad, %false, %false)
+        return (%emb))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  trtorch::core::lowering::passes::NarrowInt64ToInt32(g);
+
+  auto ids_type = g->inputs()[1]->type()->expect<c10::TensorType>();
+  ASSERT_TRUE(ids_type->scalarType() && *ids_type->scalarType() == at::kInt);
+  auto weight_type = g->inputs()[0]->type()->expect<c10::TensorType>();
+  ASSERT_FALSE(weight_type->scalarType());
+}
+
+TEST(LoweringPasses, NarrowInt64ToInt32NarrowsConstantsThatFit) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  auto x = g->addInput("x");
+  auto small = g->insertConstant(at::arange(4, {at::kLong}));
+  auto large = g->insertConstant(at::full({2}, int64_t(1) << 40, {at::kLong}));
+  g->registerOutput(g->insert(torch::jit::aten::add, {x, small}));
+  g->registerOutput(g->insert(torch::jit::aten::add, {x, large}));
+
+  trtorch::core::lowering::passes::NarrowInt64ToInt32(g);
+
+  auto small_const = g->outputs()[0]->node()->input(1);
+  auto large_const = g->outputs()[1]->node()->input(1);
+  ASSERT_EQ(torch::jit::toIValue(small_const)->toTensor().scalar_type(), at::kInt);
+  ASSERT_EQ(torch::jit::toIValue(large_const)->toTensor().scalar_type(), at::kLong);
+}
+
+TEST(LoweringPasses, NarrowInt64ToInt32RewritesInt64Casts) {
+  const auto graph = R"IR(
+      graph(%x : Tensor):
+        %long : int = prim::Constant[value=4]()
+        %false : bool = prim::Constant[value=0]()
+        %none : None = prim::Constant()
+        %y : Tensor = aten::to(%x, %long, %false, %false, %none)
+        return (%y))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  trtorch::core::lowering::passes::NarrowInt64ToInt32(g);
+
+  // The cast inside the engine produces int32 and is cast back to int64 at the output
+  auto out_cast = g->outputs()[0]->node();
+  ASSERT_TRUE(trtorch::core::util::isInt64OutputCast(out_cast));
+  auto inner_cast = out_cast->input(0)->node();
+  ASSERT_EQ(inner_cast->kind(), torch::jit::aten::to);
+  auto dtype = torch::jit::toIValue(inner_cast->input(1));
+  ASSERT_TRUE(dtype && static_cast<at::ScalarType>(dtype->toInt()) == at::kInt);
+}
+
+TEST(LoweringPasses, NarrowInt64ToInt32CastsNarrowedOutputsBackToInt64) {
+  const auto graph = R"IR(
+      graph(%ids : Long(4, 2),
+            %x : Float(4, 2)):
+        %0 : int = prim::Constant[value=0]()
+        %1 : int = prim::Constant[value=1]()
+        %flat : Tensor = aten::flatten(%ids, %0, %1)
+        %y : Tensor = aten::flatten(%x, %0, %1)
+        return (%flat, %y))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  trtorch::core::lowering::passes::NarrowInt64ToInt32(g);
+
+  ASSERT_TRUE(trtorch::core::util::isInt64OutputCast(g->outputs()[0]->node()));
+  ASSERT_EQ(g->outputs()[0]->node()->input(0)->node()->kind(), torch::jit::aten::flatten);
+  ASSERT_EQ(g->outputs()[1]->node()->kind(), torch::jit::aten::flatten);
+}
+
+TEST(LoweringPasses, Int64CastsInTheSourceGraphAreNotOutputCasts) {
+  const auto graph = R"IR(
+      graph(%x : Tensor):
+        %long : int = prim::Constant[value=4]()
+        %false : bool = prim::Constant[value=0]()
+        %none : None = prim::Constant()
+        %y : Tensor = aten::to(%x, %long, %false, %false, %none)
+        return (%y))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  ASSERT_FALSE(trtorch::core::util::isInt64OutputCast(g->outputs()[0]->node()));
+}
@@ -0,0 +1,94 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+const auto shape_dependent_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : int = prim::Constant[value=4]()
+        %3 : int = aten::size(%0, %1)
+        %4 : bool = aten::eq(%3, %2)
+        %5 : Tensor = prim::If(%4)
+          block0():
+            %6 : Tensor = aten::relu(%0)
+            -> (%6)
+          block1():
+            %7 : Tensor = aten::sigmoid(%0)
+            -> (%7)
+        return (%5))IR";
+
+TEST(LoweringPasses, SpecializeInputShapesFoldsStaticSizeAndBranch) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(shape_dependent_graph, &*g);
+  auto ref_g = g->copy();
+
+  trtorch::core::lowering::passes::SpecializeInputShapes(g, {{{2, 4}, {2, 4}}});
+
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::size), 0);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::prim::If), 0);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::relu), 1);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::sigmoid), 0);
+
+  auto in = at::randn({2, 4}, {at::kCUDA});
+  auto params = trtorch::core::conversion::get_named_params(ref_g->inputs(), {});
+  auto ref_results = trtorch::tests::util::RunGraph(ref_g, params, {in});
+  params = trtorch::core::conversion::get_named_params(g->inputs(), {});
+  auto results = trtorch::tests::util::RunGraph(g, params, {in});
+
+  ASSERT_TRUE(trtorch::tests::util::almostEqual(ref_results[0], results[0], 2e-6));
+}
+
+TEST(LoweringPasses, SpecializeInputShapesLeavesDynamicDimensions) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(shape_dependent_graph, &*g);
+
+  trtorch::core::lowering::passes::SpecializeInputShapes(g, {{{2, 1}, {2, 8}}});
+
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::size), 1);
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::prim::If), 1);
+}
+
+TEST(LoweringPasses, SpecializeInputShapesFoldsRankOfDynamicInput) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : int = aten::dim(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  trtorch::core::lowering::passes::SpecializeInputShapes(g, {{{1, 3, 16, 16}, {8, 3, 32, 32}}});
+
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::dim), 0);
+  auto out = torch::jit::toIValue(g->outputs()[0]);
+  ASSERT_TRUE(out && out->toInt() == 4);
+}
+
+TEST(LoweringPasses, SpecializeInputShapesSkipsNonTensorInputs) {
+  const auto graph = R"IR(
+      graph(%0 : int,
+            %1 : Tensor,
+            %2 : Tensor):
+        %3 : int = prim::Constant[value=1]()
+        %4 : int = aten::size(%1, %3)
+        %5 : int = aten::size(%2, %3)
+        %6 : int = aten::add(%4, %5)
+        %7 : int = aten::add(%6, %0)
+        return (%7))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  // The shapes describe %1 and %2, the int input ahead of them is skipped
+  trtorch::core::lowering::passes::SpecializeInputShapes(g, {{{2, 4}, {2, 4}}, {{3, 5}, {3, 5}}});
+
+  ASSERT_EQ(trtorch::tests::util::CountNodesOfKind(g, torch::jit::aten::size), 0);
+  auto sizes = g->inputs()[2]->type()->expect<c10::TensorType>()->sizes().concrete_sizes();
+  ASSERT_TRUE(sizes && *sizes == std::vector<int64_t>({3, 5}));
+  ASSERT_EQ(g->outputs()[0]->node()->kind(), torch::jit::aten::add);
+  auto folded = torch::jit::toIValue(g->outputs()[0]->node()->input(0));
+  ASSERT_TRUE(folded && folded->toInt() == 9);
+}
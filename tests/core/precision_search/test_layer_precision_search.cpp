@@ -0,0 +1,194 @@
+#include <string>
+#include <unordered_map>
+#include "core/compiler.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace conversion = trtorch::core::conversion;
+
+TEST(PrecisionSearch, PrecisionProfileRoundTrips) {
+  std::vector<conversion::LayerPrecisionRule> rules(2);
+  rules[0].kind = "aten::_convolution";
+  rules[0].name = "input\\.4";
+  rules[0].precision = nvinfer1::DataType::kFLOAT;
+  rules[1].scope = ".*classifier.*";
+  rules[1].precision = nvinfer1::DataType::kHALF;
+
+  std::string path = testing::TempDir() + "model.profile";
+  conversion::WritePrecisionProfile(path, rules);
+  auto read = conversion::ReadPrecisionProfile(path);
+
+  ASSERT_EQ(read.size(), rules.size());
+  for (size_t i = 0; i < rules.size(); i++) {
+    ASSERT_EQ(read[i].kind, rules[i].kind);
+    ASSERT_EQ(read[i].scope, rules[i].scope);
+    ASSERT_EQ(read[i].name, rules[i].name);
+    ASSERT_EQ(read[i].precision, rules[i].precision);
+  }
+}
+
+TEST(PrecisionSearch, ActivationsOfConvertedNodesAreMarkedAsOutputs) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : Tensor = aten::add(%0, %0, %1)
+        %3 : Tensor = aten::relu(%2)
+        %4 : Tensor = aten::sigmoid(%3)
+        return (%4))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto params = conversion::get_named_params(g->inputs(), {});
+  auto info = conversion::ConversionInfo({conversion::InputRange(std::vector<int64_t>{4, 8})});
+  info.mark_activations = true;
+  conversion::ConversionCtx ctx(info.engine_settings);
+  conversion::ConvertBlockToNetDef(&ctx, g->block(), info, params);
+
+  // The output of the block is already bound, leaving the sum and the relu
+  ASSERT_EQ(ctx.marked_activations.size(), 2u);
+  ASSERT_EQ(ctx.net->getNbOutputs(), 3);
+  ASSERT_EQ(ctx.marked_activations[0]->debugName(), "2");
+  ASSERT_EQ(ctx.marked_activations[1]->debugName(), "3");
+}
+
+TEST(PrecisionSearch, NothingIsPromotedWithinThreshold) {
+  torch::jit::Module mod("Searched");
+  mod.define(R"JIT(
+    def forward(self, x):
+        return (x + x).relu()
+  )JIT");
+  mod.eval();
+
+  trtorch::core::CompileSpec cfg({conversion::InputRange(std::vector<int64_t>{4, 8})});
+  cfg.convert_info.engine_settings.op_precision = nvinfer1::DataType::kHALF;
+  std::vector<std::vector<at::Tensor>> batches = {{at::randn({4, 8}, {at::kCUDA})}, {at::randn({4, 8}, {at::kCUDA})}};
+  trtorch::core::precision_search::SearchSettings settings;
+  settings.threshold = 1e-2;
+
+  auto result = trtorch::core::SearchLayerPrecisions(mod, "forward", cfg, batches, settings);
+  ASSERT_TRUE(result.promotions.empty());
+  ASSERT_LE(result.error, settings.threshold);
+  ASSERT_GT(result.latency_ms, 0);
+}
+
+TEST(PrecisionSearch, LayersAreRankedByTheErrorTheyAdd) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %4 : int = prim::Constant[value=1]()
+        %1 : Tensor = aten::relu(%0)
+        %2 : Tensor = aten::mul(%1, %1)
+        %3 : Tensor = aten::sub(%2, %0, %4)
+        %5 : Tensor = aten::flatten(%3, %4, %4)
+        %6 : Tensor = aten::sigmoid(%5)
+        return (%6))IR";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  std::unordered_map<std::string, const torch::jit::Value*> values;
+  for (auto n : g->nodes()) {
+    values[n->output()->debugName()] = n->output();
+  }
+  // %5 is not measured (an alias in the engine) and carries the error of %3
+  std::unordered_map<const torch::jit::Value*, double> measured = {
+      {values["1"], 0.125}, {values["2"], 0.25}, {values["3"], 0.75}, {values["6"], 0.5}};
+  auto ranked = trtorch::core::precision_search::RankLayers(g->block(), measured);
+
+  // The sigmoid is more accurate than the flatten feeding it, so it adds no
+  // error of its own
+  ASSERT_EQ(ranked.size(), 3u);
+  ASSERT_EQ(ranked[0].value->debugName(), "3");
+  ASSERT_EQ(ranked[0].error, 0.5);
+  // Ties keep the order of the graph
+  ASSERT_EQ(ranked[1].value->debugName(), "1");
+  ASSERT_EQ(ranked[1].error, 0.125);
+  ASSERT_EQ(ranked[2].value->debugName(), "2");
+  ASSERT_EQ(ranked[2].error, 0.125);
+}
+
+TEST(PrecisionSearch, PromotionCountIsFoundByDoublingThenBisecting) {
+  std::vector<size_t> evaluated;
+  auto passes_from = [&evaluated](size_t needed) {
+    return [&evaluated, needed](size_t num_promoted) {
+      evaluated.push_back(num_promoted);
+      return num_promoted >= needed;
+    };
+  };
+
+  auto count = trtorch::core::precision_search::FindPromotionCount(20, passes_from(5));
+  ASSERT_TRUE(count);
+  ASSERT_EQ(*count, 5u);
+  ASSERT_EQ(evaluated, std::vector<size_t>({1, 2, 4, 8, 6, 5}));
+
+  evaluated.clear();
+  count = trtorch::core::precision_search::FindPromotionCount(20, passes_from(1));
+  ASSERT_TRUE(count);
+  ASSERT_EQ(*count, 1u);
+  ASSERT_EQ(evaluated, std::vector<size_t>({1}));
+
+  // Doubling stops at the number of ranked layers
+  evaluated.clear();
+  count = trtorch::core::precision_search::FindPromotionCount(6, passes_from(6));
+  ASSERT_TRUE(count);
+  ASSERT_EQ(*count, 6u);
+  ASSERT_EQ(evaluated, std::vector<size_t>({1, 2, 4, 6, 5}));
+}
+
+TEST(PrecisionSearch, PromotionCountIsNotFoundIfPromotingEverythingFails) {
+  std::vector<size_t> evaluated;
+  auto count = trtorch::core::precision_search::FindPromotionCount(5, [&evaluated](size_t num_promoted) {
+    evaluated.push_back(num_promoted);
+    return false;
+  });
+  ASSERT_FALSE(count);
+  ASSERT_EQ(evaluated, std::vector<size_t>({1, 2, 4, 5}));
+
+  ASSERT_FALSE(trtorch::core::precision_search::FindPromotionCount(0, [](size_t) { return true; }));
+}
+
+TEST(PrecisionSearch, CancellingSubtractionIsPromotedWithItsMatmul) {
+  // In FP16 the weight rounds to 2048 and the subtraction cancels to 0 instead
+  // of 0.25 * x, which is exact in FP32. Inputs are small integers so they and
+  // 2048 * x are exact in FP16 as well, leaving the matmul and the subtraction
+  // as the only layers adding error
+  torch::jit::Module mod("Cancelling");
+  mod.register_parameter("w", at::eye(8) * 2048.25, false);
+  mod.define(R"JIT(
+    def forward(self, x):
+        return x.matmul(self.w) - x * 2048.0
+  )JIT");
+  mod.eval();
+  mod.to(at::kCUDA);
+
+  trtorch::core::CompileSpec cfg({conversion::InputRange(std::vector<int64_t>{4, 8})});
+  cfg.convert_info.engine_settings.op_precision = nvinfer1::DataType::kHALF;
+  std::vector<std::vector<at::Tensor>> batches = {
+      {at::randint(-8, 8, {4, 8}, {at::kCUDA}).to(at::kFloat)},
+      {at::randint(-8, 8, {4, 8}, {at::kCUDA}).to(at::kFloat)}};
+  trtorch::core::precision_search::SearchSettings settings;
+  settings.threshold = 1e-2;
+
+  auto result = trtorch::core::SearchLayerPrecisions(mod, "forward", cfg, batches, settings);
+  ASSERT_GT(result.base_error, settings.threshold);
+  ASSERT_LE(result.error, settings.threshold);
+  // Promoting the subtraction alone still cancels its FP16 input, so the
+  // matmul is promoted along with it
+  ASSERT_EQ(result.promotions.size(), 2u);
+  ASSERT_EQ(result.promotions[0].kind, "aten::sub");
+  ASSERT_EQ(result.promotions[1].kind, "aten::matmul");
+  for (auto& r : result.promotions) {
+    ASSERT_EQ(r.precision, nvinfer1::DataType::kFLOAT);
+  }
+
+  // The profile applies the same promotions when compiling
+  std::string path = testing::TempDir() + "cancelling.profile";
+  conversion::WritePrecisionProfile(path, result.promotions);
+  cfg.convert_info.engine_settings.precision_profile = path;
+  auto trt_mod = trtorch::core::CompileGraph(mod, cfg);
+  for (auto& batch : batches) {
+    auto ref = mod.forward({batch[0]}).toTensor();
+    auto out = trt_mod.forward({batch[0].to(at::kHalf)}).toTensor().to(at::kFloat);
+    ASSERT_TRUE(trtorch::tests::util::almostEqual(ref, out, settings.threshold));
+  }
+}
@@ -0,0 +1,73 @@
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include "core/compiler.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+
+namespace {
+// The range check of int64 inputs is opt-in and read once, so it is enabled
+// before any of the tests run
+const bool check_int64_inputs = setenv("TRTORCH_CHECK_INT64_INPUTS", "1", 1) == 0;
+
+torch::jit::Module EmbeddingModule() {
+  torch::jit::Module mod("Embedding");
+  mod.register_parameter("weight", at::randn({16, 4}), false);
+  mod.define(R"JIT(
+    def forward(self, ids):
+        return torch.embedding(self.weight, ids), ids.reshape([8])
+  )JIT");
+  mod.eval();
+  return mod;
+}
+} // namespace
+
+TEST(Runtime, Int64InputsAreNarrowedAndOutputsCastBack) {
+  auto mod = EmbeddingModule();
+  auto ids = at::randint(0, 16, {2, 4}, {at::kCUDA}).to(at::kLong);
+
+  auto jit_mod = mod.clone();
+  jit_mod.to(at::kCUDA);
+  auto jit_results = jit_mod.forward({ids}).toTuple()->elements();
+
+  trtorch::core::CompileSpec cfg({trtorch::core::conversion::InputRange(std::vector<int64_t>{2, 4})});
+  auto trt_mod = trtorch::core::CompileGraph(mod, cfg);
+  auto trt_results = trt_mod.forward({ids}).toTuple()->elements();
+
+  ASSERT_TRUE(trtorch::tests::util::almostEqual(jit_results[0].toTensor(), trt_results[0].toTensor(), 2e-6));
+  auto trt_ids = trt_results[1].toTensor();
+  ASSERT_EQ(trt_ids.scalar_type(), at::kLong);
+  ASSERT_TRUE(trt_ids.equal(jit_results[1].toTensor()));
+}
+
+TEST(Runtime, EnginesCastNarrowedOutputsBackToInt64) {
+  auto mod = EmbeddingModule();
+  auto ids = at::randint(0, 16, {2, 4}, {at::kCUDA}).to(at::kLong);
+
+  auto jit_mod = mod.clone();
+  jit_mod.to(at::kCUDA);
+  auto jit_results = jit_mod.forward({ids}).toTuple()->elements();
+
+  // Engines used without the module CompileGraph wraps them in return int64 as well
+  trtorch::core::CompileSpec cfg({trtorch::core::conversion::InputRange(std::vector<int64_t>{2, 4})});
+  auto engine = trtorch::core::ConvertGraphToTRTEngine(mod, "forward", cfg);
+  auto engine_ptr = c10::make_intrusive<trtorch::core::runtime::TRTEngine>("int64_engine", engine);
+  auto trt_results = trtorch::core::runtime::execute_engine({ids}, engine_ptr);
+
+  ASSERT_EQ(trt_results[0].scalar_type(), at::kFloat);
+  ASSERT_EQ(trt_results[1].scalar_type(), at::kLong);
+  ASSERT_TRUE(trt_results[1].equal(jit_results[1].toTensor()));
+}
+
+TEST(Runtime, Int64InputsWhichDoNotFitInInt32Throw) {
+  ASSERT_TRUE(check_int64_inputs);
+  auto mod = EmbeddingModule();
+  trtorch::core::CompileSpec cfg({trtorch::core::conversion::InputRange(std::vector<int64_t>{2, 4})});
+  auto trt_mod = trtorch::core::CompileGraph(mod, cfg);
+
+  auto ids = at::zeros({2, 4}, {at::kCUDA}).to(at::kLong);
+  ids[0][0] = static_cast<int64_t>(std::numeric_limits<int32_t>::max()) + 1;
+  ASSERT_ANY_THROW(trt_mod.forward({ids}));
+}
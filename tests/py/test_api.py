@@ -43,6 +43,24 @@ class TestCompile(ModelTestCase):
         same = (trt_mod(self.input) - self.scripted_model(self.input)).abs().max()
         self.assertTrue(same < 2e-3)
 
+    def test_compile_traced_layer_precisions(self):
+        # Every layer pinned back to float, only the engine inputs and outputs
+        # are half
+        compile_spec = {
+            "input_shapes": [self.input.shape],
+            "op_precision": torch.half,
+            "layer_precisions": [{
+                "scope": ".*",
+                "precision": torch.float
+            }]
+        }
+
+        trt_mod = trtorch.compile(self.traced_model, compile_spec)
+        half_input = self.input.half()
+        ref = self.traced_model(half_input.float())
+        same = (trt_mod(half_input).float() - ref).abs().max() / ref.abs().max()
+        self.assertTrue(same < 2e-3)
+
 
 class TestCheckMethodOpSupport(unittest.TestCase):
 
@@ -0,0 +1,998 @@
+#include "NvInfer.h"
+#include "core/util/prelude.h"
+#include "tests/util/recording_network.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace trtorch {
+namespace tests {
+namespace util {
+namespace {
+
+// A CPU only stand-in for a TensorRT network definition, which records the
+// layers added to it and infers the shapes of their outputs, so networks can be
+// inspected without a builder (and so without a GPU). Only the layer types used
+// by the conversion context and the converters covered by the layer count
+// tests are recorded, adding any other layer returns nullptr which fails the
+// conversion of the node. Entry points which were added or removed across
+// TensorRT versions are only implemented for the versions which have them.
+
+class RecordingTensor : public nvinfer1::ITensor {
+ public:
+  RecordingTensor(std::string name, nvinfer1::DataType type, std::function<nvinfer1::Dims()> infer_dims)
+      : name_(std::move(name)), type_(type), infer_dims_(std::move(infer_dims)) {}
+
+  void setName(const char* name) override {
+    name_ = name;
+  }
+  const char* getName() const override {
+    return name_.c_str();
+  }
+  void setDimensions(nvinfer1::Dims dimensions) override {
+    dims_ = dimensions;
+    dims_set_ = true;
+  }
+  nvinfer1::Dims getDimensions() const override {
+    return dims_set_ ? dims_ : infer_dims_();
+  }
+  void setType(nvinfer1::DataType type) override {
+    type_ = type;
+  }
+  nvinfer1::DataType getType() const override {
+    return type_;
+  }
+  bool setDynamicRange(float min, float max) override {
+    range_min_ = min;
+    range_max_ = max;
+    range_set_ = true;
+    return true;
+  }
+#if NV_TENSORRT_MAJOR < 8
+  float getDynamicRange() const override {
+    return range_max_;
+  }
+#endif
+  bool isNetworkInput() const override {
+    return is_input;
+  }
+  bool isNetworkOutput() const override {
+    return is_output;
+  }
+  void setBroadcastAcrossBatch(bool broadcastAcrossBatch) override {}
+  bool getBroadcastAcrossBatch() const override {
+    return false;
+  }
+  nvinfer1::TensorLocation getLocation() const override {
+    return nvinfer1::TensorLocation::kDEVICE;
+  }
+  void setLocation(nvinfer1::TensorLocation location) override {}
+  bool dynamicRangeIsSet() const override {
+    return range_set_;
+  }
+  void resetDynamicRange() override {
+    range_set_ = false;
+  }
+  float getDynamicRangeMin() const override {
+    return range_min_;
+  }
+  float getDynamicRangeMax() const override {
+    return range_max_;
+  }
+  void setAllowedFormats(nvinfer1::TensorFormats formats) override {}
+  nvinfer1::TensorFormats getAllowedFormats() const override {
+    return 1U << static_cast<uint32_t>(nvinfer1::TensorFormat::kLINEAR);
+  }
+  bool isShapeTensor() const override {
+    return false;
+  }
+  bool isExecutionTensor() const override {
+    return true;
+  }
+
+  bool is_input = false;
+  bool is_output = false;
+
+ private:
+  std::string name_;
+  nvinfer1::DataType type_;
+  std::function<nvinfer1::Dims()> infer_dims_;
+  nvinfer1::Dims dims_;
+  bool dims_set_ = false;
+  float range_min_ = 0;
+  float range_max_ = 0;
+  bool range_set_ = false;
+};
+
+// Implements the ILayer part of a recorded layer, Layer is the TensorRT layer
+// interface (ex. nvinfer1::IShuffleLayer). Every recorded layer has a single
+// output, whose dimensions are inferred by the concrete layer
+template <typename Layer>
+class RecordedLayer : public Layer {
+ public:
+  RecordedLayer(nvinfer1::LayerType type, std::vector<nvinfer1::ITensor*> inputs)
+      : type_(type), inputs_(std::move(inputs)) {
+    output_ = std::make_unique<RecordingTensor>(
+        "", inputs_.size() > 0 ? inputs_[0]->getType() : nvinfer1::DataType::kFLOAT, [this]() {
+          return recordedOutputDims();
+        });
+  }
+  virtual ~RecordedLayer() = default;
+
+  nvinfer1::LayerType getType() const override {
+    return type_;
+  }
+  void setName(const char* name) override {
+    name_ = name;
+  }
+  const char* getName() const override {
+    return name_.c_str();
+  }
+  int getNbInputs() const override {
+    return static_cast<int>(inputs_.size());
+  }
+  nvinfer1::ITensor* getInput(int index) const override {
+    return index < getNbInputs() ? inputs_[index] : nullptr;
+  }
+  int getNbOutputs() const override {
+    return 1;
+  }
+  nvinfer1::ITensor* getOutput(int index) const override {
+    return index == 0 ? output_.get() : nullptr;
+  }
+  void setInput(int index, nvinfer1::ITensor& tensor) override {
+    if (index >= getNbInputs()) {
+      inputs_.resize(index + 1, nullptr);
+    }
+    inputs_[index] = &tensor;
+  }
+  void setPrecision(nvinfer1::DataType dataType) override {
+    precision_ = dataType;
+    precision_set_ = true;
+  }
+  nvinfer1::DataType getPrecision() const override {
+    return precision_;
+  }
+  bool precisionIsSet() const override {
+    return precision_set_;
+  }
+  void resetPrecision() override {
+    precision_set_ = false;
+  }
+  void setOutputType(int index, nvinfer1::DataType dataType) override {
+    output_type_ = dataType;
+    output_type_set_ = true;
+  }
+  nvinfer1::DataType getOutputType(int index) const override {
+    return output_type_;
+  }
+  bool outputTypeIsSet(int index) const override {
+    return output_type_set_;
+  }
+  void resetOutputType(int index) override {
+    output_type_set_ = false;
+  }
+
+ protected:
+  virtual nvinfer1::Dims recordedOutputDims() const = 0;
+
+  nvinfer1::Dims inputDims(int index) const {
+    return inputs_[index]->getDimensions();
+  }
+
+  std::unique_ptr<RecordingTensor> output_;
+
+ private:
+  nvinfer1::LayerType type_;
+  std::vector<nvinfer1::ITensor*> inputs_;
+  std::string name_;
+  nvinfer1::DataType precision_ = nvinfer1::DataType::kFLOAT;
+  bool precision_set_ = false;
+  nvinfer1::DataType output_type_ = nvinfer1::DataType::kFLOAT;
+  bool output_type_set_ = false;
+};
+
+class RecordedActivation : public RecordedLayer<nvinfer1::IActivationLayer> {
+ public:
+  RecordedActivation(nvinfer1::ITensor& input, nvinfer1::ActivationType type)
+      : RecordedLayer(nvinfer1::LayerType::kACTIVATION, {&input}), type_(type) {}
+
+  void setActivationType(nvinfer1::ActivationType type) override {
+    type_ = type;
+  }
+  nvinfer1::ActivationType getActivationType() const override {
+    return type_;
+  }
+  void setAlpha(float alpha) override {
+    alpha_ = alpha;
+  }
+  void setBeta(float beta) override {
+    beta_ = beta;
+  }
+  float getAlpha() const override {
+    return alpha_;
+  }
+  float getBeta() const override {
+    return beta_;
+  }
+
+ protected:
+  nvinfer1::Dims recordedOutputDims() const override {
+    return inputDims(0);
+  }
+
+ private:
+  nvinfer1::ActivationType type_;
+  float alpha_ = 0;
+  float beta_ = 0;
+};
+
+class RecordedScale : public RecordedLayer<nvinfer1::IScaleLayer> {
+ public:
+  RecordedScale(
+      nvinfer1::ITensor& input,
+      nvinfer1::ScaleMode mode,
+      nvinfer1::Weights shift,
+      nvinfer1::Weights scale,
+      nvinfer1::Weights power,
+      int channel_axis)
+      : RecordedLayer(nvinfer1::LayerType::kSCALE, {&input}),
+        mode_(mode),
+        shift_(shift),
+        scale_(scale),
+        power_(power),
+        channel_axis_(channel_axis) {}
+
+  void setMode(nvinfer1::ScaleMode mode) override {
+    mode_ = mode;
+  }
+  nvinfer1::ScaleMode getMode() const override {
+    return mode_;
+  }
+  void setShift(nvinfer1::Weights shift) override {
+    shift_ = shift;
+  }
+  nvinfer1::Weights getShift() const override {
+    return shift_;
+  }
+  void setScale(nvinfer1::Weights scale) override {
+    scale_ = scale;
+  }
+  nvinfer1::Weights getScale() const override {
+    return scale_;
+  }
+  void setPower(nvinfer1::Weights power) override {
+    power_ = power;
+  }
+  nvinfer1::Weights getPower() const override {
+    return power_;
+  }
+  int getChannelAxis() const override {
+    return channel_axis_;
+  }
+  void setChannelAxis(int channelAxis) override {
+    channel_axis_ = channelAxis;
+  }
+
+ protected:
+  nvinfer1::Dims recordedOutputDims() const override {
+    return inputDims(0);
+  }
+
+ private:
+  nvinfer1::ScaleMode mode_;
+  nvinfer1::Weights shift_;
+  nvinfer1::Weights scale_;
+  nvinfer1::Weights power_;
+  int channel_axis_;
+};
+
+class RecordedConvolution : public RecordedLayer<nvinfer1::IConvolutionLayer> {
+ public:
+  RecordedConvolution(
+      nvinfer1::ITensor& input,
+      int nb_output_maps,
+      nvinfer1::Dims kernel_size,
+      nvinfer1::Weights kernel,
+      nvinfer1::Weights bias)
+      : RecordedLayer(nvinfer1::LayerType::kCONVOLUTION, {&input}),
+        nb_output_maps_(nb_output_maps),
+        kernel_size_(kernel_size),
+        kernel_(kernel),
+        bias_(bias) {
+    stride_ = ones(kernel_size.nbDims);
+    dilation_ = ones(kernel_size.nbDims);
+    pre_padding_ = zeros(kernel_size.nbDims);
+    post_padding_ = zeros(kernel_size.nbDims);
+  }
+
+  void setKernelSize(nvinfer1::DimsHW kernelSize) override {
+    kernel_size_ = kernelSize;
+  }
+  nvinfer1::DimsHW getKernelSize() const override {
+    return nvinfer1::DimsHW(kernel_size_.d[0], kernel_size_.d[1]);
+  }
+  void setNbOutputMaps(int nbOutputMaps) override {
+    nb_output_maps_ = nbOutputMaps;
+  }
+  int getNbOutputMaps() const override {
+    return nb_output_maps_;
+  }
+  void setStride(nvinfer1::DimsHW stride) override {
+    stride_ = stride;
+  }
+  nvinfer1::DimsHW getStride() const override {
+    return nvinfer1::DimsHW(stride_.d[0], stride_.d[1]);
+  }
+  void setPadding(nvinfer1::DimsHW padding) override {
+    pre_padding_ = padding;
+    post_padding_ = padding;
+  }
+  nvinfer1::DimsHW getPadding() const override {
+    return nvinfer1::DimsHW(pre_padding_.d[0], pre_padding_.d[1]);
+  }
+  void setNbGroups(int nbGroups) override {
+    nb_groups_ = nbGroups;
+  }
+  int getNbGroups() const override {
+    return nb_groups_;
+  }
+  void setKernelWeights(nvinfer1::Weights weights) override {
+    kernel_ = weights;
+  }
+  nvinfer1::Weights getKernelWeights() const override {
+    return kernel_;
+  }
+  void setBiasWeights(nvinfer1::Weights weights) override {
+    bias_ = weights;
+  }
+  nvinfer1::Weights getBiasWeights() const override {
+    return bias_;
+  }
+  void setDilation(nvinfer1::DimsHW dilation) override {
+    dilation_ = dilation;
+  }
+  nvinfer1::DimsHW getDilation() const override {
+    return nvinfer1::DimsHW(dilation_.d[0], dilation_.d[1]);
+  }
+  void setPrePadding(nvinfer1::Dims padding) override {
+    pre_padding_ = padding;
+  }
+  nvinfer1::Dims getPrePadding() const override {
+    return pre_padding_;
+  }
+  void setPostPadding(nvinfer1::Dims padding) override {
+    post_padding_ = padding;
+  }
+  nvinfer1::Dims getPostPadding() const override {
+    return post_padding_;
+  }
+  void setPaddingMode(nvinfer1::PaddingMode paddingMode) override {
+    padding_mode_ = paddingMode;
+  }
+  nvinfer1::PaddingMode getPaddingMode() const override {
+    return padding_mode_;
+  }
+  void setKernelSizeNd(nvinfer1::Dims kernelSize) override {
+    kernel_size_ = kernelSize;
+  }
+  nvinfer1::Dims getKernelSizeNd() const override {
+    return kernel_size_;
+  }
+  void setStrideNd(nvinfer1::Dims stride) override {
+    stride_ = stride;
+  }
+  nvinfer1::Dims getStrideNd() const override {
+    return stride_;
+  }
+  void setPaddingNd(nvinfer1::Dims padding) override {
+    pre_padding_ = padding;
+    post_padding_ = padding;
+  }
+  nvinfer1::Dims getPaddingNd() const override {
+    return pre_padding_;
+  }
+  void setDilationNd(nvinfer1::Dims dilation) override {
+    dilation_ = dilation;
+  }
+  nvinfer1::Dims getDilationNd() const override {
+    return dilation_;
+  }
+
+ protected:
+  nvinfer1::Dims recordedOutputDims() const override {
+    // Explicit padding, rounding down as for kCAFFE_ROUND_DOWN which is what
+    // the converters use
+    auto in = inputDims(0);
+    auto out = in;
+    auto spatial_start = in.nbDims - kernel_size_.nbDims;
+    out.d[spatial_start - 1] = nb_output_maps_;
+    for (int i = 0; i < kernel_size_.nbDims; i++) {
+      auto size = in.d[spatial_start + i];
+      if (size < 0) {
+        continue;
+      }
+      auto extent = dilation_.d[i] * (kernel_size_.d[i] - 1) + 1;
+      out.d[spatial_start + i] = (size + pre_padding_.d[i] + post_padding_.d[i] - extent) / stride_.d[i] + 1;
+    }
+    return out;
+  }
+
+ private:
+  static nvinfer1::Dims filled(int nb_dims, int value) {
+    nvinfer1::Dims d;
+    d.nbDims = nb_dims;
+    for (int i = 0; i < nb_dims; i++) {
+      d.d[i] = value;
+    }
+    return d;
+  }
+  static nvinfer1::Dims ones(int nb_dims) {
+    return filled(nb_dims, 1);
+  }
+  static nvinfer1::Dims zeros(int nb_dims) {
+    return filled(nb_dims, 0);
+  }
+
+  int nb_output_maps_;
+  nvinfer1::Dims kernel_size_;
+  nvinfer1::Weights kernel_;
+  nvinfer1::Weights bias_;
+  nvinfer1::Dims stride_;
+  nvinfer1::Dims dilation_;
+  nvinfer1::Dims pre_padding_;
+  nvinfer1::Dims post_padding_;
+  nvinfer1::PaddingMode padding_mode_ = nvinfer1::PaddingMode::kEXPLICIT_ROUND_DOWN;
+  int nb_groups_ = 1;
+};
+
+class RecordedFullyConnected : public RecordedLayer<nvinfer1::IFullyConnectedLayer> {
+ public:
+  RecordedFullyConnected(nvinfer1::ITensor& input, int nb_outputs, nvinfer1::Weights kernel, nvinfer1::Weights bias)
+      : RecordedLayer(nvinfer1::LayerType::kFULLY_CONNECTED, {&input}),
+        nb_outputs_(nb_outputs),
+        kernel_(kernel),
+        bias_(bias) {}
+
+  void setNbOutputChannels(int nbOutputs) override {
+    nb_outputs_ = nbOutputs;
+  }
+  int getNbOutputChannels() const override {
+    return nb_outputs_;
+  }
+  void setKernelWeights(nvinfer1::Weights weights) override {
+    kernel_ = weights;
+  }
+  nvinfer1::Weights getKernelWeights() const override {
+    return kernel_;
+  }
+  void setBiasWeights(nvinfer1::Weights weights) override {
+    bias_ = weights;
+  }
+  nvinfer1::Weights getBiasWeights() const override {
+    return bias_;
+  }
+
+ protected:
+  nvinfer1::Dims recordedOutputDims() const override {
+    // The last three dimensions (C, H, W) are reduced to (K, 1, 1)
+    auto out = inputDims(0);
+    out.d[out.nbDims - 3] = nb_outputs_;
+    out.d[out.nbDims - 2] = 1;
+    out.d[out.nbDims - 1] = 1;
+    return out;
+  }
+
+ private:
+  int nb_outputs_;
+  nvinfer1::Weights kernel_;
+  nvinfer1::Weights bias_;
+};
+
+class RecordedElementWise : public RecordedLayer<nvinfer1::IElementWiseLayer> {
+ public:
+  RecordedElementWise(nvinfer1::ITensor& input1, nvinfer1::ITensor& input2, nvinfer1::ElementWiseOperation op)
+      : RecordedLayer(nvinfer1::LayerType::kELEMENTWISE, {&input1, &input2}), op_(op) {}
+
+  void setOperation(nvinfer1::ElementWiseOperation op) override {
+    op_ = op;
+  }
+  nvinfer1::ElementWiseOperation getOperation() const override {
+    return op_;
+  }
+
+ protected:
+  nvinfer1::Dims recordedOutputDims() const override {
+    // Both inputs have the same rank, dimensions of size 1 are broadcast
+    auto a = inputDims(0);
+    auto b = inputDims(1);
+    auto out = a;
+    for (int i = 0; i < out.nbDims && i < b.nbDims; i++) {
+      if (a.d[i] < 0 || b.d[i] < 0) {
+        out.d[i] = a.d[i] == 1 ? b.d[i] : (b.d[i] == 1 ? a.d[i] : -1);
+      } else {
+        out.d[i] = std::max(a.d[i], b.d[i]);
+      }
+    }
+    return out;
+  }
+
+ private:
+  nvinfer1::ElementWiseOperation op_;
+};
+
+class RecordedShuffle : public RecordedLayer<nvinfer1::IShuffleLayer> {
+ public:
+  RecordedShuffle(nvinfer1::ITensor& input) : RecordedLayer(nvinfer1::LayerType::kSHUFFLE, {&input}) {
+    for (int i = 0; i < nvinfer1::Dims::MAX_DIMS; i++) {
+      first_.order[i] = i;
+      second_.order[i] = i;
+    }
+  }
+
+  void setFirstTranspose(nvinfer1::Permutation permutation) override {
+    first_ = permutation;
+  }
+  nvinfer1::Permutation getFirstTranspose() const override {
+    return first_;
+  }
+  void setReshapeDimensions(nvinfer1::Dims dimensions) override {
+    reshape_ = dimensions;
+    reshape_set_ = true;
+  }
+  nvinfer1::Dims getReshapeDimensions() const override {
+    return reshape_;
+  }
+  void setSecondTranspose(nvinfer1::Permutation permutation) override {
+    second_ = permutation;
+  }
+  nvinfer1::Permutation getSecondTranspose() const override {
+    return second_;
+  }
+#if NV_TENSORRT_MAJOR >= 8
+  void setZeroIsPlaceholder(bool zeroIsPlaceholder) override {
+    zero_is_placeholder_ = zeroIsPlaceholder;
+  }
+  bool getZeroIsPlaceholder() const override {
+    return zero_is_placeholder_;
+  }
+#endif
+
+ protected:
+  nvinfer1::Dims recordedOutputDims() const override {
+    auto transposed = permute(inputDims(0), first_);
+    if (!reshape_set_) {
+      return permute(transposed, second_);
+    }
+
+    auto reshaped = reshape_;
+    int64_t known_volume = 1;
+    int infer_index = -1;
+    for (int i = 0; i < reshaped.nbDims; i++) {
+      if (reshaped.d[i] == 0 && zero_is_placeholder_) {
+        reshaped.d[i] = transposed.d[i];
+      }
+      if (reshaped.d[i] == -1) {
+        infer_index = i;
+      } else {
+        known_volume *= reshaped.d[i];
+      }
+    }
+    if (infer_index >= 0) {
+      int64_t volume = 1;
+      for (int i = 0; i < transposed.nbDims; i++) {
+        volume *= transposed.d[i];
+      }
+      reshaped.d[infer_index] = (volume < 0 || known_volume <= 0) ? -1 : static_cast<int>(volume / known_volume);
+    }
+    return permute(reshaped, second_);
+  }
+
+ private:
+  static nvinfer1::Dims permute(nvinfer1::Dims dims, nvinfer1::Permutation permutation) {
+    auto out = dims;
+    for (int i = 0; i < dims.nbDims; i++) {
+      out.d[i] = dims.d[permutation.order[i]];
+    }
+    return out;
+  }
+
+  nvinfer1::Permutation first_;
+  nvinfer1::Permutation second_;
+  nvinfer1::Dims reshape_;
+  bool reshape_set_ = false;
+  bool zero_is_placeholder_ = true;
+};
+
+class RecordedConstant : public RecordedLayer<nvinfer1::IConstantLayer> {
+ public:
+  RecordedConstant(nvinfer1::Dims dimensions, nvinfer1::Weights weights)
+      : RecordedLayer(nvinfer1::LayerType::kCONSTANT, {}), dims_(dimensions), weights_(weights) {
+    output_->setType(weights.type);
+  }
+
+  void setWeights(nvinfer1::Weights weights) override {
+    weights_ = weights;
+  }
+  nvinfer1::Weights getWeights() const override {
+    return weights_;
+  }
+  void setDimensions(nvinfer1::Dims dimensions) override {
+    dims_ = dimensions;
+  }
+  nvinfer1::Dims getDimensions() const override {
+    return dims_;
+  }
+
+ protected:
+  nvinfer1::Dims recordedOutputDims() const override {
+    return dims_;
+  }
+
+ private:
+  nvinfer1::Dims dims_;
+  nvinfer1::Weights weights_;
+};
+
+class RecordingNetwork : public nvinfer1::INetworkDefinition {
+ public:
+  nvinfer1::ITensor* addInput(const char* name, nvinfer1::DataType type, nvinfer1::Dims dimensions) override {
+    auto in = std::make_unique<RecordingTensor>(name, type, nullptr);
+    in->setDimensions(dimensions);
+    in->is_input = true;
+    inputs_.push_back(in.get());
+    tensors_.push_back(std::move(in));
+    return inputs_.back();
+  }
+  void markOutput(nvinfer1::ITensor& tensor) override {
+    static_cast<RecordingTensor&>(tensor).is_output = true;
+    outputs_.push_back(&tensor);
+  }
+  void unmarkOutput(nvinfer1::ITensor& tensor) override {
+    static_cast<RecordingTensor&>(tensor).is_output = false;
+    outputs_.erase(std::remove(outputs_.begin(), outputs_.end(), &tensor), outputs_.end());
+  }
+
+  nvinfer1::IActivationLayer* addActivation(nvinfer1::ITensor& input, nvinfer1::ActivationType type) override {
+    return record(std::make_shared<RecordedActivation>(input, type));
+  }
+  nvinfer1::IScaleLayer* addScale(
+      nvinfer1::ITensor& input,
+      nvinfer1::ScaleMode mode,
+      nvinfer1::Weights shift,
+      nvinfer1::Weights scale,
+      nvinfer1::Weights power) override {
+    return record(std::make_shared<RecordedScale>(input, mode, shift, scale, power, 0));
+  }
+  nvinfer1::IScaleLayer* addScaleNd(
+      nvinfer1::ITensor& input,
+      nvinfer1::ScaleMode mode,
+      nvinfer1::Weights shift,
+      nvinfer1::Weights scale,
+      nvinfer1::Weights power,
+      int channelAxis) override {
+    return record(std::make_shared<RecordedScale>(input, mode, shift, scale, power, channelAxis));
+  }
+  nvinfer1::IConvolutionLayer* addConvolution(
+      nvinfer1::ITensor& input,
+      int nbOutputMaps,
+      nvinfer1::DimsHW kernelSize,
+      nvinfer1::Weights kernelWeights,
+      nvinfer1::Weights biasWeights) override {
+    return record(std::make_shared<RecordedConvolution>(input, nbOutputMaps, kernelSize, kernelWeights, biasWeights));
+  }
+  nvinfer1::IConvolutionLayer* addConvolutionNd(
+      nvinfer1::ITensor& input,
+      int nbOutputMaps,
+      nvinfer1::Dims kernelSize,
+      nvinfer1::Weights kernelWeights,
+      nvinfer1::Weights biasWeights) override {
+    return record(std::make_shared<RecordedConvolution>(input, nbOutputMaps, kernelSize, kernelWeights, biasWeights));
+  }
+  nvinfer1::IFullyConnectedLayer* addFullyConnected(
+      nvinfer1::ITensor& input,
+      int nbOutputs,
+      nvinfer1::Weights kernelWeights,
+      nvinfer1::Weights biasWeights) override {
+    return record(std::make_shared<RecordedFullyConnected>(input, nbOutputs, kernelWeights, biasWeights));
+  }
+  nvinfer1::IElementWiseLayer* addElementWise(
+      nvinfer1::ITensor& input1,
+      nvinfer1::ITensor& input2,
+      nvinfer1::ElementWiseOperation op) override {
+    return record(std::make_shared<RecordedElementWise>(input1, input2, op));
+  }
+  nvinfer1::IShuffleLayer* addShuffle(nvinfer1::ITensor& input) override {
+    return record(std::make_shared<RecordedShuffle>(input));
+  }
+  nvinfer1::IConstantLayer* addConstant(nvinfer1::Dims dimensions, nvinfer1::Weights weights) override {
+    return record(std::make_shared<RecordedConstant>(dimensions, weights));
+  }
+
+  // Layers which are not recorded
+  nvinfer1::IPoolingLayer* addPooling(
+      nvinfer1::ITensor& input,
+      nvinfer1::PoolingType type,
+      nvinfer1::DimsHW windowSize) override {
+    return unsupported<nvinfer1::IPoolingLayer>("pooling");
+  }
+  nvinfer1::IPoolingLayer* addPoolingNd(
+      nvinfer1::ITensor& input,
+      nvinfer1::PoolingType type,
+      nvinfer1::Dims windowSize) override {
+    return unsupported<nvinfer1::IPoolingLayer>("pooling");
+  }
+  nvinfer1::ILRNLayer* addLRN(nvinfer1::ITensor& input, int window, float alpha, float beta, float k) override {
+    return unsupported<nvinfer1::ILRNLayer>("LRN");
+  }
+  nvinfer1::ISoftMaxLayer* addSoftMax(nvinfer1::ITensor& input) override {
+    return unsupported<nvinfer1::ISoftMaxLayer>("softmax");
+  }
+  nvinfer1::IConcatenationLayer* addConcatenation(nvinfer1::ITensor* const* inputs, int nbInputs) override {
+    return unsupported<nvinfer1::IConcatenationLayer>("concatenation");
+  }
+  nvinfer1::IDeconvolutionLayer* addDeconvolution(
+      nvinfer1::ITensor& input,
+      int nbOutputMaps,
+      nvinfer1::DimsHW kernelSize,
+      nvinfer1::Weights kernelWeights,
+      nvinfer1::Weights biasWeights) override {
+    return unsupported<nvinfer1::IDeconvolutionLayer>("deconvolution");
+  }
+  nvinfer1::IDeconvolutionLayer* addDeconvolutionNd(
+      nvinfer1::ITensor& input,
+      int nbOutputMaps,
+      nvinfer1::Dims kernelSize,
+      nvinfer1::Weights kernelWeights,
+      nvinfer1::Weights biasWeights) override {
+    return unsupported<nvinfer1::IDeconvolutionLayer>("deconvolution");
+  }
+#if NV_TENSORRT_MAJOR < 8
+  nvinfer1::IRNNLayer* addRNN(
+      nvinfer1::ITensor& inputs,
+      int layerCount,
+      std::size_t hiddenSize,
+      int maxSeqLen,
+      nvinfer1::RNNOperation op,
+      nvinfer1::RNNInputMode mode,
+      nvinfer1::RNNDirection dir,
+      nvinfer1::Weights weights,
+      nvinfer1::Weights bias) override {
+    return unsupported<nvinfer1::IRNNLayer>("RNN");
+  }
+#endif
+  nvinfer1::IRNNv2Layer* addRNNv2(
+      nvinfer1::ITensor& input,
+      int32_t layerCount,
+      int32_t hiddenSize,
+      int32_t maxSeqLen,
+      nvinfer1::RNNOperation op) override {
+    return unsupported<nvinfer1::IRNNv2Layer>("RNN");
+  }
+#if NV_TENSORRT_MAJOR < 8
+  nvinfer1::IPluginLayer* addPlugin(
+      nvinfer1::ITensor* const* inputs,
+      int nbInputs,
+      nvinfer1::IPlugin& plugin) override {
+    return unsupported<nvinfer1::IPluginLayer>("plugin");
+  }
+  nvinfer1::IPluginLayer* addPluginExt(
+      nvinfer1::ITensor* const* inputs,
+      int nbInputs,
+      nvinfer1::IPluginExt& plugin) override {
+    return unsupported<nvinfer1::IPluginLayer>("plugin");
+  }
+#endif
+  nvinfer1::IPluginV2Layer* addPluginV2(
+      nvinfer1::ITensor* const* inputs,
+      int nbInputs,
+      nvinfer1::IPluginV2& plugin) override {
+    return unsupported<nvinfer1::IPluginV2Layer>("plugin");
+  }
+  nvinfer1::IUnaryLayer* addUnary(nvinfer1::ITensor& input, nvinfer1::UnaryOperation operation) override {
+    return unsupported<nvinfer1::IUnaryLayer>("unary");
+  }
+  nvinfer1::IPaddingLayer* addPadding(
+      nvinfer1::ITensor& input,
+      nvinfer1::DimsHW prePadding,
+      nvinfer1::DimsHW postPadding) override {
+    return unsupported<nvinfer1::IPaddingLayer>("padding");
+  }
+#if NV_TENSORRT_MAJOR >= 8
+  nvinfer1::IPaddingLayer* addPaddingNd(
+      nvinfer1::ITensor& input,
+      nvinfer1::Dims prePadding,
+      nvinfer1::Dims postPadding) override {
+    return unsupported<nvinfer1::IPaddingLayer>("padding");
+  }
+#endif
+  nvinfer1::IReduceLayer* addReduce(
+      nvinfer1::ITensor& input,
+      nvinfer1::ReduceOperation operation,
+      uint32_t reduceAxes,
+      bool keepDimensions) override {
+    return unsupported<nvinfer1::IReduceLayer>("reduce");
+  }
+  nvinfer1::ITopKLayer* addTopK(
+      nvinfer1::ITensor& input,
+      nvinfer1::TopKOperation op,
+      int k,
+      uint32_t reduceAxes) override {
+    return unsupported<nvinfer1::ITopKLayer>("top k");
+  }
+  nvinfer1::IGatherLayer* addGather(nvinfer1::ITensor& data, nvinfer1::ITensor& indices, int axis) override {
+    return unsupported<nvinfer1::IGatherLayer>("gather");
+  }
+  nvinfer1::IRaggedSoftMaxLayer* addRaggedSoftMax(nvinfer1::ITensor& input, nvinfer1::ITensor& bounds) override {
+    return unsupported<nvinfer1::IRaggedSoftMaxLayer>("ragged softmax");
+  }
+  nvinfer1::IMatrixMultiplyLayer* addMatrixMultiply(
+      nvinfer1::ITensor& input0,
+      nvinfer1::MatrixOperation op0,
+      nvinfer1::ITensor& input1,
+      nvinfer1::MatrixOperation op1) override {
+    return unsupported<nvinfer1::IMatrixMultiplyLayer>("matrix multiply");
+  }
+#if NV_TENSORRT_MAJOR < 8
+  nvinfer1::IMatrixMultiplyLayer* addMatrixMultiply(
+      nvinfer1::ITensor& input0,
+      bool transpose0,
+      nvinfer1::ITensor& input1,
+      bool transpose1) override {
+    return unsupported<nvinfer1::IMatrixMultiplyLayer>("matrix multiply");
+  }
+#endif
+  nvinfer1::IIdentityLayer* addIdentity(nvinfer1::ITensor& input) override {
+    return unsupported<nvinfer1::IIdentityLayer>("identity");
+  }
+  nvinfer1::ISliceLayer* addSlice(
+      nvinfer1::ITensor& input,
+      nvinfer1::Dims start,
+      nvinfer1::Dims size,
+      nvinfer1::Dims stride) override {
+    return unsupported<nvinfer1::ISliceLayer>("slice");
+  }
+  nvinfer1::IShapeLayer* addShape(nvinfer1::ITensor& input) override {
+    return unsupported<nvinfer1::IShapeLayer>("shape");
+  }
+  nvinfer1::IParametricReLULayer* addParametricReLU(nvinfer1::ITensor& input, nvinfer1::ITensor& slope) override {
+    return unsupported<nvinfer1::IParametricReLULayer>("parametric ReLU");
+  }
+  nvinfer1::IResizeLayer* addResize(nvinfer1::ITensor& input) override {
+    return unsupported<nvinfer1::IResizeLayer>("resize");
+  }
+#if NV_TENSORRT_MAJOR >= 7
+  nvinfer1::ILoop* addLoop() override {
+    return unsupported<nvinfer1::ILoop>("loop");
+  }
+  nvinfer1::ISelectLayer* addSelect(
+      nvinfer1::ITensor& condition,
+      nvinfer1::ITensor& thenInput,
+      nvinfer1::ITensor& elseInput) override {
+    return unsupported<nvinfer1::ISelectLayer>("select");
+  }
+  nvinfer1::IFillLayer* addFill(nvinfer1::Dims dimensions, nvinfer1::FillOperation op) override {
+    return unsupported<nvinfer1::IFillLayer>("fill");
+  }
+#endif
+
+#if NV_TENSORRT_MAJOR < 8
+  void setPoolingOutputDimensionsFormula(nvinfer1::IOutputDimensionsFormula* formula) override {}
+  nvinfer1::IOutputDimensionsFormula& getPoolingOutputDimensionsFormula() const override {
+    return *formula_;
+  }
+  void setConvolutionOutputDimensionsFormula(nvinfer1::IOutputDimensionsFormula* formula) override {}
+  nvinfer1::IOutputDimensionsFormula& getConvolutionOutputDimensionsFormula() const override {
+    return *formula_;
+  }
+  void setDeconvolutionOutputDimensionsFormula(nvinfer1::IOutputDimensionsFormula* formula) override {}
+  nvinfer1::IOutputDimensionsFormula& getDeconvolutionOutputDimensionsFormula() const override {
+    return *formula_;
+  }
+#endif
+
+  int getNbLayers() const override {
+    return static_cast<int>(layers_.size());
+  }
+  nvinfer1::ILayer* getLayer(int index) const override {
+    return index < getNbLayers() ? layers_[index] : nullptr;
+  }
+  int getNbInputs() const override {
+    return static_cast<int>(inputs_.size());
+  }
+  nvinfer1::ITensor* getInput(int index) const override {
+    return index < getNbInputs() ? inputs_[index] : nullptr;
+  }
+  int getNbOutputs() const override {
+    return static_cast<int>(outputs_.size());
+  }
+  nvinfer1::ITensor* getOutput(int index) const override {
+    return index < getNbOutputs() ? outputs_[index] : nullptr;
+  }
+  void removeTensor(nvinfer1::ITensor& tensor) override {}
+  bool markOutputForShapes(nvinfer1::ITensor& tensor) override {
+    return false;
+  }
+  bool unmarkOutputForShapes(nvinfer1::ITensor& tensor) override {
+    return false;
+  }
+  bool hasImplicitBatchDimension() const override {
+    return false;
+  }
+  bool hasExplicitPrecision() const override {
+    return false;
+  }
+  void setErrorRecorder(nvinfer1::IErrorRecorder* recorder) override {
+    recorder_ = recorder;
+  }
+  nvinfer1::IErrorRecorder* getErrorRecorder() const override {
+    return recorder_;
+  }
+  void setName(const char* name) override {
+    name_ = name;
+  }
+  const char* getName() const override {
+    return name_.c_str();
+  }
+#if NV_TENSORRT_MAJOR >= 8
+  bool setWeightsName(nvinfer1::Weights weights, const char* name) override {
+    return false;
+  }
+#endif
+
+  void destroy() override {
+    delete this;
+  }
+
+  const std::vector<std::string>& unsupportedLayers() const {
+    return unsupported_layers_;
+  }
+
+ private:
+  template <typename Recorded>
+  Recorded* record(std::shared_ptr<Recorded> layer) {
+    layers_.push_back(layer.get());
+    owned_layers_.push_back(layer);
+    return layer.get();
+  }
+
+  template <typename Layer>
+  Layer* unsupported(const char* kind) {
+    LOG_ERROR("The recording network does not record " << kind << " layers");
+    unsupported_layers_.push_back(kind);
+    return nullptr;
+  }
+
+  std::vector<std::unique_ptr<RecordingTensor>> tensors_;
+  std::vector<nvinfer1::ITensor*> inputs_;
+  std::vector<nvinfer1::ITensor*> outputs_;
+  std::vector<nvinfer1::ILayer*> layers_;
+  // Owns the recorded layers, the destructors of the TensorRT interfaces are
+  // protected so they are held with their concrete type erased
+  std::vector<std::shared_ptr<void>> owned_layers_;
+  std::vector<std::string> unsupported_layers_;
+  nvinfer1::IErrorRecorder* recorder_ = nullptr;
+#if NV_TENSORRT_MAJOR < 8
+  nvinfer1::IOutputDimensionsFormula* formula_ = nullptr;
+#endif
+  std::string name_;
+};
+
+} // namespace
+
+nvinfer1::INetworkDefinition* CreateRecordingNetwork() {
+  return new RecordingNetwork();
+}
+
+std::vector<std::string> UnsupportedLayers(const nvinfer1::INetworkDefinition* net) {
+  auto recording = dynamic_cast<const RecordingNetwork*>(net);
+  TRTORCH_CHECK(recording, "Network " << net->getName() << " was not created by CreateRecordingNetwork");
+  return recording->unsupportedLayers();
+}
+
+} // namespace util
+} // namespace tests
+} // namespace trtorch
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "NvInfer.h"
+
+namespace trtorch {
+namespace tests {
+namespace util {
+
+// Creates a CPU only stand-in for a TensorRT network definition which records
+// the layers added to it, only the layer types used by the converters covered
+// by the layer count tests are supported
+nvinfer1::INetworkDefinition* CreateRecordingNetwork();
+
+// Kinds of layers (ex. "loop") which were added to a network created by
+// CreateRecordingNetwork but are not recorded by it, in the order they were
+// added
+std::vector<std::string> UnsupportedLayers(const nvinfer1::INetworkDefinition* net);
+
+} // namespace util
+} // namespace tests
+} // namespace trtorch
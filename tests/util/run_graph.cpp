@@ -9,6 +9,19 @@ torch::jit::Stack CreateStack(std::vector<torch::jit::IValue>&& list) {
   return torch::jit::Stack(std::make_move_iterator(list.begin()), std::make_move_iterator(list.end()));
 }
 
+void FreezeGraphInputs(std::shared_ptr<torch::jit::Graph>& g, std::vector<at::Tensor> params) {
+  TRTORCH_CHECK(params.size() <= g->inputs().size(), "More params provided than graph inputs");
+  torch::jit::WithInsertPoint guard(*g->nodes().begin());
+  auto first_param = g->inputs().size() - params.size();
+  for (size_t i = 0; i < params.size(); i++) {
+    auto c = g->insertConstant(params[i]);
+    g->inputs()[first_param + i]->replaceAllUsesWith(c);
+  }
+  for (size_t i = 0; i < params.size(); i++) {
+    g->eraseInput(first_param);
+  }
+}
+
 std::vector<at::Tensor> RunGraph(
     std::shared_ptr<torch::jit::Graph>& g,
     core::conversion::GraphParams& params,
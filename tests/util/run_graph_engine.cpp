@@ -72,6 +72,49 @@ std::vector<at::Tensor> RunGraphEngineDynamic(
   return RunEngine(eng, inputs);
 }
 
+int64_t weightsBytes(const nvinfer1::Weights& w) {
+  switch (w.type) {
+    case nvinfer1::DataType::kFLOAT:
+    case nvinfer1::DataType::kINT32:
+      return w.count * 4;
+    case nvinfer1::DataType::kHALF:
+      return w.count * 2;
+    default:
+      return w.count;
+  }
+}
+
+NetworkSummary SummarizeNetwork(
+    std::shared_ptr<torch::jit::Graph>& g,
+    core::conversion::GraphParams& named_params,
+    std::vector<at::Tensor> inputs,
+    core::conversion::BuilderSettings settings) {
+  LOG_DEBUG("Converting graph to a network definition");
+  auto in = toInputRanges(inputs);
+  auto info = core::conversion::ConversionInfo(in);
+  info.engine_settings = settings;
+  // Converted into a recording network so no builder (and no GPU) is needed
+  core::conversion::ConversionCtx ctx(info.engine_settings, CreateRecordingNetwork());
+  core::conversion::ConvertBlockToNetDef(&ctx, g->block(), info, named_params);
+
+  NetworkSummary summary;
+  summary.num_layers = ctx.net->getNbLayers();
+  for (int32_t i = 0; i < ctx.net->getNbLayers(); i++) {
+    auto layer = ctx.net->getLayer(i);
+    summary.layer_counts[layer->getType()]++;
+    if (layer->getType() == nvinfer1::LayerType::kCONSTANT) {
+      summary.constant_bytes += weightsBytes(static_cast<nvinfer1::IConstantLayer*>(layer)->getWeights());
+    }
+    c10::optional<nvinfer1::DataType> precision;
+    if (layer->precisionIsSet()) {
+      precision = layer->getPrecision();
+    }
+    summary.layer_precisions.push_back({layer->getType(), precision});
+  }
+  summary.unmatched_layer_precision_rules = ctx.UnmatchedLayerPrecisionRules();
+  return summary;
+}
+
 } // namespace util
 } // namespace tests
 } // namespace trtorch
@@ -24,6 +24,23 @@ bool exactlyEqual(const at::Tensor& a, const at::Tensor& b) {
   return (a - b).abs().max().item<float>() == 0.f;
 }
 
+size_t countNodesOfKind(const torch::jit::Block* b, torch::jit::NodeKind kind) {
+  size_t count = 0;
+  for (const auto n : b->nodes()) {
+    if (n->kind() == kind) {
+      count++;
+    }
+    for (const auto sub_b : n->blocks()) {
+      count += countNodesOfKind(sub_b, kind);
+    }
+  }
+  return count;
+}
+
+size_t CountNodesOfKind(const std::shared_ptr<torch::jit::Graph>& g, torch::jit::NodeKind kind) {
+  return countNodesOfKind(g->block(), kind);
+}
+
 } // namespace util
 } // namespace tests
 } // namespace trtorch
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ATen/Tensor.h"
 #include "core/conversion/conversion.h"
 #include "core/util/prelude.h"
+#include "tests/util/recording_network.h"
 
 namespace trtorch {
 namespace tests {
@@ -15,8 +18,15 @@ bool almostEqual(const at::Tensor& a, const at::Tensor& b, float threshold);
 
 bool exactlyEqual(const at::Tensor& a, const at::Tensor& b);
 
+// Counts the nodes of a kind in a graph, including those in nested blocks
+size_t CountNodesOfKind(const std::shared_ptr<torch::jit::Graph>& g, torch::jit::NodeKind kind);
+
 std::vector<at::Tensor> RunEngine(std::string& eng, std::vector<at::Tensor> inputs);
 
+// Replaces the trailing inputs of a graph with constants holding the provided
+// tensors, emulating the graph of a frozen module
+void FreezeGraphInputs(std::shared_ptr<torch::jit::Graph>& g, std::vector<at::Tensor> params);
+
 // Runs an arbitrary JIT graph and returns results
 std::vector<at::Tensor> RunGraph(
     std::shared_ptr<torch::jit::Graph>& g,
@@ -37,6 +47,28 @@ std::vector<at::Tensor> RunGraphEngineDynamic(
     core::conversion::GraphParams& named_params,
     std::vector<at::Tensor> inputs);
 
+// Layers of a converted TensorRT network definition, used to catch converters
+// emitting more (or different) layers than expected
+struct NetworkSummary {
+  int32_t num_layers = 0;
+  std::map<nvinfer1::LayerType, int32_t> layer_counts;
+  // Size of the weights held by constant layers
+  int64_t constant_bytes = 0;
+  // Type of each layer, in the order they were added, along with the precision
+  // it was pinned to (if any)
+  std::vector<std::pair<nvinfer1::LayerType, c10::optional<nvinfer1::DataType>>> layer_precisions;
+  // Layer precision rules which did not match any node
+  std::vector<std::string> unmatched_layer_precision_rules;
+};
+
+// Converts an arbitrary JIT graph to a network definition, without a builder
+// or a GPU, and summarizes the layers in it
+NetworkSummary SummarizeNetwork(
+    std::shared_ptr<torch::jit::Graph>& g,
+    core::conversion::GraphParams& named_params,
+    std::vector<at::Tensor> inputs,
+    core::conversion::BuilderSettings settings = core::conversion::BuilderSettings());
+
 // Run the forward method of a module and return results
 torch::jit::IValue RunModuleForward(torch::jit::Module& mod, std::vector<torch::jit::IValue> inputs);
 